@@ -33,7 +33,7 @@ static bool one_literal_on_conflict_level (kissat *solver, clause *conflict,
     const unsigned lit = *p;
     assert (VALUE (lit) < 0);
     const unsigned idx = IDX (lit);
-    const unsigned lit_level = all_assigned[idx].level;
+    const unsigned lit_level = ASSIGNED_LEVEL (all_assigned, idx);
     if (conflict_level == INVALID_LEVEL || conflict_level < lit_level) {
       literals_on_conflict_level = 1;
       jump_level = conflict_level;
@@ -75,11 +75,11 @@ static bool one_literal_on_conflict_level (kissat *solver, clause *conflict,
       const unsigned lit_idx = IDX (lit);
       unsigned highest_position = i;
       unsigned highest_literal = lit;
-      unsigned highest_level = all_assigned[lit_idx].level;
+      unsigned highest_level = ASSIGNED_LEVEL (all_assigned, lit_idx);
       for (unsigned j = i + 1; j < conflict_size; j++) {
         const unsigned other = lits[j];
         const unsigned other_idx = IDX (other);
-        const unsigned level = all_assigned[other_idx].level;
+        const unsigned level = ASSIGNED_LEVEL (all_assigned, other_idx);
         if (highest_level >= level)
           continue;
         highest_literal = other;
@@ -132,7 +132,7 @@ static inline void mark_reason_side_literal (kissat *solver,
                                              unsigned lit) {
   const unsigned idx = IDX (lit);
   const assigned *a = all_assigned + idx;
-  if (a->level && !a->analyzed)
+  if (ASSIGNED_LEVEL (all_assigned, idx) && !a->analyzed)
     kissat_push_analyzed (solver, all_assigned, idx);
 }
 
@@ -142,16 +142,17 @@ static inline void analyze_reason_side_literal (kissat *solver,
                                                 unsigned lit) {
   const unsigned idx = IDX (lit);
   const assigned *a = all_assigned + idx;
-  assert (a->level);
+  assert (ASSIGNED_LEVEL (all_assigned, idx));
   assert (a->analyzed);
-  assert (a->reason != UNIT_REASON);
-  if (a->reason == DECISION_REASON)
+  const unsigned reason = ASSIGNED_REASON (all_assigned, idx);
+  assert (reason != UNIT_REASON);
+  if (reason == DECISION_REASON)
     return;
   if (a->binary) {
-    const unsigned other = a->reason;
+    const unsigned other = reason;
     mark_reason_side_literal (solver, all_assigned, other);
   } else {
-    const reference ref = a->reason;
+    const reference ref = reason;
     assert (ref < SIZE_STACK (solver->arena));
     clause *c = (clause *) (arena + ref);
     const unsigned not_lit = NOT (lit);
@@ -270,8 +271,7 @@ static void sort_deduced_clause (kissat *solver) {
   for (const unsigned *p = begin_clause; p != end_clause; p++) {
     const unsigned lit = *p;
     const unsigned idx = IDX (lit);
-    const struct assigned *a = assigned + idx;
-    const unsigned level = a->level;
+    const unsigned level = ASSIGNED_LEVEL (assigned, idx);
     assert (level < size_frames);
     frame *f = frames + level;
     const unsigned pos = f->used++;
@@ -301,7 +301,7 @@ static void sort_deduced_clause (kissat *solver) {
   unsigned prev_level = solver->level;
   for (all_stack (unsigned, lit, solver->clause)) {
     const unsigned idx = IDX (lit);
-    const unsigned lit_level = assigned[idx].level;
+    const unsigned lit_level = ASSIGNED_LEVEL (assigned, idx);
     assert (prev_level >= lit_level);
     prev_level = lit_level;
   }
@@ -416,23 +416,23 @@ static void analyze_failed_literal (kissat *solver, clause *conflict) {
     }
     assert (values[lit] < 0);
     const unsigned idx = IDX (lit);
-    assigned *a = all_assigned + idx;
-    if (!a->level)
+    const unsigned level = ASSIGNED_LEVEL (all_assigned, idx);
+    if (!level)
       continue;
-    assert (a->level == 1);
+    assert (level == 1);
     LOG ("analyzing conflict literal %s", LOGLIT (lit));
     kissat_push_analyzed (solver, all_assigned, idx);
     unresolved++;
   }
 
   for (;;) {
-    unsigned lit;
+    unsigned lit, idx;
     assigned *a;
     do {
       assert (t > BEGIN_ARRAY (solver->trail));
       lit = *--t;
       assert (values[lit] > 0);
-      const unsigned idx = IDX (lit);
+      idx = IDX (lit);
       a = all_assigned + idx;
     } while (!a->analyzed);
     if (unresolved == 1) {
@@ -441,7 +441,7 @@ static void analyze_failed_literal (kissat *solver, clause *conflict) {
       PUSH_STACK (*units, unit);
     }
     if (a->binary) {
-      const unsigned other = a->reason;
+      const unsigned other = ASSIGNED_REASON (all_assigned, idx);
       LOGBINARY (lit, other, "resolving %s reason", LOGLIT (lit));
       assert (other != failed);
       assert (other != unit);
@@ -453,16 +453,16 @@ static void analyze_failed_literal (kissat *solver, clause *conflict) {
       }
       const unsigned idx = IDX (other);
       assigned *b = all_assigned + idx;
-      assert (b->level == 1);
+      assert (ASSIGNED_LEVEL (all_assigned, idx) == 1);
       if (!b->analyzed) {
         LOG ("analyzing reason literal %s", LOGLIT (other));
         kissat_push_analyzed (solver, all_assigned, idx);
         unresolved++;
       }
     } else {
-      assert (a->reason != UNIT_REASON);
-      assert (a->reason != DECISION_REASON);
-      const reference ref = a->reason;
+      const reference ref = ASSIGNED_REASON (all_assigned, idx);
+      assert (ref != UNIT_REASON);
+      assert (ref != DECISION_REASON);
       LOGREF (ref, "resolving %s reason", LOGLIT (lit));
       clause *reason = kissat_dereference_clause (solver, ref);
       for (all_literals_in_clause (other, reason)) {
@@ -480,9 +480,10 @@ static void analyze_failed_literal (kissat *solver, clause *conflict) {
         assert (values[other] < 0);
         const unsigned idx = IDX (other);
         assigned *b = all_assigned + idx;
-        if (!b->level)
+        const unsigned level = ASSIGNED_LEVEL (all_assigned, idx);
+        if (!level)
           continue;
-        assert (b->level == 1);
+        assert (level == 1);
         if (b->analyzed)
           continue;
         LOG ("analyzing reason literal %s", LOGLIT (other));
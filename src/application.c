@@ -1,4 +1,5 @@
 #include "application.h"
+#include "cache.h"
 #include "check.h"
 #include "colors.h"
 #include "config.h"
@@ -9,7 +10,9 @@
 #include "parse.h"
 #include "print.h"
 #include "proof.h"
+#include "reconstruct.h"
 #include "resources.h"
+#include "snapshot.h"
 #include "witness.h"
 
 #include <inttypes.h>
@@ -24,6 +27,15 @@ struct application {
   kissat *solver;
   const char *input_path;
   const char *output_path;
+  const char *model_path;
+  const char *cache_path;
+  const char *checkpoint_path;
+  const char *resume_path;
+  const char *simplified_path;
+  const char *reconstruction_path;
+  const char *convert_path;
+  cache cache;
+  ints reconstructed;
 #ifndef NPROOFS
   const char *proof_path;
   file proof_file;
@@ -38,6 +50,7 @@ struct application {
   strictness strict;
   bool partial;
   bool witness;
+  bool backbone;
   int max_var;
 };
 
@@ -61,6 +74,8 @@ static void print_common_dimacs_and_proof_usage (void) {
 static void print_complete_dimacs_and_proof_usage (void) {
   printf ("\n");
   printf ("Furthermore '<dimacs>' is the input file in DIMACS format.\n");
+  printf ("Combinational models in ASCII or binary AIGER format are\n");
+  printf ("accepted too, asserting the disjunction of their outputs.\n");
 #ifdef KISSAT_HAS_COMPRESSION
   printf (
       "The solver reads from '<stdin>' if '<dimacs>' is unspecified.\n");
@@ -183,13 +198,21 @@ static void print_complete_usage (void) {
   printf ("Further '<option>' can be one of the "
           "following less frequent options:\n");
   printf ("\n");
+#ifndef NOPTIONS
+  printf ("  --backbone           print backbone after assignment\n");
+#endif
   printf ("  --banner             print solver information\n");
   printf ("  --build              print build information\n");
+  printf ("  --cache=<file>       "
+          "read and periodically write phase and clause cache\n");
+  printf ("  --checkpoint=<file>  "
+          "write solver snapshots periodically\n");
   printf ("  --color              "
           "use colors (default if connected to terminal)\n");
   printf ("  --no-color           "
           "no colors (default if not connected to terminal)\n");
   printf ("  --compiler           print compiler information\n");
+  printf ("  --convert=<file>     write binary CNF file and exit\n");
   printf ("  --copyright          print copyright information\n");
 #if !defined(NOPTIONS) && defined(EMBEDDED)
   printf ("  --embedded           print embedded option list\n");
@@ -198,11 +221,17 @@ static void print_complete_usage (void) {
   printf ("  --force              same as '-f' (force writing proof)\n");
 #endif
   printf ("  --id                 print 'git' identifier (SHA-1 hash)\n");
+  printf ("  --model=<file>       write binary model to file\n");
 #ifndef NOPTIONS
   printf ("  --range              print option range list\n");
 #endif
+  printf ("  --reconstruction=<file> "
+          "read or write reconstruction stack\n");
   printf ("  --relaxed            relaxed parsing"
           " (ignore DIMACS header)\n");
+  printf ("  --resume=<file>      resume from solver snapshot\n");
+  printf ("  --simplified=<file>  "
+          "write preprocessed formula and stop\n");
   printf ("  --strict             stricter parsing"
           " (no empty header lines)\n");
   printf ("  --version            print version\n");
@@ -218,6 +247,10 @@ static void print_complete_usage (void) {
   printf (
       "unless '--partial' is specified, then only values are printed\n");
   printf ("for variables which are necessary to satisfy the formula.\n");
+#ifndef NOPTIONS
+  printf ("With '--backbone' the literals satisfied in all models are\n");
+  printf ("printed in additional 'b' lines after the assignment.\n");
+#endif
   printf ("\n");
 #ifndef NOPTIONS
   printf ("The following predefined 'configurations' (option settings) are "
@@ -487,8 +520,67 @@ static bool parse_options (application *application, int argc,
         decisions_option = arg;
       } else
         ERROR ("invalid argument in '%s' (try '-h')", arg);
+    } else if ((valstr = kissat_parse_option_name (arg, "cache"))) {
+      if (!*valstr)
+        ERROR ("argument to '--cache' missing (try '-h')");
+      if (application->cache_path)
+        ERROR ("multiple cache files '%s' and '%s'",
+               application->cache_path, valstr);
+      application->cache_path = valstr;
+    } else if ((valstr = kissat_parse_option_name (arg, "checkpoint"))) {
+      if (!*valstr)
+        ERROR ("argument to '--checkpoint' missing (try '-h')");
+      if (application->checkpoint_path)
+        ERROR ("multiple checkpoint files '%s' and '%s'",
+               application->checkpoint_path, valstr);
+      application->checkpoint_path = valstr;
+    } else if ((valstr = kissat_parse_option_name (arg, "resume"))) {
+      if (!*valstr)
+        ERROR ("argument to '--resume' missing (try '-h')");
+      if (application->resume_path)
+        ERROR ("multiple resume files '%s' and '%s'",
+               application->resume_path, valstr);
+      application->resume_path = valstr;
+    } else if ((valstr = kissat_parse_option_name (arg, "simplified"))) {
+      if (!*valstr)
+        ERROR ("argument to '--simplified' missing (try '-h')");
+      if (application->simplified_path)
+        ERROR ("multiple simplified files '%s' and '%s'",
+               application->simplified_path, valstr);
+      application->simplified_path = valstr;
+#ifndef NOPTIONS
+      kissat_set_option (solver, "fastel", 1);
+#endif
+    } else if ((valstr =
+                    kissat_parse_option_name (arg, "reconstruction"))) {
+      if (!*valstr)
+        ERROR ("argument to '--reconstruction' missing (try '-h')");
+      if (application->reconstruction_path)
+        ERROR ("multiple reconstruction files '%s' and '%s'",
+               application->reconstruction_path, valstr);
+      application->reconstruction_path = valstr;
+    } else if ((valstr = kissat_parse_option_name (arg, "convert"))) {
+      if (!*valstr)
+        ERROR ("argument to '--convert' missing (try '-h')");
+      if (application->convert_path)
+        ERROR ("multiple binary CNF files '%s' and '%s'",
+               application->convert_path, valstr);
+      application->convert_path = valstr;
+    } else if ((valstr = kissat_parse_option_name (arg, "model"))) {
+      if (!*valstr)
+        ERROR ("argument to '--model' missing (try '-h')");
+      if (application->model_path)
+        ERROR ("multiple model files '%s' and '%s'",
+               application->model_path, valstr);
+      application->model_path = valstr;
     } else if (!strcmp (arg, "--partial"))
       application->partial = true;
+#ifndef NOPTIONS
+    else if (!strcmp (arg, "--backbone")) {
+      kissat_set_option (solver, "incremental", 1);
+      application->backbone = true;
+    }
+#endif
 #ifndef NPROOFS
     else if (LONG_FALSE_OPTION (arg, "binary"))
       application->binary = -1;
@@ -605,6 +697,33 @@ static bool parse_options (application *application, int argc,
       application->input_path = arg;
     }
   }
+#ifndef NPROOFS
+  if (application->convert_path && application->proof_path)
+    ERROR ("can not combine '--convert' and proof file '%s'",
+           application->proof_path);
+  if (application->resume_path && application->proof_path)
+    ERROR ("can not combine '--resume' and proof file '%s'",
+           application->proof_path);
+#endif
+  if (application->resume_path && application->simplified_path)
+    ERROR ("can not combine '--resume' and '--simplified'");
+  if (application->convert_path && application->input_path &&
+      !strcmp (application->convert_path, application->input_path))
+    ERROR ("will not read and write '%s' at the same time",
+           application->input_path);
+  if (application->simplified_path) {
+    if (!application->reconstruction_path)
+      ERROR ("'--simplified' requires '--reconstruction' (try '-h')");
+    if (conflicts_option)
+      ERROR ("can not combine '--simplified' and '%s'", conflicts_option);
+    kissat_set_conflict_limit (solver, 0);
+    application->conflicts = 0;
+  } else if (application->reconstruction_path) {
+    if (application->backbone)
+      ERROR ("can not combine '--reconstruction' and '--backbone'");
+    if (application->model_path)
+      ERROR ("can not combine '--reconstruction' and '--model'");
+  }
 #ifndef KISSAT_HAS_COMPRESSION
   if (!application->force && application->input_path &&
       kissat_looks_like_a_compressed_file (application->input_path))
@@ -662,6 +781,40 @@ static bool parse_input (application *application) {
   return true;
 }
 
+// With '--convert' the input is translated to the binary CNF format (see
+// 'convert.h') without adding it to the solver.
+
+static bool convert_input (application *application) {
+  kissat *solver = application->solver;
+  const char *path = application->input_path;
+  file input, output;
+  if (!path)
+    kissat_read_already_open_file (&input, stdin, "<stdin>");
+  else if (!kissat_open_to_read_file (&input, path))
+    ERROR ("failed to open '%s' for reading", path);
+  path = application->convert_path;
+  if (!kissat_open_to_write_file (&output, path)) {
+    kissat_close_file (&input);
+    ERROR ("failed to open '%s' for writing", path);
+  }
+  kissat_section (solver, "converting");
+  kissat_message (solver, "converting '%s' to binary CNF '%s'",
+                  input.path, output.path);
+  uint64_t lineno;
+  const char *error =
+      kissat_convert_dimacs (solver, application->strict, &input, &output,
+                             &lineno, &application->max_var);
+  kissat_close_file (&output);
+  kissat_close_file (&input);
+  if (error)
+    ERROR ("%s:%" PRIu64 ": parse error: %s", input.path, lineno, error);
+#ifndef QUIET
+  kissat_message (solver, "read %s and wrote %s",
+                  FORMAT_BYTES (input.bytes), FORMAT_BYTES (output.bytes));
+#endif
+  return true;
+}
+
 #ifndef NPROOFS
 
 static bool write_proof (application *application) {
@@ -767,6 +920,176 @@ static void print_limits (application *application) {
 
 #endif
 
+static bool write_binary_model (application *application) {
+  const char *path = application->model_path;
+  FILE *file = fopen (path, "wb");
+  if (!file)
+    ERROR ("could not write model file '%s'", path);
+  const bool written = kissat_write_binary_model (
+      application->solver, application->max_var, file);
+  if (fclose (file) || !written)
+    ERROR ("failed to write model file '%s'", path);
+  return true;
+}
+
+static bool read_cache (application *application) {
+  const char *path = application->cache_path;
+  kissat *solver = application->solver;
+  FILE *file = fopen (path, "r");
+  if (!file) {
+    kissat_message (solver, "no cache file '%s' to read", path);
+    return true;
+  }
+  kissat_message (solver, "reading cache file '%s'", path);
+  const char *error =
+      kissat_read_cache (solver, &application->cache, file);
+  fclose (file);
+  if (error) {
+    kissat_release_cache (solver, &application->cache);
+    ERROR ("%s: %s", path, error);
+  }
+  return true;
+}
+
+typedef bool (*file_writer) (application *, int res, FILE *);
+
+// Regular files are written to a temporary file first, which is then
+// renamed, such that an interrupted write never destroys the old file.
+
+static bool replace_file (application *application, const char *path,
+                          file_writer write, int res) {
+  if (kissat_file_exists (path) && !kissat_file_regular (path)) {
+    FILE *file = fopen (path, "wb");
+    if (!file)
+      return false;
+    const bool written = write (application, res, file);
+    return !fclose (file) && written;
+  }
+  const size_t len = strlen (path);
+  char *tmp = malloc (len + sizeof ".tmp");
+  if (!tmp)
+    return false;
+  memcpy (tmp, path, len);
+  memcpy (tmp + len, ".tmp", sizeof ".tmp");
+  bool renamed = false;
+  FILE *file = fopen (tmp, "wb");
+  if (file) {
+    const bool written = write (application, res, file);
+    renamed = !fclose (file) && written && !rename (tmp, path);
+    if (!renamed)
+      remove (tmp);
+  }
+  free (tmp);
+  return renamed;
+}
+
+static bool write_cache_to_file (application *application, int res,
+                                 FILE *file) {
+  return kissat_write_cache (application->solver, application->max_var,
+                             res, file);
+}
+
+static bool write_cache_file (application *application, int res) {
+  return replace_file (application, application->cache_path,
+                       write_cache_to_file, res);
+}
+
+static bool write_cache (application *application, int res) {
+  const char *path = application->cache_path;
+  kissat_message (application->solver, "writing cache file '%s'", path);
+  if (!write_cache_file (application, res))
+    ERROR ("failed to write cache file '%s'", path);
+  return true;
+}
+
+// Flushing the cache periodically keeps the progress of interrupted runs.
+
+static void flush_cache (void *state) {
+  application *application = state;
+  if (!write_cache_file (application, 0))
+    kissat_warning (application->solver,
+                    "failed to flush cache file '%s'",
+                    application->cache_path);
+}
+
+static bool resume (application *application) {
+  const char *path = application->resume_path;
+  kissat *solver = application->solver;
+  FILE *file = fopen (path, "rb");
+  if (!file)
+    ERROR ("could not read snapshot file '%s'", path);
+  kissat_message (solver, "reading snapshot file '%s'", path);
+  const char *error = kissat_read_snapshot (solver, file);
+  fclose (file);
+  if (error)
+    ERROR ("%s: %s", path, error);
+  return true;
+}
+
+static bool write_snapshot_to_file (application *application, int res,
+                                    FILE *file) {
+  assert (!res);
+  (void) res;
+  return kissat_write_snapshot (application->solver, file);
+}
+
+// Checkpoints are written in the same way as cache files, thus a snapshot
+// file is always complete even if the solver is killed while writing.
+
+static void write_checkpoint (void *state) {
+  application *application = state;
+  const char *path = application->checkpoint_path;
+  kissat_very_verbose (application->solver,
+                       "writing snapshot file '%s'", path);
+  if (!replace_file (application, path, write_snapshot_to_file, 0))
+    kissat_warning (application->solver,
+                    "failed to write snapshot file '%s'", path);
+}
+
+// Preprocessing stops at the zero conflict limit set for '--simplified'.
+
+static bool write_simplified (application *application) {
+  kissat *solver = application->solver;
+  const char *path = application->simplified_path;
+  kissat_message (solver, "writing simplified formula to '%s'", path);
+  FILE *file = fopen (path, "w");
+  if (!file)
+    ERROR ("could not write simplified file '%s'", path);
+  bool written = kissat_write_simplified (solver, file);
+  if (fclose (file) || !written)
+    ERROR ("failed to write simplified file '%s'", path);
+  path = application->reconstruction_path;
+  kissat_message (solver, "writing reconstruction file '%s'", path);
+  file = fopen (path, "w");
+  if (!file)
+    ERROR ("could not write reconstruction file '%s'", path);
+  written = kissat_write_reconstruction (solver, application->max_var,
+                                         file);
+  if (fclose (file) || !written)
+    ERROR ("failed to write reconstruction file '%s'", path);
+  return true;
+}
+
+// Without '--simplified' the input is assumed to be a simplified formula
+// and its model is extended to the original formula.
+
+static bool reconstruct_model (application *application) {
+  kissat *solver = application->solver;
+  const char *path = application->reconstruction_path;
+  kissat_message (solver, "reading reconstruction file '%s'", path);
+  FILE *file = fopen (path, "r");
+  if (!file)
+    ERROR ("could not read reconstruction file '%s'", path);
+  int max_var;
+  const char *error = kissat_reconstruct (solver, file, &max_var,
+                                          &application->reconstructed);
+  fclose (file);
+  if (error)
+    ERROR ("%s: %s", path, error);
+  kissat_message (solver, "reconstructed model of %d variables", max_var);
+  return true;
+}
+
 static int run_application (kissat *solver, int argc, char **argv,
                             bool *cancel_alarm_ptr) {
   *cancel_alarm_ptr = false;
@@ -787,6 +1110,8 @@ static int run_application (kissat *solver, int argc, char **argv,
     fflush (stdout);
   }
 #endif
+  if (application.convert_path)
+    return convert_input (&application) ? 0 : 1;
 #ifndef NPROOFS
   if (!write_proof (&application))
     return 1;
@@ -797,6 +1122,23 @@ static int run_application (kissat *solver, int argc, char **argv,
 #endif
     return 1;
   }
+  if (application.cache_path && !read_cache (&application)) {
+#ifndef NPROOFS
+    close_proof (&application);
+#endif
+    return 1;
+  }
+  if (application.resume_path && !resume (&application)) {
+    kissat_release_cache (solver, &application.cache);
+#ifndef NPROOFS
+    close_proof (&application);
+#endif
+    return 1;
+  }
+  if (application.cache_path)
+    kissat_set_cache_flush (solver, &application, flush_cache);
+  if (application.checkpoint_path)
+    kissat_set_checkpoint (solver, &application, write_checkpoint);
 #ifndef QUIET
 #ifndef NOPTIONS
   print_options (solver);
@@ -805,9 +1147,16 @@ static int run_application (kissat *solver, int argc, char **argv,
   kissat_section (solver, "solving");
 #endif
   int res = kissat_solve (solver);
+  kissat_release_cache (solver, &application.cache);
 #ifndef NPROOFS
   close_proof (&application);
 #endif
+  const bool reconstructing =
+      application.reconstruction_path && !application.simplified_path;
+  if (res == 10 && reconstructing && !reconstruct_model (&application)) {
+    RELEASE_STACK (application.reconstructed);
+    return 1;
+  }
   kissat_section (solver, "result");
   if (application.output_path && !strcmp (application.output_path, "-")) {
 #ifndef QUIET
@@ -834,9 +1183,18 @@ static int run_application (kissat *solver, int argc, char **argv,
 #endif
       printf ("s SATISFIABLE\n");
       fflush (stdout);
-      if (application.witness)
+      if (application.witness && reconstructing)
+        kissat_print_values (solver,
+                             SIZE_STACK (application.reconstructed) - 1,
+                             BEGIN_STACK (application.reconstructed),
+                             application.partial);
+      else if (application.witness)
         kissat_print_witness (solver, application.max_var,
                               application.partial);
+      if (application.backbone)
+        kissat_print_backbone (solver, application.max_var);
+      if (application.model_path && !write_binary_model (&application))
+        return 1;
     } else {
       printf ("s UNKNOWN\n");
       fflush (stdout);
@@ -860,6 +1218,11 @@ static int run_application (kissat *solver, int argc, char **argv,
     if (close_file)
       fclose (file);
   }
+  RELEASE_STACK (application.reconstructed);
+  if (application.simplified_path && !write_simplified (&application))
+    return 1;
+  if (application.cache_path && !write_cache (&application, res))
+    return 1;
 #ifndef QUIET
   kissat_print_statistics (solver);
 #endif
@@ -22,6 +22,45 @@ static void report_resized (kissat *solver, const char *mode,
 #endif
 }
 
+static void enlarge_arena (kissat *solver, size_t needed) {
+  const size_t res = SIZE_STACK (solver->arena);
+  size_t capacity = CAPACITY_STACK (solver->arena);
+  assert (kissat_is_power_of_two (MAX_ARENA));
+  assert (capacity <= MAX_ARENA);
+  size_t available = capacity - res;
+  if (needed <= available)
+    return;
+  const arena before = solver->arena;
+  do {
+    assert (kissat_is_zero_or_power_of_two (capacity));
+    if (capacity == MAX_ARENA)
+      kissat_fatal ("maximum arena capacity "
+                    "of 2^%u %zu-byte-words %s exhausted"
+#if defined(COMPACT)
+                    " (consider a configuration without '--compact')"
+#elif !defined(HUGE_ARENA)
+                    " (consider a configuration with '--huge')"
+#endif
+                    ,
+                    LD_MAX_ARENA, sizeof (ward),
+                    FORMAT_BYTES (MAX_ARENA * sizeof (ward)));
+    capacity = capacity ? 2 * capacity : sizeof (ward);
+    available = capacity - res;
+  } while (needed > available);
+  // Enlarge to the final capacity in one step, since for a large reserved
+  // batch of clauses doubling repeatedly would copy the arena each time.
+  const size_t bytes = capacity * sizeof (ward);
+  solver->arena.begin = kissat_realloc (
+      solver, solver->arena.begin,
+      CAPACITY_STACK (before) * sizeof (ward), bytes);
+  solver->arena.end = solver->arena.begin + res;
+  solver->arena.allocated = solver->arena.begin + capacity;
+  INC (arena_resized);
+  INC (arena_enlarged);
+  report_resized (solver, "enlarged", before);
+  assert (capacity <= MAX_ARENA);
+}
+
 reference kissat_allocate_clause (kissat *solver, size_t size) {
   assert (size <= UINT_MAX);
   const size_t res = SIZE_STACK (solver->arena);
@@ -30,38 +69,22 @@ reference kissat_allocate_clause (kissat *solver, size_t size) {
   assert (kissat_aligned_word (bytes));
   const size_t needed = bytes / sizeof (ward);
   assert (needed <= UINT_MAX);
-  size_t capacity = CAPACITY_STACK (solver->arena);
-  assert (kissat_is_power_of_two (MAX_ARENA));
-  assert (capacity <= MAX_ARENA);
-  size_t available = capacity - res;
-  if (needed > available) {
-    const arena before = solver->arena;
-    do {
-      assert (kissat_is_zero_or_power_of_two (capacity));
-      if (capacity == MAX_ARENA)
-        kissat_fatal ("maximum arena capacity "
-                      "of 2^%u %zu-byte-words %s exhausted"
-#ifdef COMPACT
-                      " (consider a configuration without '--compact')"
-#endif
-                      ,
-                      LD_MAX_ARENA, sizeof (ward),
-                      FORMAT_BYTES (MAX_ARENA * sizeof (ward)));
-      ENLARGE_STACK (solver->arena);
-      capacity = CAPACITY_STACK (solver->arena);
-      available = capacity - res;
-    } while (needed > available);
-    INC (arena_resized);
-    INC (arena_enlarged);
-    report_resized (solver, "enlarged", before);
-    assert (capacity <= MAX_ARENA);
-  }
+  enlarge_arena (solver, needed);
   solver->arena.end += needed;
   LOG ("allocated clause[%zu] of size %zu bytes %s", res, size,
        FORMAT_BYTES (bytes));
   return (reference) res;
 }
 
+void kissat_reserve_arena (kissat *solver, size_t wards) {
+  const size_t size = SIZE_STACK (solver->arena);
+  assert (size <= MAX_ARENA);
+  const size_t available = MAX_ARENA - size;
+  if (wards > available)
+    wards = available;
+  enlarge_arena (solver, wards);
+}
+
 void kissat_shrink_arena (kissat *solver) {
   const arena before = solver->arena;
   const size_t capacity = CAPACITY_STACK (before);
@@ -5,8 +5,19 @@
 #include "stack.h"
 #include "utilities.h"
 
-#ifdef COMPACT
+// Clauses are referenced by their offset in the arena, measured in
+// 'ward' units.  References have 31 bits (see 'reference.h') and thus the
+// size of a 'ward' determines the maximum arena size.  By default clauses
+// are aligned to double words, with '--compact' to single words, while for
+// '--huge' we use quadruple words which doubles the number of bytes which
+// can be referenced (to 64 GB on 64-bit machines).  For clauses of size at
+// most five this does not need more memory than the default, but longer
+// clauses have up to 16 more bytes of padding.
+
+#if defined(COMPACT)
 typedef word ward;
+#elif defined(HUGE_ARENA)
+typedef w4rd ward;
 #else
 typedef w2rd ward;
 #endif
@@ -29,6 +40,11 @@ struct kissat;
 reference kissat_allocate_clause (struct kissat *, size_t size);
 void kissat_shrink_arena (struct kissat *);
 
+// Make sure that at least 'wards' more words can be allocated in the arena
+// without resizing it (used when adding many clauses at once).
+
+void kissat_reserve_arena (struct kissat *, size_t wards);
+
 #if !defined(NDEBUG) || defined(LOGGING)
 
 bool kissat_clause_in_arena (const struct kissat *, const struct clause *);
@@ -36,8 +52,10 @@ bool kissat_clause_in_arena (const struct kissat *, const struct clause *);
 #endif
 
 static inline word kissat_align_ward (word w) {
-#ifdef COMPACT
+#if defined(COMPACT)
   return kissat_align_word (w);
+#elif defined(HUGE_ARENA)
+  return kissat_align_w4rd (w);
 #else
   return kissat_align_w2rd (w);
 #endif
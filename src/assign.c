@@ -2,6 +2,7 @@
 #include "inline.h"
 #include "inlineassign.h"
 #include "logging.h"
+#include "share.h"
 
 #include <limits.h>
 
@@ -17,6 +18,8 @@ void kissat_learned_unit (kissat *solver, unsigned lit) {
   kissat_assign_unit (solver, lit, "learned reason");
   CHECK_AND_ADD_UNIT (lit);
   ADD_UNIT_TO_PROOF (lit);
+  if (solver->sharing.export)
+    kissat_export_learned_unit (solver, lit);
 }
 
 void kissat_original_unit (kissat *solver, unsigned lit) {
@@ -34,13 +37,13 @@ void kissat_assign_binary (kissat *solver, unsigned lit, unsigned other) {
   assigned *assigned = solver->assigned;
   const unsigned other_idx = IDX (other);
   struct assigned *a = assigned + other_idx;
-  unsigned level = a->level;
+  unsigned level = ASSIGNED_LEVEL (assigned, other_idx);
   if (GET_OPTION (jumpreasons) && level && a->binary) {
     LOGBINARY (lit, other, "jumping %s reason", LOGLIT (lit));
     INC (jumped_reasons);
-    other = a->reason;
+    other = ASSIGNED_REASON (assigned, other_idx);
   }
-  kissat_assign (solver, solver->probing, a->level, true, lit, other);
+  kissat_assign (solver, solver->probing, level, true, lit, other);
   LOGBINARY (lit, other, "assign %s reason", LOGLIT (lit));
 }
 
@@ -12,6 +12,30 @@
 typedef struct assigned assigned;
 struct clause;
 
+#ifdef SPLIT_ASSIGNED
+
+// With '--split-assigned' only the flags needed during conflict analysis
+// are kept in 'struct assigned' (a single byte per variable), while the
+// levels, reasons and trail positions are stored in the separate dense
+// arrays 'assigned_levels', 'assigned_reasons' and 'assigned_positions'.
+
+struct assigned {
+  bool analyzed : 1;
+  bool binary : 1;
+  bool poisoned : 1;
+  bool removable : 1;
+  bool shrinkable : 1;
+};
+
+#define ASSIGNED_FIELD(A, IDX, ARRAY) \
+  (*((void) (A), solver->assigned_##ARRAY + (IDX)))
+
+#define ASSIGNED_LEVEL(A, IDX) ASSIGNED_FIELD (A, IDX, levels)
+#define ASSIGNED_TRAIL(A, IDX) ASSIGNED_FIELD (A, IDX, positions)
+#define ASSIGNED_REASON(A, IDX) ASSIGNED_FIELD (A, IDX, reasons)
+
+#else
+
 struct assigned {
   unsigned level;
   unsigned trail;
@@ -25,12 +49,23 @@ struct assigned {
   unsigned reason;
 };
 
+#define ASSIGNED_LEVEL(A, IDX) ((A)[IDX].level)
+#define ASSIGNED_TRAIL(A, IDX) ((A)[IDX].trail)
+#define ASSIGNED_REASON(A, IDX) ((A)[IDX].reason)
+
+#endif
+
+// Levels, trail positions and reasons of variables are only accessed
+// through these macros, where 'A' is the (cached) 'solver->assigned'.
+
 #define ASSIGNED(LIT) \
   (assert (VALID_INTERNAL_LITERAL (LIT)), solver->assigned + IDX (LIT))
 
-#define LEVEL(LIT) (ASSIGNED (LIT)->level)
-#define TRAIL(LIT) (ASSIGNED (LIT)->trail)
-#define REASON(LIT) (ASSIGNED (LIT)->reason)
+#define LEVEL(LIT) ASSIGNED_LEVEL (solver->assigned, ASSIGNED_IDX (LIT))
+#define TRAIL(LIT) ASSIGNED_TRAIL (solver->assigned, ASSIGNED_IDX (LIT))
+#define REASON(LIT) ASSIGNED_REASON (solver->assigned, ASSIGNED_IDX (LIT))
+
+#define ASSIGNED_IDX(LIT) (assert (VALID_INTERNAL_LITERAL (LIT)), IDX (LIT))
 
 #ifndef FAST_ASSIGN
 
@@ -3,6 +3,7 @@
 #include "analyze.h"
 #include "backtrack.h"
 #include "decide.h"
+#include "implications.h"
 #include "inline.h"
 #include "internal.h"
 #include "logging.h"
@@ -143,14 +144,12 @@ static inline void backbone_assign (kissat *solver, unsigned_array *trail,
   values[not_lit] = -1;
   PUSH_ARRAY (*trail, lit);
   const unsigned idx = IDX (lit);
-  struct assigned *a = assigned + idx;
-  a->reason = reason;
-  a->level = solver->level;
+  ASSIGNED_REASON (assigned, idx) = reason;
+  ASSIGNED_LEVEL (assigned, idx) = solver->level;
 }
 
 static inline clause *
-backbone_propagate_literal (kissat *solver, const bool stop_early,
-                            const watches *const all_watches,
+backbone_propagate_literal (kissat *solver, const implications *const graph,
                             unsigned_array *trail, value *values,
                             assigned *assigned, unsigned lit) {
   LOG ("backbone propagating %s", LOGLIT (lit));
@@ -161,63 +160,43 @@ backbone_propagate_literal (kissat *solver, const bool stop_early,
   assert (values[not_lit] < 0);
 
   assert (not_lit < LITS);
-  const watches *const watches = all_watches + not_lit;
-
-  const watch *const begin_watches = BEGIN_CONST_WATCHES (*watches);
-  const watch *const end_watches = END_CONST_WATCHES (*watches);
-  const watch *p = begin_watches;
-
-  while (p != end_watches) {
-    const watch watch = *p++;
-    if (watch.type.binary) {
-      const unsigned other = watch.binary.lit;
-      assert (VALID_INTERNAL_LITERAL (other));
-      const value value = values[other];
-      if (value > 0)
-        continue;
-      if (value < 0)
-        return kissat_binary_conflict (solver, not_lit, other);
-      assert (!value);
-      backbone_assign (solver, trail, values, assigned, other, lit);
-      LOG ("backbone assign %s reason binary clause %s %s", LOGLIT (other),
-           LOGLIT (other), LOGLIT (not_lit));
-    } else {
-      if (stop_early) {
-#ifndef NDEBUG
-        for (const union watch *q = p + 1; q != end_watches; q++) {
-          const union watch watch = *q++;
-          assert (!watch.type.binary);
-        }
-#endif
-        break;
-      }
-
-      p++;
-    }
+  const unsigned *const begin = BEGIN_IMPLICATIONS (graph, not_lit);
+  const unsigned *const end = END_IMPLICATIONS (graph, not_lit);
+  const unsigned *p = begin;
+
+  while (p != end) {
+    const unsigned other = *p++;
+    assert (VALID_INTERNAL_LITERAL (other));
+    const value value = values[other];
+    if (value > 0)
+      continue;
+    if (value < 0)
+      return kissat_binary_conflict (solver, not_lit, other);
+    assert (!value);
+    backbone_assign (solver, trail, values, assigned, other, lit);
+    LOG ("backbone assign %s reason binary clause %s %s", LOGLIT (other),
+         LOGLIT (other), LOGLIT (not_lit));
   }
 
-  const size_t touched = p - begin_watches;
-  solver->ticks += 1 + kissat_cache_lines (touched, sizeof (watch));
+  const size_t touched = p - begin;
+  solver->ticks += 1 + kissat_cache_lines (touched, sizeof (unsigned));
 
   return 0;
 }
 
 static inline clause *backbone_propagate (kissat *solver,
+                                          const implications *const graph,
                                           unsigned_array *trail,
                                           value *values,
                                           assigned *assigned) {
-  const bool stop_early =
-      solver->large_clauses_watched_after_binary_clauses;
-
   clause *conflict = 0;
   solver->ticks = 0;
 
-  const watches *const watches = solver->watches;
   unsigned *propagate = solver->propagate;
 
   while (!conflict && propagate != END_ARRAY (*trail))
-    conflict = backbone_propagate_literal (
-        solver, stop_early, watches, trail, values, assigned, *propagate++);
+    conflict = backbone_propagate_literal (solver, graph, trail, values,
+                                           assigned, *propagate++);
 
   assert (solver->propagate <= propagate);
   const unsigned propagated = propagate - solver->propagate;
@@ -281,7 +260,7 @@ static unsigned backbone_analyze (kissat *solver, clause *conflict) {
       continue;
 
     LOG ("backbone analyzing %s", LOGLIT (lit));
-    const unsigned reason = a->reason;
+    const unsigned reason = ASSIGNED_REASON (assigned, lit_idx);
     assert (reason != UNIT_REASON);
     assert (reason != DECISION_REASON);
     const unsigned reason_idx = IDX (reason);
@@ -298,27 +277,7 @@ static unsigned backbone_analyze (kissat *solver, clause *conflict) {
   }
 }
 
-#ifndef NDEBUG
-
-static void
-check_large_clauses_watched_after_binary_clauses (kissat *solver) {
-  for (all_literals (lit)) {
-    bool large = false;
-    for (all_binary_blocking_watches (watch, WATCHES (lit)))
-      if (watch.type.binary)
-        assert (!large);
-      else
-        large = true;
-  }
-}
-
-#endif
-
 static unsigned compute_backbone (kissat *solver) {
-#ifndef NDEBUG
-  if (solver->large_clauses_watched_after_binary_clauses)
-    check_large_clauses_watched_after_binary_clauses (solver);
-#endif
   size_t failed = 0;
   unsigneds units;
   unsigneds candidates;
@@ -341,6 +300,9 @@ static unsigned compute_backbone (kissat *solver) {
 
   unsigned inconsistent = INVALID_LIT;
 
+  implications graph;
+  kissat_build_implications (solver, &graph);
+
   SET_EFFORT_LIMIT (ticks_limit, backbone, backbone_ticks);
   size_t round_limit = GET_OPTION (backbonerounds);
   assert (solver->statistics.backbone_computations);
@@ -399,8 +361,7 @@ static unsigned compute_backbone (kissat *solver) {
         }
         if (value < 0) {
           const unsigned idx = IDX (probe);
-          struct assigned *a = assigned + idx;
-          if (a->level)
+          if (ASSIGNED_LEVEL (assigned, idx))
             LOG ("skipping falsified backbone probe %s", LOGLIT (probe));
           else {
             LOG ("removing root-level falsified backbone probe %s",
@@ -425,7 +386,7 @@ static unsigned compute_backbone (kissat *solver) {
                          DECISION_REASON);
         LOG ("backbone assume %s", LOGLIT (probe));
         clause *conflict =
-            backbone_propagate (solver, trail, values, assigned);
+            backbone_propagate (solver, &graph, trail, values, assigned);
         if (!conflict) {
           LOG ("propagating backbone probe %s successful", LOGLIT (probe));
           continue;
@@ -446,7 +407,8 @@ static unsigned compute_backbone (kissat *solver) {
         LOG ("backbone forced assign %s", LOGLIT (not_uip));
         assert (failed == SIZE_STACK (units));
 
-        conflict = backbone_propagate (solver, trail, values, assigned);
+        conflict =
+            backbone_propagate (solver, &graph, trail, values, assigned);
         if (conflict) {
           LOG ("propagating backbone forced %s failed", LOGLIT (not_uip));
           inconsistent = not_uip;
@@ -548,6 +510,7 @@ static unsigned compute_backbone (kissat *solver) {
     assert (solver->inconsistent);
   }
   RELEASE_STACK (units);
+  kissat_release_implications (solver, &graph);
   if (solver->inconsistent)
     kissat_phase (solver, "backbone", GET (backbone_computations),
                   "inconsistent binary clauses");
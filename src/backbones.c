@@ -0,0 +1,253 @@
+#include "allocate.h"
+#include "error.h"
+#include "extend.h"
+#include "inline.h"
+#include "kitten.h"
+#include "print.h"
+#include "require.h"
+#include "terminate.h"
+
+#include <string.h>
+
+// Computes the full backbone of the external formula after a satisfiable
+// 'solve' call, i.e., the literals of original external variables which
+// are satisfied in all models.  In contrast, the binary clause backbone
+// in 'backbone.c' is an inprocessing technique and only finds backbone
+// literals implied by binary clauses.  The result is stored as one
+// external literal (or zero) for each external variable.
+
+// The embedded sub-solver 'kitten' (also used in sweeping) is given the
+// remaining irredundant clauses, root-level units and the clauses on the
+// reconstruction stack, all mapped to external literals.  This formula
+// has exactly the models of the original formula on original variables
+// (extension variables introduced by factoring are existentially
+// quantified), independently of the simplifications applied so far.
+// This however requires the 'incremental' option, since otherwise variable
+// elimination and substitution only save the clauses of one side on the
+// reconstruction stack and a witness unit for the other side, which is
+// enough for extending a model but not as clauses.
+
+static unsigned kitten_literal (int elit) {
+  assert (elit);
+  assert (elit != INT_MIN);
+  const unsigned res = 2u * ABS (elit);
+  return elit < 0 ? res + 1 : res;
+}
+
+static void add_kitten_clause (kitten *kitten, unsigneds *lits) {
+  kitten_clause (kitten, SIZE_STACK (*lits), BEGIN_STACK (*lits));
+  CLEAR_STACK (*lits);
+}
+
+static unsigned exported_kitten_literal (kissat *solver, unsigned ilit) {
+  return kitten_literal (kissat_export_literal (solver, ilit));
+}
+
+static void add_internal_clauses (kissat *solver, kitten *kitten,
+                                  unsigneds *lits) {
+  for (all_variables (idx)) {
+    const unsigned lit = LIT (idx);
+    const value value = kissat_fixed (solver, lit);
+    if (!value)
+      continue;
+    const unsigned unit = value < 0 ? NOT (lit) : lit;
+    kitten_unit (kitten, exported_kitten_literal (solver, unit));
+  }
+  for (all_literals (lit)) {
+    watches *watches = &WATCHES (lit);
+    for (all_binary_blocking_watches (watch, *watches)) {
+      if (!watch.type.binary)
+        continue;
+      const unsigned other = watch.binary.lit;
+      if (lit > other)
+        continue;
+      PUSH_STACK (*lits, exported_kitten_literal (solver, lit));
+      PUSH_STACK (*lits, exported_kitten_literal (solver, other));
+      add_kitten_clause (kitten, lits);
+    }
+  }
+  for (all_clauses (c)) {
+    if (c->garbage || c->redundant)
+      continue;
+    for (all_literals_in_clause (lit, c))
+      PUSH_STACK (*lits, exported_kitten_literal (solver, lit));
+    add_kitten_clause (kitten, lits);
+  }
+}
+
+static void add_extension_clauses (kissat *solver, kitten *kitten,
+                                   unsigneds *lits) {
+  const extension *const begin = BEGIN_STACK (solver->extend);
+  const extension *p = END_STACK (solver->extend);
+  const uint8_t *compressed = END_STACK (solver->compressed);
+  unsigneds *decompressed = &solver->decompressed;
+  while (p != begin) {
+    extension ext;
+    do {
+      assert (begin < p);
+      ext = *--p;
+      if (ext.lit)
+        PUSH_STACK (*lits, kitten_literal (ext.lit));
+      else {
+        assert (EMPTY_STACK (*decompressed));
+        compressed = kissat_decompress_extension (solver, compressed,
+                                                  decompressed);
+        for (all_stack (unsigned, ulit, *decompressed))
+          PUSH_STACK (*lits, ulit);
+        CLEAR_STACK (*decompressed);
+      }
+    } while (!ext.blocking);
+    add_kitten_clause (kitten, lits);
+  }
+  assert (compressed == BEGIN_STACK (solver->compressed));
+}
+
+// Candidates are the literals satisfied by the model of 'solve'.  They
+// are refined by later models, either found by 'kitten' or obtained by
+// flipping literals, and the remaining ones are tested in chunks, i.e., by
+// checking whether some model falsifies one of the literals of a chunk.
+// This needs the activation literal 'act' of the clause disjunction of
+// the negated chunk literals, which is disabled afterwards by adding it
+// as unit clause.  If the chunk is unsatisfiable all its literals belong
+// to the backbone and are added as units to strengthen later checks.
+
+static void refine_candidates (kitten *kitten, unsigneds *candidates) {
+  unsigned *const begin = BEGIN_STACK (*candidates), *q = begin;
+  const unsigned *const end = END_STACK (*candidates), *p = q;
+  while (p != end) {
+    const unsigned lit = *p++;
+    if (kitten_value (kitten, lit) > 0)
+      *q++ = lit;
+  }
+  SET_END_OF_STACK (*candidates, q);
+}
+
+static void flip_candidates (kissat *solver, kitten *kitten,
+                             unsigneds *candidates) {
+  unsigned *const begin = BEGIN_STACK (*candidates), *q = begin;
+  const unsigned *const end = END_STACK (*candidates), *p = q;
+  while (p != end) {
+    const unsigned lit = *p++;
+    if (kitten_flip_literal (kitten, lit))
+      INC (backbone_flipped);
+    else
+      *q++ = lit;
+  }
+  SET_END_OF_STACK (*candidates, q);
+}
+
+static void add_backbone_literal (kissat *solver, unsigned lit) {
+  const unsigned eidx = lit / 2;
+  const int elit = (lit & 1) ? -(int) eidx : (int) eidx;
+  assert (!PEEK_STACK (solver->backbones, eidx));
+  POKE_STACK (solver->backbones, eidx, elit);
+  INC (backbone_literals);
+}
+
+static void compute_backbones (kissat *solver) {
+  const size_t size_import = SIZE_STACK (solver->import);
+  assert (EMPTY_STACK (solver->backbones));
+  for (size_t eidx = 0; eidx < MAX (size_import, 1); eidx++)
+    PUSH_STACK (solver->backbones, 0);
+  unsigneds candidates;
+  INIT_STACK (candidates);
+  for (unsigned eidx = 1; eidx < size_import; eidx++) {
+    const import *const import = &PEEK_STACK (solver->import, eidx);
+    if (!import->imported || import->extension)
+      continue;
+    const int elit = kissat_value (solver, eidx);
+    if (elit)
+      PUSH_STACK (candidates, kitten_literal (elit));
+  }
+  ADD (backbone_candidates, SIZE_STACK (candidates));
+  kitten *kitten = kitten_embedded (solver);
+  kitten_no_ticks_limit (kitten);
+  unsigneds lits;
+  INIT_STACK (lits);
+  add_internal_clauses (solver, kitten, &lits);
+  add_extension_clauses (solver, kitten, &lits);
+  unsigned act = 2u * size_import;
+  kissat_extremely_verbose (solver, "computing backbone of %zu candidates",
+                            SIZE_STACK (candidates));
+  const unsigned max_chunk = GET_OPTION (backbonechunk);
+  unsigned chunk = 1;
+  INC (backbone_solved);
+  int res = kitten_solve (kitten);
+  if (res == 10) {
+    refine_candidates (kitten, &candidates);
+    flip_candidates (solver, kitten, &candidates);
+  }
+  while (res) {
+    unsigned *const begin = BEGIN_STACK (candidates), *q = begin;
+    const unsigned *const end = END_STACK (candidates), *p = q;
+    while (p != end) {
+      const unsigned lit = *p++;
+      if (kitten_fixed (kitten, lit) > 0)
+        add_backbone_literal (solver, lit);
+      else
+        *q++ = lit;
+    }
+    SET_END_OF_STACK (candidates, q);
+    if (EMPTY_STACK (candidates))
+      break;
+    if (TERMINATED (backbones_terminated_1)) {
+      res = 0;
+      break;
+    }
+    const size_t size = MIN (SIZE_STACK (candidates), chunk);
+    const unsigned *const chunk_end = begin + size;
+    if (size == 1)
+      kitten_assume (kitten, *begin ^ 1);
+    else {
+      PUSH_STACK (lits, act);
+      for (const unsigned *l = begin; l != chunk_end; l++)
+        PUSH_STACK (lits, *l ^ 1);
+      add_kitten_clause (kitten, &lits);
+      kitten_assume (kitten, act ^ 1);
+    }
+    INC (backbone_solved);
+    res = kitten_solve (kitten);
+    if (res == 10) {
+      refine_candidates (kitten, &candidates);
+      flip_candidates (solver, kitten, &candidates);
+      if (chunk > 1)
+        chunk /= 2;
+    } else if (res == 20) {
+      for (const unsigned *l = begin; l != chunk_end; l++) {
+        add_backbone_literal (solver, *l);
+        kitten_unit (kitten, *l);
+      }
+      const size_t remain = SIZE_STACK (candidates) - size;
+      memmove (begin, chunk_end, remain * sizeof *begin);
+      SET_END_OF_STACK (candidates, begin + remain);
+      if (chunk < max_chunk)
+        chunk *= 2;
+    }
+    if (size > 1) {
+      kitten_unit (kitten, act);
+      act += 2;
+    }
+  }
+  kissat_extremely_verbose (
+      solver, "backbone computation %s with %zu unchecked candidates",
+      res ? "completed" : "incomplete", SIZE_STACK (candidates));
+  RELEASE_STACK (lits);
+  RELEASE_STACK (candidates);
+  kitten_release (kitten);
+}
+
+int kissat_backbone (kissat *solver, int elit) {
+  kissat_require_initialized (solver);
+  kissat_require_valid_external_internal (elit);
+  kissat_require (!solver->inconsistent && !solver->unassigned,
+                  "can only compute backbone after satisfiable 'solve'");
+  kissat_require (GET_OPTION (incremental),
+                  "backbone computation requires 'incremental' option");
+  if (EMPTY_STACK (solver->backbones))
+    compute_backbones (solver);
+  const unsigned eidx = ABS (elit);
+  if (eidx >= SIZE_STACK (solver->backbones))
+    return 0;
+  const int res = PEEK_STACK (solver->backbones, eidx);
+  return elit < 0 ? -res : res;
+}
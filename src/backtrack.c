@@ -78,6 +78,8 @@ void kissat_backtrack_without_updating_phases (kissat *solver,
   LOG ("backtracking to decision level %u", new_level);
 
   frame *new_frame = &FRAME (new_level + 1);
+  if (solver->propagator.connected)
+    kissat_notify_backtrack (solver, new_level, new_frame->trail);
   SET_END_OF_STACK (solver->frames, new_frame);
 
   value *values = solver->values;
@@ -95,12 +97,11 @@ void kissat_backtrack_without_updating_phases (kissat *solver,
       const unsigned lit = *p;
       const unsigned idx = IDX (lit);
       assert (idx < VARS);
-      struct assigned *a = assigned + idx;
-      const unsigned level = a->level;
+      const unsigned level = ASSIGNED_LEVEL (assigned, idx);
       if (level <= new_level) {
         const unsigned new_trail = q - trail;
-        assert (new_trail <= a->trail);
-        a->trail = new_trail;
+        assert (new_trail <= ASSIGNED_TRAIL (assigned, idx));
+        ASSIGNED_TRAIL (assigned, idx) = new_trail;
         *q++ = lit;
         LOG ("reassign %s", LOGLIT (lit));
         reassigned++;
@@ -116,12 +117,11 @@ void kissat_backtrack_without_updating_phases (kissat *solver,
       const unsigned lit = *p;
       const unsigned idx = IDX (lit);
       assert (idx < VARS);
-      struct assigned *a = assigned + idx;
-      const unsigned level = a->level;
+      const unsigned level = ASSIGNED_LEVEL (assigned, idx);
       if (level <= new_level) {
         const unsigned new_trail = q - trail;
-        assert (new_trail <= a->trail);
-        a->trail = new_trail;
+        assert (new_trail <= ASSIGNED_TRAIL (assigned, idx));
+        ASSIGNED_TRAIL (assigned, idx) = new_trail;
         *q++ = lit;
         LOG ("reassign %s", LOGLIT (lit));
         reassigned++;
@@ -0,0 +1,140 @@
+#ifndef NOPTIONS
+
+#include "bandit.h"
+#include "internal.h"
+#include "print.h"
+
+#include <inttypes.h>
+#include <math.h>
+
+// Online selection of option profiles at mode switches.  The profiles
+// only change options which are actually used in the mode they are
+// selected for and are treated as arms of a multi-armed bandit with
+// separate arms and statistics for focused and stable mode.  The reward
+// of a mode phase is the number of conflicts per million search ticks (a
+// deterministic substitute for conflicts per second) divided by one plus
+// the average glue of learned clauses.  Arms are then selected with the
+// upper confidence bound (UCB1) strategy on rewards normalized by the
+// maximum reward observed in that mode.
+
+typedef struct configuration configuration;
+
+struct configuration {
+  const char *name;
+  int restartint, reluctantint, target;
+};
+
+// A negative value means to keep the value set by the user.  In focused
+// mode only the restart interval matters and target phases are only used
+// for 'target=2' (the 'sat' configuration).  In stable mode the restart
+// interval is ignored and the target phases are used for 'target=1' and
+// 'target=2', but the interval of reluctant doubling restarts matters.
+
+static const configuration configurations[2][BANDIT_ARMS] = {
+    {
+        {"default", -1, -1, -1},
+        {"sat", RESTARTINT_SAT, -1, TARGET_SAT},
+        {"target", -1, -1, TARGET_SAT},
+    },
+    {
+        {"default", -1, -1, -1},
+        {"reluctant", -1, BANDIT_RELUCTANTINT, -1},
+        {"notarget", -1, -1, 0},
+    },
+};
+
+static int configured (int value, int user) {
+  return value < 0 ? user : value;
+}
+
+// Called before switching, thus the arm is selected for the other mode.
+
+static void apply_configuration (kissat *solver, unsigned arm) {
+  bandit *bandit = &solver->bandit;
+  const unsigned mode = !solver->stable;
+  const configuration *c = configurations[mode] + arm;
+  options *options = &solver->options;
+  options->restartint = configured (c->restartint, bandit->restartint);
+  options->reluctantint =
+      configured (c->reluctantint, bandit->reluctantint);
+  options->target = configured (c->target, bandit->target);
+  kissat_very_verbose (solver,
+                       "bandit selected '%s' profile for %s mode "
+                       "('--restartint=%d --reluctantint=%d "
+                       "--target=%d')",
+                       c->name, mode ? "stable" : "focused",
+                       options->restartint, options->reluctantint,
+                       options->target);
+}
+
+static void update_reward (kissat *solver) {
+  bandit *bandit = &solver->bandit;
+  const statistics *statistics = &solver->statistics;
+  const uint64_t conflicts = statistics->conflicts - bandit->conflicts;
+  const uint64_t ticks = statistics->search_ticks - bandit->ticks;
+  if (!ticks)
+    return;
+  const double rate = 1e6 * conflicts / (double) ticks;
+  const double reward = rate / (1 + AVERAGE (slow_glue));
+  const unsigned mode = solver->stable;
+  const unsigned selected = bandit->selected[mode];
+  bandit_arm *arm = &bandit->arms[mode][selected];
+  arm->pulls++;
+  arm->reward += (reward - arm->reward) / arm->pulls;
+  bandit->pulls[mode]++;
+  if (reward > bandit->max_reward[mode])
+    bandit->max_reward[mode] = reward;
+  kissat_extremely_verbose (solver,
+                            "bandit '%s' profile reward %.2f "
+                            "in %s mode (average %.2f over %" PRIu64
+                            " pulls)",
+                            configurations[mode][selected].name, reward,
+                            solver->stable ? "stable" : "focused",
+                            arm->reward, arm->pulls);
+}
+
+static unsigned select_arm (kissat *solver) {
+  bandit *bandit = &solver->bandit;
+  const unsigned mode = !solver->stable;
+  const bandit_arm *arms = bandit->arms[mode];
+  for (unsigned arm = 0; arm < BANDIT_ARMS; arm++)
+    if (!arms[arm].pulls)
+      return arm;
+  const double max_reward = bandit->max_reward[mode];
+  const double log_pulls = log (bandit->pulls[mode]);
+  unsigned res = 0;
+  double best = -1;
+  for (unsigned arm = 0; arm < BANDIT_ARMS; arm++) {
+    const bandit_arm *a = arms + arm;
+    const double exploit = max_reward > 0 ? a->reward / max_reward : 0;
+    const double explore = sqrt (2 * log_pulls / a->pulls);
+    const double score = exploit + explore;
+    if (score > best)
+      best = score, res = arm;
+  }
+  return res;
+}
+
+void kissat_bandit_switch (kissat *solver) {
+  assert (GET_OPTION (bandit));
+  bandit *bandit = &solver->bandit;
+  if (!bandit->initialized) {
+    bandit->restartint = GET_OPTION (restartint);
+    bandit->reluctantint = GET_OPTION (reluctantint);
+    bandit->target = GET_OPTION (target);
+    bandit->initialized = true;
+  }
+  update_reward (solver);
+  const unsigned arm = select_arm (solver);
+  const unsigned mode = !solver->stable;
+  if (arm != bandit->selected[mode])
+    INC (bandit_switched);
+  bandit->selected[mode] = arm;
+  apply_configuration (solver, arm);
+  bandit->conflicts = solver->statistics.conflicts;
+  bandit->ticks = solver->statistics.search_ticks;
+}
+
+#else
+int kissat_bandit_dummy_to_avoid_warning;
+#endif
@@ -0,0 +1,36 @@
+#ifndef _bandit_h_INCLUDED
+#define _bandit_h_INCLUDED
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define BANDIT_ARMS 3
+#define BANDIT_RELUCTANTINT (1 << 12)
+
+typedef struct bandit bandit;
+typedef struct bandit_arm bandit_arm;
+
+struct bandit_arm {
+  uint64_t pulls;
+  double reward;
+};
+
+struct bandit {
+  bool initialized;
+  unsigned selected[2];
+  int restartint, reluctantint, target;
+  uint64_t conflicts, ticks;
+  uint64_t pulls[2];
+  double max_reward[2];
+  bandit_arm arms[2][BANDIT_ARMS];
+};
+
+#ifndef NOPTIONS
+
+struct kissat;
+
+void kissat_bandit_switch (struct kissat *);
+
+#endif
+
+#endif
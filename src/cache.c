@@ -0,0 +1,206 @@
+#include "cache.h"
+#include "inline.h"
+#include "print.h"
+
+#include <ctype.h>
+#include <inttypes.h>
+#include <limits.h>
+
+static int cached_phase (kissat *solver, unsigned eidx, bool satisfied) {
+  const int elit = (int) eidx;
+  if (satisfied) {
+    const int tmp = kissat_extended_value (solver, eidx);
+    return tmp < 0 ? -elit : tmp > 0 ? elit : 0;
+  }
+  const import *const import = &PEEK_STACK (solver->import, eidx);
+  if (!import->imported || import->eliminated || import->extension)
+    return 0;
+  const unsigned ilit = import->lit;
+  const unsigned idx = IDX (ilit);
+  value phase = kissat_fixed (solver, LIT (idx));
+  if (!phase)
+    phase = BEST (idx);
+  if (!phase)
+    phase = TARGET (idx);
+  if (!phase)
+    phase = SAVED (idx);
+  if (NEGATED (ilit))
+    phase = -phase;
+  return phase < 0 ? -elit : phase > 0 ? elit : 0;
+}
+
+static void write_cached_phases (kissat *solver, int max_var, int status,
+                                 FILE *file) {
+  const bool satisfied = (status == 10);
+  if (satisfied)
+    kissat_extend_model (solver);
+  const size_t imported = SIZE_STACK (solver->import);
+  if ((size_t) max_var >= imported)
+    max_var = imported ? imported - 1 : 0;
+  for (int eidx = 1; eidx <= max_var; eidx++) {
+    const int elit = cached_phase (solver, eidx, satisfied);
+    if (elit)
+      fprintf (file, "%d ", elit);
+  }
+  fputs ("0\n", file);
+}
+
+static void write_cached_units (kissat *solver, FILE *file) {
+  if (solver->inconsistent) {
+    fputs ("0\n", file);
+    return;
+  }
+  const import *const imports = BEGIN_STACK (solver->import);
+  for (all_stack (int, elit, solver->units))
+    if (!imports[ABS (elit)].extension)
+      fprintf (file, "%d 0\n", elit);
+}
+
+static bool write_cached_clause (kissat *solver, clause *c, FILE *file) {
+  const import *const imports = BEGIN_STACK (solver->import);
+  for (all_literals_in_clause (ilit, c)) {
+    if (kissat_fixed (solver, ilit) > 0)
+      return false;
+    const int elit = kissat_export_literal (solver, ilit);
+    if (!elit || imports[ABS (elit)].extension)
+      return false;
+  }
+  for (all_literals_in_clause (ilit, c))
+    fprintf (file, "%d ", kissat_export_literal (solver, ilit));
+  fputs ("0\n", file);
+  return true;
+}
+
+static size_t write_cached_clauses (kissat *solver, FILE *file) {
+  const unsigned tier2 = MAX (TIER1, TIER2);
+  size_t written = 0;
+  for (all_clauses (c))
+    if (!c->garbage && c->redundant && c->glue <= tier2)
+      written += write_cached_clause (solver, c, file);
+  return written;
+}
+
+bool kissat_write_cache (kissat *solver, int max_var, int status,
+                         FILE *file) {
+  fprintf (file, "kissat-cache %d %016" PRIx64 "\n", CACHE_VERSION,
+           solver->original_hash);
+  write_cached_phases (solver, max_var, status, file);
+  write_cached_units (solver, file);
+  const size_t written = write_cached_clauses (solver, file);
+  kissat_verbose (solver, "cached %zu learned clauses", written);
+  (void) written;
+  return !ferror (file) && !fflush (file);
+}
+
+bool kissat_read_cached_int (FILE *file, int *res_ptr) {
+  int ch;
+  do
+    ch = getc (file);
+  while (isspace (ch));
+  const bool negative = (ch == '-');
+  if (negative)
+    ch = getc (file);
+  if (!isdigit (ch))
+    return false;
+  int res = ch - '0';
+  while (isdigit (ch = getc (file))) {
+    if (res > EXTERNAL_MAX_VAR / 10)
+      return false;
+    res = 10 * res + (ch - '0');
+    if (res > EXTERNAL_MAX_VAR)
+      return false;
+  }
+  if (ch != EOF && !isspace (ch))
+    return false;
+  *res_ptr = negative ? -res : res;
+  return true;
+}
+
+static bool hinted_variable (kissat *solver, int elit) {
+  const unsigned eidx = ABS (elit);
+  if (eidx >= SIZE_STACK (solver->import))
+    return false;
+  const import *const import = &PEEK_STACK (solver->import, eidx);
+  return import->imported && !import->eliminated && !import->extension;
+}
+
+static const int *import_cached_clause (void *state) {
+  cache *cache = state;
+  const size_t size = SIZE_STACK (cache->clauses);
+  if (cache->next == size)
+    return 0;
+  const int *const begin = BEGIN_STACK (cache->clauses);
+  const int *res = begin + cache->next;
+  while (begin[cache->next])
+    cache->next++;
+  cache->next++;
+  return res;
+}
+
+const char *kissat_read_cache (kissat *solver, cache *cache, FILE *file) {
+  uint64_t hash;
+  int version;
+  if (fscanf (file, "kissat-cache %d %" SCNx64, &version, &hash) != 2)
+    return "invalid cache header";
+  if (version != CACHE_VERSION)
+    return "unsupported cache version";
+  size_t phases = 0;
+  int elit;
+  do {
+    if (!kissat_read_cached_int (file, &elit))
+      return "invalid cached phase";
+    if (elit && hinted_variable (solver, elit)) {
+      kissat_set_phase (solver, elit);
+      phases++;
+    }
+  } while (elit);
+  kissat_message (solver, "read %zu cached phases", phases);
+  (void) phases;
+  if (hash != solver->original_hash) {
+    kissat_warning (solver, "cached formula hash %016" PRIx64
+                    " does not match %016" PRIx64 " (skipping clauses)",
+                    hash, solver->original_hash);
+    return 0;
+  }
+  size_t clauses = 0;
+  int ch;
+  while ((ch = getc (file)) != EOF) {
+    if (isspace (ch))
+      continue;
+    ungetc (ch, file);
+    do {
+      if (!kissat_read_cached_int (file, &elit))
+        return "invalid cached clause";
+      PUSH_STACK (cache->clauses, elit);
+    } while (elit);
+    clauses++;
+  }
+  kissat_message (solver, "read %zu cached clauses", clauses);
+  (void) clauses;
+  if (clauses)
+    kissat_set_import (solver, cache, import_cached_clause);
+  return 0;
+}
+
+void kissat_release_cache (kissat *solver, cache *cache) {
+  RELEASE_STACK (cache->clauses);
+}
+
+bool kissat_flushing_cache (kissat *solver) {
+  if (!solver->flusher.flush)
+    return false;
+  return CONFLICTS >= solver->limits.flush.conflicts;
+}
+
+void kissat_flush_cache (kissat *solver) {
+  flusher *flusher = &solver->flusher;
+  assert (flusher->flush);
+  assert (kissat_propagated (solver));
+  INC (cache_flushes);
+  kissat_very_verbose (solver,
+                       "cache flush %" PRIu64 " after %" PRIu64
+                       " conflicts",
+                       solver->statistics.cache_flushes, CONFLICTS);
+  flusher->flush (flusher->state);
+  solver->limits.flush.conflicts = CONFLICTS + GET_OPTION (cacheint);
+}
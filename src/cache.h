@@ -0,0 +1,54 @@
+#ifndef _cache_h_INCLUDED
+#define _cache_h_INCLUDED
+
+#include "stack.h"
+
+#include <stdbool.h>
+#include <stdio.h>
+
+// A cache file stores phases and high quality learned clauses of a run in
+// order to warm start later runs.  It starts with a header line
+// 'kissat-cache <version> <hash>' where '<hash>' is the hexadecimal hash
+// of the original clauses in the order they were added.  It is followed
+// by a zero-terminated list of phase literals and then zero-terminated
+// clauses in DIMACS format (units, tier-1 and tier-2 learned clauses).
+// Phases are always used as hints while the clauses are only imported if
+// the hash matches (through the import callback at restarts).  Files with
+// a different version are rejected.
+
+#define CACHE_VERSION 1
+
+typedef struct cache cache;
+typedef struct flusher flusher;
+
+struct cache {
+  ints clauses;
+  size_t next;
+};
+
+// During search the cache flush callback (see 'kissat_set_cache_flush') is
+// called every 'cacheint' conflicts, which the application uses to write
+// the cache file periodically.  Thus the phases and learned clauses of an
+// interrupted run are kept up to the last flush.  This is not a snapshot
+// of the complete solver state (statistics, limits, scores and the
+// reconstruction stack are not saved).
+
+struct flusher {
+  void *state;
+  void (*flush) (void *);
+};
+
+struct kissat;
+
+bool kissat_flushing_cache (struct kissat *);
+void kissat_flush_cache (struct kissat *);
+
+bool kissat_write_cache (struct kissat *, int max_var, int status, FILE *);
+const char *kissat_read_cache (struct kissat *, cache *, FILE *);
+void kissat_release_cache (struct kissat *, cache *);
+
+// Also used for reading reconstruction files (see 'reconstruct.h').
+
+bool kissat_read_cached_int (FILE *, int *);
+
+#endif
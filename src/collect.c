@@ -22,9 +22,10 @@ static void flush_watched_clauses_by_literal (kissat *solver, unsigned lit,
   const assigned *const all_assigned = solver->assigned;
 
   const value lit_value = values[lit];
-  const assigned *const lit_assigned = all_assigned + IDX (lit);
+  const unsigned lit_idx = IDX (lit);
   const value lit_fixed =
-      (lit_value && !lit_assigned->level) ? lit_value : 0;
+      (lit_value && !ASSIGNED_LEVEL (all_assigned, lit_idx)) ? lit_value
+                                                             : 0;
   const unsigned mlit = kissat_map_literal (solver, lit, true);
 
   watches *lit_watches = &WATCHES (lit);
@@ -38,7 +39,9 @@ static void flush_watched_clauses_by_literal (kissat *solver, unsigned lit,
       const unsigned other_idx = IDX (other);
       const value other_value = values[other];
       const value other_fixed =
-          (other_value && !all_assigned[other_idx].level) ? other_value : 0;
+          (other_value && !ASSIGNED_LEVEL (all_assigned, other_idx))
+              ? other_value
+              : 0;
       const unsigned mother = kissat_map_literal (solver, other, compact);
       if (lit_fixed > 0 || other_fixed > 0 || mother == INVALID_LIT) {
         if (lit < other)
@@ -118,12 +121,12 @@ static void update_large_reason (kissat *solver, assigned *assigned,
   assert (forced != INVALID_LIT);
   reference dst_ref = kissat_reference_clause (solver, dst);
   const unsigned forced_idx = IDX (forced);
-  struct assigned *a = assigned + forced_idx;
-  assert (!a->binary);
-  if (a->reason != dst_ref) {
-    LOG ("reason reference %u of %s updated to %u", a->reason,
+  assert (!assigned[forced_idx].binary);
+  unsigned *reason = &ASSIGNED_REASON (assigned, forced_idx);
+  if (*reason != dst_ref) {
+    LOG ("reason reference %u of %s updated to %u", *reason,
          LOGLIT (forced), dst_ref);
-    a->reason = dst_ref;
+    *reason = dst_ref;
   }
   dst->reason = false;
 }
@@ -360,7 +363,8 @@ static reference sparse_sweep_garbage_clauses (kissat *solver, bool compact,
 
       const value tmp = values[lit];
       const unsigned idx = IDX (lit);
-      const unsigned level = tmp ? assigned[idx].level : INVALID_LEVEL;
+      const unsigned level =
+          tmp ? ASSIGNED_LEVEL (assigned, idx) : INVALID_LEVEL;
 
       if (tmp < 0 && !level)
         flushed++;
@@ -451,10 +455,10 @@ static reference sparse_sweep_garbage_clauses (kissat *solver, bool compact,
 
         LOGBINARY (mfirst, msecond,
                    "reason clause[%u] of %s updated to binary reason",
-                   a->reason, LOGLIT (forced));
+                   ASSIGNED_REASON (assigned, forced_idx), LOGLIT (forced));
 
         a->binary = true;
-        a->reason = other;
+        ASSIGNED_REASON (assigned, forced_idx) = other;
       }
 
       if (!redundant && last_irredundant == src) {
@@ -625,6 +629,7 @@ void kissat_sparse_collect (kissat *solver, bool compact, reference start) {
   if (move != INVALID_REF)
     move_redundant_clauses_to_the_end (solver, move);
   rewatch_clauses (solver, start);
+  kissat_rebuild_slabs (solver, LITS, solver->watches);
   REPORT (1, 'C');
   kissat_check_statistics (solver);
   STOP (collect);
@@ -1,4 +1,5 @@
 #include "compact.h"
+#include "congruence.h"
 #include "inline.h"
 #include "inlineheap.h"
 #include "print.h"
@@ -103,6 +104,14 @@ static void compact_literal (kissat *solver, unsigned dst_lit,
   assert (dst_idx != src_idx);
   LOG ("mapping old internal literal %u to %u", src_lit, dst_lit);
   solver->assigned[dst_idx] = solver->assigned[src_idx];
+#ifdef SPLIT_ASSIGNED
+  ASSIGNED_LEVEL (solver->assigned, dst_idx) =
+      ASSIGNED_LEVEL (solver->assigned, src_idx);
+  ASSIGNED_TRAIL (solver->assigned, dst_idx) =
+      ASSIGNED_TRAIL (solver->assigned, src_idx);
+  ASSIGNED_REASON (solver->assigned, dst_idx) =
+      ASSIGNED_REASON (solver->assigned, src_idx);
+#endif
   solver->flags[dst_idx] = solver->flags[src_idx];
 
   solver->phases.best[dst_idx] = solver->phases.best[src_idx];
@@ -214,14 +223,14 @@ static void compact_trail (kissat *solver) {
     assert (mlit != INVALID_LIT);
     POKE_ARRAY (solver->trail, i, mlit);
     const unsigned idx = IDX (ilit);
-    assigned *a = solver->assigned + idx;
-    if (!a->binary)
+    assigned *const assigned = solver->assigned;
+    if (!assigned[idx].binary)
       continue;
-    const unsigned other = a->reason;
+    const unsigned other = ASSIGNED_REASON (assigned, idx);
     assert (VALID_INTERNAL_LITERAL (other));
     const unsigned mother = kissat_map_literal (solver, other, true);
     assert (mother != INVALID_LIT);
-    a->reason = mother;
+    ASSIGNED_REASON (assigned, idx) = mother;
   }
 }
 
@@ -344,6 +353,7 @@ void kissat_finalize_compacting (kissat *solver, unsigned vars,
       POKE_STACK (solver->export, iidx, 0);
   }
 
+  kissat_compact_closure (solver);
   compact_trail (solver);
 
   for (all_variables (iidx)) {
@@ -357,6 +367,14 @@ void kissat_finalize_compacting (kissat *solver, unsigned vars,
     compact_units (solver, mfixed);
 
   memset (solver->assigned + vars, 0, reduced * sizeof (assigned));
+#ifdef SPLIT_ASSIGNED
+  {
+    const size_t bytes = reduced * sizeof (unsigned);
+    memset (solver->assigned_levels + vars, 0, bytes);
+    memset (solver->assigned_positions + vars, 0, bytes);
+    memset (solver->assigned_reasons + vars, 0, bytes);
+  }
+#endif
   memset (solver->flags + vars, 0, reduced * sizeof (flags));
   memset (solver->values + 2 * vars, 0, 2 * reduced * sizeof (value));
   memset (solver->watches + 2 * vars, 0, 2 * reduced * sizeof (watches));
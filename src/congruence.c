@@ -1,6 +1,7 @@
 #include "congruence.h"
 #include "dense.h"
 #include "fifo.h"
+#include "import.h"
 #include "inline.h"
 #include "inlinevector.h"
 #include "internal.h"
@@ -58,6 +59,13 @@ typedef struct gate_hash_table gate_hash_table;
 
 #define REMOVED ((gate *) (~(uintptr_t) 0))
 
+// Gates surviving a closure are saved in 'solver->closure' as a header
+// word (tag and arity), followed by the LHS and the RHS literals.
+
+#define SAVED_HEADER(TAG, ARITY) ((TAG) | ((ARITY) << 2))
+#define SAVED_TAG(HEADER) ((HEADER) & 3)
+#define SAVED_ARITY(HEADER) ((HEADER) >> 2)
+
 #define BEGIN_RHS(G) ((G)->rhs)
 #define END_RHS(G) (BEGIN_RHS (G) + (G)->arity)
 
@@ -106,7 +114,10 @@ typedef struct large_clause_hash_table large_clause_hash_table;
 
 struct closure {
   kissat *solver;
+  bool incremental;
+  bool imported;
   bool *scheduled;
+  bool *reextract;
   gates *occurrences;
   gates garbage;
   unsigneds lits;
@@ -144,7 +155,11 @@ typedef struct closure closure;
 
 static void init_closure (kissat *solver, closure *closure) {
   closure->solver = solver;
+  closure->incremental = GET_OPTION (congruenceincremental);
+  closure->imported = solver->closure_imported;
+  solver->closure_imported = false;
   CALLOC (closure->scheduled, VARS);
+  closure->reextract = 0;
   CALLOC (closure->occurrences, LITS);
   INIT_STACK (closure->garbage);
   INIT_STACK (closure->lits);
@@ -242,9 +257,65 @@ void reset_gate_hash_table (closure *closure) {
   DEALLOC (table, closure->hash.size);
 }
 
+static bool reusable_literal (closure *closure, unsigned lit) {
+  kissat *const solver = closure->solver;
+  const unsigned idx = IDX (lit);
+  const flags *const flags = FLAGS (idx);
+  if (!flags->active)
+    return false;
+  if (flags->congruence && !closure->imported)
+    return false;
+  if (VALUE (lit))
+    return false;
+  return closure->repr[lit] == lit;
+}
+
+static bool reusable_gate (closure *closure, gate *g) {
+  if (g->garbage)
+    return false;
+  if (!reusable_literal (closure, g->lhs))
+    return false;
+  for (all_rhs_literals_in_gate (lit, g))
+    if (!reusable_literal (closure, lit))
+      return false;
+  return true;
+}
+
+static unsigned rank_gate_lhs (gate *g) { return g->lhs; }
+
+static void save_gates (closure *closure) {
+  kissat *const solver = closure->solver;
+  unsigneds *saved = &solver->closure;
+  assert (EMPTY_STACK (*saved));
+  gate **table = closure->hash.table;
+  gates reusable;
+  INIT_STACK (reusable);
+  for (size_t pos = 0; pos != closure->hash.size; pos++) {
+    gate *g = table[pos];
+    if (!g || g == REMOVED)
+      continue;
+    if (reusable_gate (closure, g))
+      PUSH_STACK (reusable, g);
+  }
+  RADIX_STACK (gate *, unsigned, reusable, rank_gate_lhs);
+  for (all_pointers (gate, g, reusable)) {
+    PUSH_STACK (*saved, SAVED_HEADER (g->tag, g->arity));
+    PUSH_STACK (*saved, g->lhs);
+    for (all_rhs_literals_in_gate (lit, g))
+      PUSH_STACK (*saved, lit);
+  }
+  SHRINK_STACK (*saved);
+  kissat_extremely_verbose (solver, "saved %zu gates for next closure",
+                            SIZE_STACK (reusable));
+  RELEASE_STACK (reusable);
+}
+
 static void reset_closure (closure *closure) {
   kissat *const solver = closure->solver;
 
+  if (closure->incremental && !solver->inconsistent)
+    save_gates (closure);
+
   gates *occurrences = closure->occurrences;
   for (all_literals (lit))
     RELEASE_STACK (occurrences[lit]);
@@ -2223,6 +2294,17 @@ static uint64_t rank_litpair (litpair p) {
   return res;
 }
 
+static bool dirty_clause (closure *closure, clause *c) {
+  if (!closure->incremental)
+    return true;
+  kissat *const solver = closure->solver;
+  const flags *const flags = solver->flags;
+  for (all_literals_in_clause (lit, c))
+    if (flags[IDX (lit)].congruence)
+      return true;
+  return false;
+}
+
 static void extract_binaries (closure *closure) {
   kissat *const solver = closure->solver;
   if (!GET_OPTION (congruencebinaries))
@@ -2264,6 +2346,8 @@ static void extract_binaries (closure *closure) {
       continue;
     if (d->size != 3)
       continue;
+    if (!dirty_clause (closure, d))
+      continue;
     const unsigned *lits = d->lits;
     const unsigned a = lits[0];
     if (values[a])
@@ -3168,10 +3252,13 @@ static void init_xor_gate_extraction (closure *closure,
       considered_clauses);
 #endif
   const unsigned counting_rounds = GET_OPTION (congruencexorcounts);
+  unsigned *new_largecount = 0;
   for (unsigned round = 1; round <= counting_rounds; round++) {
     size_t removed = 0;
-    unsigned *new_largecount;
-    CALLOC (new_largecount, LITS);
+    if (new_largecount)
+      memset (new_largecount, 0, LITS * sizeof *new_largecount);
+    else
+      CALLOC (new_largecount, LITS);
     const reference *const end_candidates = END_STACK (*candidates);
     reference *q = BEGIN_STACK (*candidates), *p = q;
     while (p != end_candidates) {
@@ -3196,8 +3283,7 @@ static void init_xor_gate_extraction (closure *closure,
       *q++ = ref;
     CONTINUE_WITH_NEXT_CANDIDATE_CLAUSE:;
     }
-    DEALLOC (largecount, LITS);
-    largecount = new_largecount;
+    SWAP (unsigned *, largecount, new_largecount);
     SET_END_OF_STACK (*candidates, q);
     if (!removed)
       break;
@@ -3223,6 +3309,8 @@ static void init_xor_gate_extraction (closure *closure,
         how_often);
 #endif
   }
+  if (new_largecount)
+    DEALLOC (new_largecount, LITS);
   closure->largecount = largecount;
 #ifdef INDEX_LARGE_CLAUSES
   init_large_clauses (closure, SIZE_STACK (*candidates));
@@ -3292,6 +3380,17 @@ static void init_ite_gate_extraction (closure *closure,
         largecount[lit]++;
   CONTINUE_COUNTING_NEXT_CLAUSE:;
   }
+  if (closure->incremental) {
+    bool *reextract;
+    CALLOC (reextract, VARS);
+    for (all_stack (reference, ref, ternary)) {
+      clause *c = kissat_dereference_clause (solver, ref);
+      if (dirty_clause (closure, c))
+        for (all_literals_in_clause (lit, c))
+          reextract[IDX (lit)] = true;
+    }
+    closure->reextract = reextract;
+  }
 #ifndef QUIET
   size_t counted = SIZE_STACK (ternary);
   kissat_very_verbose (solver,
@@ -3361,6 +3460,10 @@ static void reset_ite_gate_extraction (closure *closure) {
   RELEASE_STACK (closure->condeq[0]);
   RELEASE_STACK (closure->condeq[1]);
   DEALLOC (closure->largecount, LITS);
+  if (closure->reextract) {
+    DEALLOC (closure->reextract, VARS);
+    closure->reextract = 0;
+  }
   kissat_flush_all_connected (solver);
 }
 
@@ -3423,15 +3526,14 @@ static bool less_litpair (litpair p, litpair q) {
   return c < d;
 }
 
-#define RADIDX_SORT_PAIR_LIMIT 32
+#define RADIX_SORT_PAIR_LIMIT 32
 
 static void sort_pairs (kissat *solver, litpairs *pairs) {
   const size_t size = SIZE_STACK (*pairs);
-  if (size < 32)
+  if (size < RADIX_SORT_PAIR_LIMIT)
     SORT_STACK (litpair, *pairs, less_litpair);
   else
-    for (int i = 1; i >= 0; i--)
-      RADIX_STACK (litpair, uint64_t, *pairs, rank_litpair);
+    RADIX_STACK (litpair, uint64_t, *pairs, rank_litpair);
 }
 
 static bool find_litpair_second_literal (unsigned lit, const litpair *begin,
@@ -3885,6 +3987,8 @@ static void extract_and_gates (closure *closure) {
       continue;
     if (c->garbage)
       continue;
+    if (!dirty_clause (closure, c))
+      continue;
     extract_and_gates_with_base_clause (closure, c);
   }
   reset_and_gate_extraction (closure);
@@ -3923,6 +4027,8 @@ static void extract_xor_gates (closure *closure) {
     clause *c = kissat_dereference_clause (solver, ref);
     if (c->garbage)
       continue;
+    if (!dirty_clause (closure, c))
+      continue;
     extract_xor_gates_with_base_clause (closure, c);
   }
   reset_xor_gate_extraction (closure);
@@ -3953,9 +4059,10 @@ static void extract_ite_gates (closure *closure) {
   const uint64_t matched_before = s->congruent_matched_ites;
   const uint64_t gates_before = s->congruent_gates_ites;
 #endif
+  const bool *const reextract = closure->reextract;
 #ifdef MERGE_CONDITIONAL_EQUIVALENCES
   for (all_variables (idx))
-    if (ACTIVE (idx)) {
+    if (ACTIVE (idx) && (!reextract || reextract[idx])) {
       extract_ite_gates_of_variable (closure, idx);
       if (solver->inconsistent)
         break;
@@ -3969,6 +4076,14 @@ static void extract_ite_gates (closure *closure) {
     clause *c = kissat_dereference_clause (solver, ref);
     if (c->garbage)
       continue;
+    if (reextract) {
+      bool skip = true;
+      for (all_literals_in_clause (lit, c))
+        if (reextract[IDX (lit)])
+          skip = false;
+      if (skip)
+        continue;
+    }
     extract_ite_gates_with_base_clause (closure, c);
   }
 #endif
@@ -3987,6 +4102,170 @@ static void extract_ite_gates (closure *closure) {
   STOP (extractites);
 }
 
+static bool load_gate (closure *closure, unsigned tag, unsigned lhs,
+                       unsigned arity, unsigned *lits) {
+  kissat *const solver = closure->solver;
+  unsigned hash;
+  gate *g;
+  if (tag == AND_GATE) {
+    g = find_and_lits (closure, &hash, arity, lits, 0);
+    if (g) {
+      if (merge_literals (closure, g->lhs, lhs))
+        INC (congruent_ands);
+      return false;
+    }
+  } else if (tag == XOR_GATE) {
+    g = find_xor_lits (closure, &hash, arity, lits, 0);
+    if (g) {
+      add_xor_matching_proof_chain (closure, g, g->lhs, lhs);
+      if (merge_literals (closure, g->lhs, lhs))
+        INC (congruent_xors);
+      if (!solver->inconsistent)
+        delete_proof_chain (closure);
+      return false;
+    }
+  } else {
+    assert (tag == ITE_GATE);
+    bool negate_lhs;
+    g = find_ite_lits (closure, &hash, &negate_lhs, arity, lits, 0);
+    if (negate_lhs)
+      lhs = NOT (lhs);
+    if (g) {
+      add_ite_matching_proof_chain (closure, g, g->lhs, lhs);
+      if (merge_literals (closure, g->lhs, lhs))
+        INC (congruent_ites);
+      if (!solver->inconsistent)
+        delete_proof_chain (closure);
+      return false;
+    }
+  }
+  g = new_gate (closure, tag, hash, lhs, arity, lits);
+  if (tag == AND_GATE)
+    check_and_gate_implied (closure, g);
+  else if (tag == XOR_GATE)
+    check_xor_gate_implied (closure, g);
+  else
+    check_ite_gate_implied (closure, g);
+  INC (congruent_loaded);
+  return true;
+}
+
+// Gates of the previous closure are still implied by the formula if no
+// irredundant clause with one of their variables has been added or
+// removed since then, i.e., if none of their variables has been marked
+// with the 'congruence' flag.  Those are loaded into the hash table and
+// only base clauses with such a marked variable are used to extract gates
+// during this round.
+
+static void load_gates (closure *closure) {
+  kissat *const solver = closure->solver;
+  unsigneds *saved = &solver->closure;
+  if (!closure->incremental) {
+    RELEASE_STACK (*saved);
+    return;
+  }
+  unsigneds *rhs = &closure->rhs;
+  const unsigned *const end = END_STACK (*saved);
+  const unsigned *p = BEGIN_STACK (*saved);
+#ifndef QUIET
+  size_t loaded = 0, dropped = 0;
+#endif
+  while (p != end && !solver->inconsistent) {
+    const unsigned header = *p++;
+    const unsigned tag = SAVED_TAG (header);
+    const unsigned arity = SAVED_ARITY (header);
+    const unsigned lhs = *p++;
+    const unsigned *const end_lits = p + arity;
+    CLEAR_STACK (*rhs);
+    bool reusable = reusable_literal (closure, lhs);
+    while (p != end_lits) {
+      const unsigned lit = *p++;
+      if (reusable && !reusable_literal (closure, lit))
+        reusable = false;
+      PUSH_STACK (*rhs, lit);
+    }
+    if (!reusable) {
+#ifndef QUIET
+      dropped++;
+#endif
+      continue;
+    }
+    if (load_gate (closure, tag, lhs, arity, BEGIN_STACK (*rhs))) {
+#ifndef QUIET
+      loaded++;
+#endif
+    }
+  }
+  RELEASE_STACK (*saved);
+#ifndef QUIET
+  kissat_phase (solver, "congruence", GET (closures),
+                "loaded %zu gates of previous closure (dropped %zu)",
+                loaded, dropped);
+#endif
+}
+
+// Gates already known while parsing (the AND gates of AIGER models) are
+// given as triples of external literals and stored as saved gates of a
+// previous closure.  The first closure loads them even though their
+// variables are dirty and skips extracting AND gates again from their
+// Tseitin clauses.  The variables stay dirty though, such that XOR and ITE
+// gates encoded by these AND gates are still extracted.
+
+void kissat_import_and_gates (kissat *solver, size_t size,
+                              const int *gates) {
+  assert (!(size % 3));
+  if (!GET_OPTION (congruence) || !GET_OPTION (congruenceincremental))
+    return;
+  if (solver->inconsistent)
+    return;
+  unsigneds *saved = &solver->closure;
+  assert (EMPTY_STACK (*saved));
+  const int *const end = gates + size;
+  for (const int *p = gates; p != end; p += 3) {
+    PUSH_STACK (*saved, SAVED_HEADER (AND_GATE, 2));
+    for (unsigned i = 0; i != 3; i++)
+      PUSH_STACK (*saved, kissat_import_literal (solver, p[i]));
+  }
+  SHRINK_STACK (*saved);
+  solver->closure_imported = true;
+  kissat_very_verbose (solver, "imported %zu gates for congruence closure",
+                       size / 3);
+}
+
+static void clear_dirty_variables (closure *closure) {
+  kissat *const solver = closure->solver;
+  flags *const flags = solver->flags;
+  for (all_variables (idx))
+    flags[idx].congruence = false;
+}
+
+void kissat_compact_closure (kissat *solver) {
+  unsigneds *saved = &solver->closure;
+  unsigned *q = BEGIN_STACK (*saved);
+  const unsigned *const end = END_STACK (*saved);
+  const unsigned *p = q;
+  while (p != end) {
+    const unsigned header = *p;
+    const unsigned size = SAVED_ARITY (header) + 2;
+    const unsigned *const next = p + size;
+    unsigned *const begin = q;
+    *q++ = *p++;
+    while (p != next) {
+      const unsigned ilit = *p++;
+      const unsigned idx = IDX (ilit);
+      if (!ACTIVE (idx)) {
+        q = begin, p = next;
+        break;
+      }
+      const unsigned mlit = kissat_map_literal (solver, ilit, true);
+      assert (mlit != INVALID_LIT);
+      *q++ = mlit;
+    }
+  }
+  SET_END_OF_STACK (*saved, q);
+  SHRINK_STACK (*saved);
+}
+
 static void init_extraction (closure *closure) {
   kissat *const solver = closure->solver;
   kissat_enter_dense_mode (solver, &closure->binaries);
@@ -4009,13 +4288,18 @@ static void extract_gates (closure *closure) {
   init_extraction (closure);
   extract_binaries (closure);
   assert (!solver->inconsistent);
-  extract_and_gates (closure);
+  load_gates (closure);
+  if (!solver->inconsistent && !closure->imported)
+    extract_and_gates (closure);
+  closure->imported = false;
   if (!solver->inconsistent && !TERMINATED (congruence_terminated_4)) {
     extract_xor_gates (closure);
     if (!solver->inconsistent && !TERMINATED (congruence_terminated_5))
       extract_ite_gates (closure);
   }
   reset_extraction (closure);
+  if (closure->incremental && !solver->inconsistent)
+    clear_dirty_variables (closure);
 #ifndef QUIET
   const uint64_t after = s->congruent_gates + s->congruent_matched;
   const uint64_t found = after - before;
@@ -4575,6 +4859,15 @@ static void forward_subsume_matching_clauses (closure *closure) {
   STOP (matching);
 }
 
+// Closures are not limited by an effort limit, but gate extraction and
+// forward subsumption go over all irredundant clauses a bounded number of
+// times, which gives a rough estimate of the cost of a closure in ticks.
+
+static uint64_t closure_ticks (kissat *solver) {
+  const size_t bytes = SIZE_STACK (solver->arena) * sizeof (ward);
+  return 1 + (bytes >> ASSUMED_LD_CACHE_LINE_BYTES) + LITS;
+}
+
 bool kissat_congruence (kissat *solver) {
   if (solver->inconsistent)
     return false;
@@ -4584,6 +4877,8 @@ bool kissat_congruence (kissat *solver) {
   assert (solver->watching);
   if (!GET_OPTION (congruence))
     return false;
+  if (solver->propagator.connected)
+    return false;
   if (!GET_OPTION (congruenceands) && !GET_OPTION (congruenceites) &&
       !GET_OPTION (congruencexors))
     return false;
@@ -4595,6 +4890,8 @@ bool kissat_congruence (kissat *solver) {
     return false;
   START (congruence);
   INC (closures);
+  START_PAYOFF (congruence, congruence_ticks);
+  ADD (congruence_ticks, closure_ticks (solver));
   closure closure;
   init_closure (solver, &closure);
   extract_gates (&closure);
@@ -4626,7 +4923,9 @@ bool kissat_congruence (kissat *solver) {
   if (!solver->inconsistent)
     solver->active += equivalent;
 #endif
-  if (kissat_average (equivalent, solver->active) < 0.001)
+  STOP_PAYOFF (congruence, congruence_ticks);
+  const double scale = solver->payoffs.congruence.scale;
+  if (kissat_average (equivalent, solver->active) < 0.001 / scale)
     BUMP_DELAY (congruence);
   else
     REDUCE_DELAY (congruence);
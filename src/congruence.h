@@ -2,8 +2,11 @@
 #define _congruence_h_INCLUDED
 
 #include <stdbool.h>
+#include <stddef.h>
 
 struct kissat;
 bool kissat_congruence (struct kissat *);
+void kissat_compact_closure (struct kissat *);
+void kissat_import_and_gates (struct kissat *, size_t, const int *);
 
 #endif
@@ -0,0 +1,90 @@
+#include "convert.h"
+#include "internal.h"
+#include "sort.h"
+
+#include <inttypes.h>
+#include <string.h>
+
+void kissat_init_converter (kissat *solver, converter *converter,
+                            file *file) {
+  memset (converter, 0, sizeof *converter);
+  converter->solver = solver;
+  converter->file = file;
+}
+
+void kissat_convert_header (converter *converter, int variables,
+                            uint64_t clauses) {
+  char header[64];
+  const int len = snprintf (header, sizeof header,
+                            "kcnf %d %" PRIu64 " 1\n", variables, clauses);
+  assert (0 < len && (size_t) len < sizeof header);
+  kissat_write (converter->file, header, len);
+}
+
+static void push_varint (kissat *solver, chars *bytes, unsigned u) {
+  while (u > 127) {
+    PUSH_STACK (*bytes, (char) ((u & 127) | 128));
+    u >>= 7;
+  }
+  PUSH_STACK (*bytes, (char) u);
+}
+
+static void write_varint (file *file, uint64_t u) {
+  while (u > 127) {
+    kissat_putc (file, (u & 127) | 128);
+    u >>= 7;
+  }
+  kissat_putc (file, u);
+}
+
+static void write_block (converter *converter) {
+  file *const file = converter->file;
+  chars *const block = &converter->block;
+  const size_t size = SIZE_STACK (*block);
+  write_varint (file, converter->clauses_in_block);
+  write_varint (file, size);
+  kissat_write (file, BEGIN_STACK (*block), size);
+  uint32_t hash = CONVERT_CHECKSUM_INIT;
+  for (all_stack (char, ch, *block))
+    hash = kissat_convert_checksum (hash, (unsigned char) ch);
+  for (unsigned i = 0; i < 4; i++, hash >>= 8)
+    kissat_putc (file, hash & 255);
+  CLEAR_STACK (*block);
+  converter->clauses_in_block = 0;
+}
+
+#define LESS_ULIT(A, B) ((A) < (B))
+
+void kissat_convert_literal (converter *converter, int lit) {
+  kissat *solver = converter->solver;
+  unsigneds *const clause = &converter->clause;
+  if (lit) {
+    assert (lit != INT_MIN);
+    PUSH_STACK (*clause, 2u * ABS (lit) + (lit < 0));
+    return;
+  }
+  SORT_STACK (unsigned, *clause, LESS_ULIT);
+  chars *const block = &converter->block;
+  push_varint (solver, block, SIZE_STACK (*clause));
+  unsigned prev = 0;
+  for (all_stack (unsigned, ulit, *clause)) {
+    push_varint (solver, block, ulit - prev);
+    prev = ulit;
+  }
+  CLEAR_STACK (*clause);
+  converter->clauses++;
+  converter->clauses_in_block++;
+  if (SIZE_STACK (*block) >= CONVERT_BLOCK_SIZE)
+    write_block (converter);
+}
+
+bool kissat_release_converter (converter *converter) {
+  kissat *solver = converter->solver;
+  if (converter->clauses_in_block)
+    write_block (converter);
+  write_varint (converter->file, 0);
+  RELEASE_STACK (converter->clause);
+  RELEASE_STACK (converter->block);
+  kissat_flush (converter->file);
+  return !ferror (converter->file->file);
+}
@@ -0,0 +1,51 @@
+#ifndef _convert_h_INCLUDED
+#define _convert_h_INCLUDED
+
+#include "file.h"
+#include "stack.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// The binary CNF format starts with the header line
+//
+//   kcnf <variables> <clauses> <checksums>
+//
+// followed by blocks of clauses.  Each block consists of the number of
+// clauses in the block and the number of bytes of its payload as
+// variable length integers (7 bits per byte, least significant first,
+// with the highest bit set if more bytes follow).  The payload encodes
+// each clause by its size followed by the differences of its sorted
+// literals 'ulit = 2 * idx + (lit < 0)' (the first one to zero).  If
+// '<checksums>' is '1' the payload is followed by its 32-bit FNV-1a hash
+// (least significant byte first).  A block with zero clauses ends the
+// file.  Since the header gives the number of variables up-front and
+// blocks are handed over as a whole to 'kissat_add_clauses' parsing is
+// much faster than for ASCII DIMACS.
+
+#define CONVERT_BLOCK_SIZE (1u << 20)
+
+typedef struct converter converter;
+
+struct converter {
+  struct kissat *solver;
+  file *file;
+  unsigneds clause;
+  chars block;
+  unsigned clauses_in_block;
+  uint64_t clauses;
+};
+
+void kissat_init_converter (struct kissat *, converter *, file *);
+void kissat_convert_header (converter *, int variables, uint64_t clauses);
+void kissat_convert_literal (converter *, int lit);
+bool kissat_release_converter (converter *);
+
+static inline uint32_t kissat_convert_checksum (uint32_t hash,
+                                                unsigned byte) {
+  return (hash ^ byte) * 16777619u;
+}
+
+#define CONVERT_CHECKSUM_INIT 2166136261u
+
+#endif
@@ -41,7 +41,7 @@ static inline bool analyze_literal (kissat *solver, assigned *all_assigned,
   assert (VALUE (lit) < 0);
   const unsigned idx = IDX (lit);
   assigned *a = all_assigned + idx;
-  const unsigned level = a->level;
+  const unsigned level = ASSIGNED_LEVEL (all_assigned, idx);
   if (!level)
     return false;
   solver->antecedent_size++;
@@ -101,24 +101,27 @@ clause *kissat_deduce_first_uip_clause (kissat *solver, clause *conflict) {
   unsigned resolved = 0;
   assigned *a = 0;
   for (;;) {
+    unsigned idx;
     do {
       assert (t > BEGIN_ARRAY (solver->trail));
       uip = *--t;
-      a = ASSIGNED (uip);
-    } while (!a->analyzed || a->level != solver->level);
+      idx = IDX (uip);
+      a = all_assigned + idx;
+    } while (!a->analyzed ||
+             ASSIGNED_LEVEL (all_assigned, idx) != solver->level);
     if (unresolved_on_current_level == 1)
       break;
-    assert (a->reason != DECISION_REASON);
-    assert (a->level == solver->level);
+    const unsigned uip_reason = ASSIGNED_REASON (all_assigned, idx);
+    assert (uip_reason != DECISION_REASON);
     solver->antecedent_size = 1;
     resolved++;
     if (a->binary) {
-      const unsigned other = a->reason;
+      const unsigned other = uip_reason;
       LOGBINARY (uip, other, "resolving %s reason", LOGLIT (uip));
       if (analyze_literal (solver, all_assigned, frames, other))
         unresolved_on_current_level++;
     } else {
-      const reference ref = a->reason;
+      const reference ref = uip_reason;
       LOGREF (ref, "resolving %s reason", LOGLIT (uip));
       clause *reason = kissat_dereference_clause (solver, ref);
       for (all_literals_in_clause (lit, reason))
@@ -144,9 +147,9 @@ clause *kissat_deduce_first_uip_clause (kissat *solver, clause *conflict) {
         solver->resolvent_size < solver->antecedent_size) {
       assert (!a->binary);
       assert (solver->antecedent_size && solver->resolvent_size + 1);
-      clause *reason = kissat_dereference_clause (solver, a->reason);
-      assert (!reason->garbage);
-      clause *res = kissat_on_the_fly_strengthen (solver, reason, uip);
+      clause *c = kissat_dereference_clause (solver, uip_reason);
+      assert (!c->garbage);
+      clause *res = kissat_on_the_fly_strengthen (solver, c, uip);
       if (resolved == 1 && solver->resolvent_size < conflict_size) {
         assert (!conflict->garbage);
         assert (conflict_size > 2);
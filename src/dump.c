@@ -68,20 +68,21 @@ static void dump_trail (kissat *solver) {
       if (lit_level < level)
         printf (" out-of-order");
       assigned *a = ASSIGNED (lit);
+      const unsigned reason = REASON (lit);
       if (!lit_level) {
         printf (" UNIT\n");
         assert (!a->binary);
-        assert (a->reason == UNIT_REASON);
+        assert (reason == UNIT_REASON);
       } else {
         fputc (' ', stdout);
         if (a->binary) {
-          const unsigned other = a->reason;
+          const unsigned other = reason;
           dump_binary (solver, lit, other);
-        } else if (a->reason == DECISION_REASON)
+        } else if (reason == DECISION_REASON)
           printf ("DECISION\n");
         else {
-          assert (a->reason != UNIT_REASON);
-          const reference ref = a->reason;
+          assert (reason != UNIT_REASON);
+          const reference ref = reason;
           dump_ref (solver, ref);
         }
       }
@@ -200,7 +201,10 @@ static void dump_extend (kissat *solver) {
     if (!p[1].blocking)
       fputs (" :", stdout);
     for (q = p + 1; q != end && !q->blocking; q++)
-      printf (" %d", q->lit);
+      if (q->lit)
+        printf (" %d", q->lit);
+      else
+        fputs (" <compressed>", stdout);
     fputc ('\n', stdout);
   }
 }
@@ -0,0 +1,101 @@
+#include "duplicates.h"
+#include "allocate.h"
+#include "inline.h"
+#include "logging.h"
+
+static inline unsigned hash_literal (unsigned lit) {
+  unsigned res = lit * 2654435761u;
+  res ^= res >> 15;
+  return res * 2246822519u;
+}
+
+static unsigned hash_literals (unsigned size, const unsigned *lits) {
+  unsigned res = size;
+  for (const unsigned *p = lits, *const end = lits + size; p != end; p++)
+    res += hash_literal (*p);
+  return res;
+}
+
+static bool marked_clause (kissat *solver, clause *c) {
+  const value *const marks = solver->marks;
+  for (all_literals_in_clause (lit, c))
+    if (marks[lit] <= 0)
+      return false;
+  return true;
+}
+
+bool kissat_duplicated_original (kissat *solver, unsigned size,
+                                 const unsigned *lits, unsigned *hash_ptr) {
+  assert (size > 2);
+  if (!GET_OPTION (deduplicate))
+    return false;
+  const unsigned hash = hash_literals (size, lits);
+  *hash_ptr = hash;
+  duplicates *duplicates = &solver->duplicates;
+  if (!duplicates->count)
+    return false;
+  const size_t mask = duplicates->size - 1;
+  const hashed_clause *const table = duplicates->table;
+  for (size_t pos = hash & mask;; pos = (pos + 1) & mask) {
+    const hashed_clause *const entry = table + pos;
+    if (entry->ref == INVALID_REF)
+      return false;
+    if (entry->hash != hash)
+      continue;
+    clause *const c = kissat_dereference_clause (solver, entry->ref);
+    if (c->size != size)
+      continue;
+    if (!marked_clause (solver, c))
+      continue;
+    LOGCLS (c, "duplicated by new original clause");
+    INC (deduplicated);
+    return true;
+  }
+}
+
+static void insert_hashed (hashed_clause *table, size_t mask,
+                           hashed_clause hashed) {
+  size_t pos = hashed.hash & mask;
+  while (table[pos].ref != INVALID_REF)
+    pos = (pos + 1) & mask;
+  table[pos] = hashed;
+}
+
+static void enlarge_duplicates (kissat *solver, duplicates *duplicates) {
+  const size_t old_size = duplicates->size;
+  const size_t new_size = old_size ? 2 * old_size : 1u << 10;
+  hashed_clause *old_table = duplicates->table;
+  hashed_clause *new_table =
+      kissat_nalloc (solver, new_size, sizeof (hashed_clause));
+  for (size_t pos = 0; pos != new_size; pos++)
+    new_table[pos].ref = INVALID_REF;
+  const size_t new_mask = new_size - 1;
+  for (size_t pos = 0; pos != old_size; pos++)
+    if (old_table[pos].ref != INVALID_REF)
+      insert_hashed (new_table, new_mask, old_table[pos]);
+  kissat_dealloc (solver, old_table, old_size, sizeof (hashed_clause));
+  duplicates->table = new_table;
+  duplicates->size = new_size;
+  LOG ("enlarged duplicates hash table to %zu entries", new_size);
+}
+
+void kissat_hash_original (kissat *solver, unsigned hash, reference ref) {
+  assert (GET_OPTION (deduplicate));
+  assert (ref != INVALID_REF);
+  duplicates *duplicates = &solver->duplicates;
+  if (2 * (duplicates->count + 1) > duplicates->size)
+    enlarge_duplicates (solver, duplicates);
+  hashed_clause hashed;
+  hashed.hash = hash;
+  hashed.ref = ref;
+  insert_hashed (duplicates->table, duplicates->size - 1, hashed);
+  duplicates->count++;
+}
+
+void kissat_release_duplicates (kissat *solver) {
+  duplicates *duplicates = &solver->duplicates;
+  kissat_dealloc (solver, duplicates->table, duplicates->size,
+                  sizeof (hashed_clause));
+  duplicates->table = 0;
+  duplicates->count = duplicates->size = 0;
+}
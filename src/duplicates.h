@@ -0,0 +1,34 @@
+#ifndef _duplicates_h_INCLUDED
+#define _duplicates_h_INCLUDED
+
+#include "reference.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// Hash table of large original clauses used while adding clauses before
+// solving, to drop duplicated original clauses before they are allocated
+// in the arena.  The hash is order independent and matching clauses are
+// compared literal by literal.  It is released when solving starts.
+
+typedef struct duplicates duplicates;
+typedef struct hashed_clause hashed_clause;
+
+struct hashed_clause {
+  unsigned hash;
+  reference ref;
+};
+
+struct duplicates {
+  hashed_clause *table;
+  size_t count, size;
+};
+
+struct kissat;
+
+bool kissat_duplicated_original (struct kissat *, unsigned size,
+                                 const unsigned *lits, unsigned *hash_ptr);
+void kissat_hash_original (struct kissat *, unsigned hash, reference);
+void kissat_release_duplicates (struct kissat *);
+
+#endif
@@ -425,7 +425,9 @@ static void eliminate_variables (kissat *solver) {
 #endif
   unsigned last_round_eliminated = 0;
 
-  SET_EFFORT_LIMIT (resolution_limit, eliminate, eliminate_resolutions);
+  START_PAYOFF (eliminate, eliminate_resolutions);
+  SET_PAYOFF_EFFORT_LIMIT (resolution_limit, eliminate,
+                           eliminate_resolutions);
 
   bool complete;
   int round = 0;
@@ -560,6 +562,7 @@ static void eliminate_variables (kissat *solver) {
                            dropped);
     }
   }
+  STOP_PAYOFF (eliminate, eliminate_resolutions);
 }
 
 static void init_map_and_kitten (kissat *solver) {
@@ -41,6 +41,138 @@ static void extend_assign (kissat *solver, value *values, int lit) {
   PUSH_STACK (solver->etrail, pos);
 }
 
+static void push_varint (kissat *solver, unsigned u) {
+  while (u > 127) {
+    PUSH_STACK (solver->compressed, (uint8_t) ((u & 127) | 128));
+    u >>= 7;
+  }
+  PUSH_STACK (solver->compressed, (uint8_t) u);
+}
+
+static void push_reversed_varint (kissat *solver, unsigned u) {
+  uint8_t tmp[5], *p = tmp;
+  while (u > 127) {
+    *p++ = (uint8_t) ((u & 127) | 128);
+    u >>= 7;
+  }
+  *p++ = (uint8_t) u;
+  while (p != tmp)
+    PUSH_STACK (solver->compressed, *--p);
+}
+
+// Encodes the sorted literals as variable length integer deltas on the
+// 'compressed' byte stack, followed by the size of the encoding in
+// reversed order, such that 'kissat_decompress_extension' can traverse
+// the encoded clauses backward.  Returns the number of bytes pushed.
+
+size_t kissat_compress_extension (kissat *solver, const unsigneds *lits) {
+  const size_t before = SIZE_STACK (solver->compressed);
+  const size_t size = SIZE_STACK (*lits);
+  assert (size <= UINT_MAX);
+  push_varint (solver, size);
+  unsigned prev = 0;
+  for (all_stack (unsigned, ulit, *lits)) {
+    assert (prev <= ulit);
+    push_varint (solver, ulit - prev);
+    prev = ulit;
+  }
+  const size_t after = SIZE_STACK (solver->compressed);
+  const size_t bytes = after - before;
+  assert (bytes <= UINT_MAX);
+  push_reversed_varint (solver, bytes);
+  return SIZE_STACK (solver->compressed) - before;
+}
+
+static const uint8_t *read_varint (const uint8_t *p, unsigned *res) {
+  unsigned u = 0, shift = 0;
+  uint8_t byte;
+  do {
+    byte = *p++;
+    u |= (unsigned) (byte & 127) << shift;
+    shift += 7;
+  } while (byte & 128);
+  *res = u;
+  return p;
+}
+
+const uint8_t *kissat_decompress_extension (kissat *solver,
+                                            const uint8_t *end,
+                                            unsigneds *lits) {
+  assert (BEGIN_STACK (solver->compressed) < end);
+  assert (end <= END_STACK (solver->compressed));
+  const uint8_t *p = end;
+  unsigned bytes = 0, shift = 0;
+  uint8_t byte;
+  do {
+    byte = *--p;
+    bytes |= (unsigned) (byte & 127) << shift;
+    shift += 7;
+  } while (byte & 128);
+  const uint8_t *const begin = p - bytes;
+  assert (BEGIN_STACK (solver->compressed) <= begin);
+  unsigned size;
+  p = read_varint (begin, &size);
+  unsigned ulit = 0;
+  for (unsigned i = 0; i < size; i++) {
+    unsigned delta;
+    p = read_varint (p, &delta);
+    ulit += delta;
+    PUSH_STACK (*lits, ulit);
+  }
+  assert (p == begin + bytes);
+#ifdef NDEBUG
+  (void) solver;
+#endif
+  return begin;
+}
+
+static inline void extend_literal (kissat *solver, int elit,
+                                   bool *satisfied, int *eliminated,
+                                   unsigned *pos) {
+  assert (elit != INT_MIN);
+  const unsigned eidx = ABS (elit);
+  assert (eidx < SIZE_STACK (solver->import));
+  const import *const import = &PEEK_STACK (solver->import, eidx);
+  assert (import->imported);
+
+  if (import->eliminated) {
+    const unsigned tmp = import->lit;
+    assert (tmp < SIZE_STACK (solver->eliminated));
+    value value = PEEK_STACK (solver->eliminated, tmp);
+
+    if (elit < 0)
+      value = -value;
+
+    if (value > 0) {
+      LOG2 ("previously assigned eliminated literal %d "
+            "satisfies clause",
+            elit);
+      *satisfied = true;
+    } else if (!value && (!*eliminated || *pos < tmp)) {
+#ifdef LOGGING
+      if (*eliminated)
+        LOG2 ("earlier unassigned eliminated literal %d", elit);
+      else
+        LOG2 ("found unassigned eliminated literal %d", elit);
+#endif
+      *eliminated = elit;
+      *pos = tmp;
+    }
+  } else {
+    const unsigned ilit = import->lit;
+    value value = solver->values[ilit];
+    assert (value);
+
+    if (elit < 0)
+      value = -value;
+
+    if (value > 0) {
+      LOG2 ("internal literal %s satisfies clause", LOGLIT (ilit));
+      *satisfied = true;
+    }
+  }
+}
+
 void kissat_extend (kissat *solver) {
   assert (!EMPTY_STACK (solver->extend));
   assert (!solver->extended);
@@ -54,14 +186,15 @@ void kissat_extend (kissat *solver) {
        SIZE_STACK (solver->extend));
 
   value *evalues = BEGIN_STACK (solver->eliminated);
-  value *ivalues = solver->values;
-
-  const import *const imports = BEGIN_STACK (solver->import);
 
   const extension *const begin = BEGIN_STACK (solver->extend);
   extension const *p = END_STACK (solver->extend);
 
+  const uint8_t *compressed = END_STACK (solver->compressed);
+  unsigneds *decompressed = &solver->decompressed;
+
 #ifdef LOGGING
+  const import *const imports = BEGIN_STACK (solver->import);
   size_t assigned = 0;
   size_t flipped = 0;
 #endif
@@ -85,51 +218,27 @@ void kissat_extend (kissat *solver) {
       if (ext.blocking)
         blocking = elit;
 
+      if (!elit) {
+        assert (!ext.blocking);
+        assert (EMPTY_STACK (*decompressed));
+        compressed = kissat_decompress_extension (solver, compressed,
+                                                  decompressed);
+        if (!satisfied)
+          for (all_stack (unsigned, ulit, *decompressed)) {
+            const int idx = ulit / 2;
+            const int other = (ulit & 1) ? -idx : idx;
+            extend_literal (solver, other, &satisfied, &eliminated, &pos);
+            if (satisfied)
+              break;
+          }
+        CLEAR_STACK (*decompressed);
+        continue;
+      }
+
       if (satisfied)
         continue;
 
-      assert (elit != INT_MIN);
-      const unsigned eidx = ABS (elit);
-      assert (eidx < SIZE_STACK (solver->import));
-      const import *const import = imports + eidx;
-      assert (import->imported);
-
-      if (import->eliminated) {
-        const unsigned tmp = import->lit;
-        assert (tmp < SIZE_STACK (solver->eliminated));
-        value value = evalues[tmp];
-
-        if (elit < 0)
-          value = -value;
-
-        if (value > 0) {
-          LOG2 ("previously assigned eliminated literal %d "
-                "satisfies clause",
-                elit);
-          satisfied = true;
-        } else if (!value && (!eliminated || pos < tmp)) {
-#ifdef LOGGING
-          if (eliminated)
-            LOG2 ("earlier unassigned eliminated literal %d", elit);
-          else
-            LOG2 ("found unassigned eliminated literal %d", elit);
-#endif
-          eliminated = elit;
-          pos = tmp;
-        }
-      } else {
-        const unsigned ilit = import->lit;
-        value value = ivalues[ilit];
-        assert (value);
-
-        if (elit < 0)
-          value = -value;
-
-        if (value > 0) {
-          LOG2 ("internal literal %s satisfies clause", LOGLIT (ilit));
-          satisfied = true;
-        }
-      }
+      extend_literal (solver, elit, &satisfied, &eliminated, &pos);
     } while (!blocking);
 
     if (satisfied) {
@@ -176,6 +285,7 @@ void kissat_extend (kissat *solver) {
        kissat_percent (flipped, assigned), assigned);
   LOG ("extended assignment complete");
 #endif
+  assert (compressed == BEGIN_STACK (solver->compressed));
 
   STOP (extend);
 }
@@ -4,6 +4,8 @@
 #include "stack.h"
 #include "utilities.h"
 
+#include <stdint.h>
+
 typedef struct extension extension;
 
 struct extension {
@@ -13,6 +15,7 @@ struct extension {
 
 // clang-format off
 typedef STACK (extension) extensions;
+typedef STACK (uint8_t) compressed;
 // clang-format on
 
 static inline extension kissat_extension (bool blocking, int lit) {
@@ -27,4 +30,10 @@ struct kissat;
 
 void kissat_extend (struct kissat *solver);
 
+size_t kissat_compress_extension (struct kissat *, const unsigneds *lits);
+
+const uint8_t *kissat_decompress_extension (struct kissat *,
+                                            const uint8_t *end,
+                                            unsigneds *lits);
+
 #endif
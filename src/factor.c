@@ -1068,6 +1068,8 @@ static void connect_clauses_to_factor (kissat *solver) {
 static bool kissat_factoring (kissat *solver) {
   if (!GET_OPTION (factor))
     return false;
+  if (solver->propagator.connected)
+    return false;
   if (!solver->active)
     return false;
   unsigned active = solver->active;
@@ -15,7 +15,7 @@ static inline void kissat_fast_binary_assign (
     if (a->binary) {
       LOGBINARY (lit, other, "jumping %s reason", LOGLIT (lit));
       INC (jumped_reasons);
-      other = a->reason;
+      other = ASSIGNED_REASON (assigned, other_idx);
     }
   }
   kissat_fast_assign (solver, probing, level, values, assigned, true, lit,
@@ -824,6 +824,8 @@ void kissat_fast_variable_elimination (kissat *solver) {
     return;
   if (!GET_OPTION (fastel))
     return;
+  if (solver->propagator.connected)
+    return;
 #ifndef QUIET
   const unsigned variables_before = solver->active;
 #endif
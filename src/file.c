@@ -29,6 +29,15 @@ bool kissat_file_readable (const char *path) {
   return true;
 }
 
+bool kissat_file_regular (const char *path) {
+  if (!path)
+    return false;
+  struct stat buf;
+  if (stat (path, &buf))
+    return false;
+  return S_ISREG (buf.st_mode);
+}
+
 bool kissat_file_writable (const char *path) {
   int res;
   if (!path)
@@ -11,6 +11,7 @@
 
 bool kissat_file_exists (const char *path);
 bool kissat_file_readable (const char *path);
+bool kissat_file_regular (const char *path);
 bool kissat_file_writable (const char *path);
 size_t kissat_file_size (const char *path);
 bool kissat_find_executable (const char *name);
@@ -9,6 +9,7 @@ struct flags {
   bool active : 1;
   bool backbone0 : 1;
   bool backbone1 : 1;
+  bool congruence : 1;
   bool eliminate : 1;
   bool eliminated : 1;
   unsigned factor : 2;
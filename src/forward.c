@@ -183,9 +183,20 @@ static void sort_forward_subsumption_candidates (kissat *solver,
   RADIX_SORT (reference, unsigned, size, references, GET_SIZE_OF_REFERENCE);
 }
 
+// While clauses are connected during forward subsumption the 'searched'
+// field of large clauses is not needed.  We use it to store a 32-bit
+// signature of the variables in the clause, which allows to reject most
+// connected clauses which can neither subsume nor strengthen the checked
+// clause without accessing their literals.  It is reset at the end.
+
+static inline unsigned forward_signature (unsigned idx) {
+  const unsigned hash = idx * 2654435761u;
+  return 1u << (hash >> 27);
+}
+
 static inline bool forward_literal (kissat *solver, unsigned lit,
-                                    bool binaries, unsigned *remove,
-                                    unsigned limit) {
+                                    bool binaries, unsigned signature,
+                                    unsigned *remove, unsigned limit) {
   watches *watches = &WATCHES (lit);
   const size_t size_watches = SIZE_WATCHES (*watches);
 
@@ -200,6 +211,9 @@ static inline bool forward_literal (kissat *solver, unsigned lit,
 
   uint64_t steps = 1 + kissat_cache_lines (size_watches, sizeof (watch));
   uint64_t checks = 0;
+#ifdef METRICS
+  uint64_t filtered = 0;
+#endif
 
   const value *const values = solver->values;
   const value *const marks = solver->marks;
@@ -239,6 +253,13 @@ static inline bool forward_literal (kissat *solver, unsigned lit,
         continue;
       }
 
+      if (d->searched & ~signature) {
+#ifdef METRICS
+        filtered++;
+#endif
+        continue;
+      }
+
       checks++;
       subsume = true;
 
@@ -300,12 +321,16 @@ static inline bool forward_literal (kissat *solver, unsigned lit,
 
   ADD (subsumption_checks, checks);
   ADD (forward_checks, checks);
+#ifdef METRICS
+  ADD (forward_filtered, filtered);
+#endif
   ADD (forward_steps, steps);
 
   return subsume;
 }
 
 static inline bool forward_marked_clause (kissat *solver, clause *c,
+                                          unsigned signature,
                                           unsigned *remove) {
   const unsigned limit = GET_OPTION (subsumeocclim);
   const flags *const flags = solver->flags;
@@ -318,10 +343,11 @@ static inline bool forward_marked_clause (kissat *solver, clause *c,
 
     assert (!VALUE (lit));
 
-    if (forward_literal (solver, lit, true, remove, limit))
+    if (forward_literal (solver, lit, true, signature, remove, limit))
       return true;
 
-    if (forward_literal (solver, NOT (lit), false, remove, limit))
+    if (forward_literal (solver, NOT (lit), false, signature, remove,
+                         limit))
       return true;
   }
   return false;
@@ -335,7 +361,7 @@ static bool forward_subsumed_clause (kissat *solver, clause *c,
 
   value *marks = solver->marks;
   const value *const values = solver->values;
-  unsigned non_false = 0, unit = INVALID_LIT;
+  unsigned non_false = 0, unit = INVALID_LIT, signature = 0;
 
   for (all_literals_in_clause (lit, c)) {
     const value value = values[lit];
@@ -348,6 +374,7 @@ static bool forward_subsumed_clause (kissat *solver, clause *c,
       break;
     }
     marks[lit] = 1;
+    signature |= forward_signature (IDX (lit));
     if (non_false++)
       unit ^= lit;
     else
@@ -378,8 +405,12 @@ static bool forward_subsumed_clause (kissat *solver, clause *c,
     return false;
   }
 
+  if (!GET_OPTION (forwardsig))
+    signature = ~0u;
+
   unsigned remove = INVALID_LIT;
-  const bool subsume = forward_marked_clause (solver, c, &remove);
+  const bool subsume =
+      forward_marked_clause (solver, c, signature, &remove);
 
   for (all_literals_in_clause (lit, c))
     marks[lit] = 0;
@@ -504,6 +535,12 @@ static void connect_subsuming (kissat *solver, unsigned occlim, clause *c) {
   if (min_occs > occlim)
     return;
   LOG ("connecting %s with %zu occurrences", LOGLIT (min_lit), min_occs);
+  const value *const values = solver->values;
+  unsigned signature = 0;
+  for (all_literals_in_clause (lit, c))
+    if (!values[lit])
+      signature |= forward_signature (IDX (lit));
+  c->searched = signature;
   const reference ref = kissat_reference_clause (solver, c);
   kissat_connect_literal (solver, min_lit, ref);
 }
@@ -603,6 +640,7 @@ static bool forward_subsume_all_clauses (kissat *solver) {
     assert (kissat_clause_in_arena (solver, c));
     if (c->garbage)
       continue;
+    c->searched = 2;
     if (q < p && !c->subsume)
       continue;
 #ifndef QUIET
@@ -84,3 +84,36 @@ void kissat_reset_alarm (void) {
   handle_alarm = 0;
   (void) signal (SIGALRM, SIGALRM_handler);
 }
+
+#ifndef __MINGW32__
+
+// Unlike the other signals 'SIGUSR1' does not stop the solver but only
+// requests a checkpoint (see 'snapshot.h').
+
+static volatile bool checkpoint_handler_set;
+static void (*volatile SIGUSR1_handler) (int);
+static void (*volatile handle_checkpoint) (void);
+
+static void catch_checkpoint (int sig) {
+  assert (sig == SIGUSR1);
+  (void) sig;
+  if (checkpoint_handler_set)
+    handle_checkpoint ();
+}
+
+void kissat_init_checkpoint_signal (void (*handler) (void)) {
+  assert (handler);
+  assert (!checkpoint_handler_set);
+  handle_checkpoint = handler;
+  checkpoint_handler_set = true;
+  SIGUSR1_handler = signal (SIGUSR1, catch_checkpoint);
+}
+
+void kissat_reset_checkpoint_signal (void) {
+  assert (checkpoint_handler_set);
+  checkpoint_handler_set = false;
+  handle_checkpoint = 0;
+  (void) signal (SIGUSR1, SIGUSR1_handler);
+}
+
+#endif
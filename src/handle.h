@@ -9,6 +9,11 @@ void kissat_reset_signal_handler (void);
 void kissat_init_alarm (void (*handler) (void));
 void kissat_reset_alarm (void);
 
+#ifndef __MINGW32__
+void kissat_init_checkpoint_signal (void (*handler) (void));
+void kissat_reset_checkpoint_signal (void);
+#endif
+
 #ifdef __MINGW32__
 #define SIGNAL_SIGBUS
 #else
@@ -0,0 +1,68 @@
+#include "implications.h"
+#include "allocate.h"
+#include "inlinevector.h"
+#include "logging.h"
+
+void kissat_build_implications (kissat *solver,
+                                implications *implications) {
+  assert (solver->watching);
+  const unsigned lits = LITS;
+  size_t *offsets = kissat_nalloc (solver, lits + 1, sizeof (size_t));
+  size_t size = 0;
+  watches *all_watches = solver->watches;
+  for (all_literals (lit)) {
+    offsets[lit] = size;
+    for (all_binary_blocking_watches (watch, all_watches[lit]))
+      if (watch.type.binary)
+        size++;
+  }
+  offsets[lits] = size;
+  unsigned *targets = kissat_nalloc (solver, size, sizeof (unsigned));
+  unsigned *q = targets;
+  for (all_literals (lit)) {
+    assert (q == targets + offsets[lit]);
+    for (all_binary_blocking_watches (watch, all_watches[lit]))
+      if (watch.type.binary)
+        *q++ = watch.binary.lit;
+  }
+  assert (q == targets + size);
+  implications->offsets = offsets;
+  implications->targets = targets;
+  implications->size = size;
+  LOG ("built binary implication graph with %zu edges", size);
+  ADD (implications_edges, size);
+  INC (implications_built);
+}
+
+static void remove_edge (implications *implications, unsigned lit,
+                         unsigned other) {
+  unsigned *p = BEGIN_IMPLICATIONS (implications, lit);
+  const unsigned *const end = END_IMPLICATIONS (implications, lit);
+  while (assert (p != end), *p != other)
+    p++;
+  *p = INVALID_LIT;
+#ifdef NDEBUG
+  (void) end;
+#endif
+}
+
+void kissat_remove_implication (kissat *solver, implications *implications,
+                                unsigned lit, unsigned other) {
+  LOGBINARY (lit, other, "removing implication graph edges of");
+#ifndef LOGGING
+  (void) solver;
+#endif
+  remove_edge (implications, lit, other);
+  remove_edge (implications, other, lit);
+}
+
+void kissat_release_implications (kissat *solver,
+                                  implications *implications) {
+  const unsigned lits = LITS;
+  kissat_dealloc (solver, implications->offsets, lits + 1, sizeof (size_t));
+  kissat_dealloc (solver, implications->targets, implications->size,
+                  sizeof (unsigned));
+  implications->offsets = 0;
+  implications->targets = 0;
+  implications->size = 0;
+}
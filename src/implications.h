@@ -0,0 +1,33 @@
+#ifndef _implications_h_INCLUDED
+#define _implications_h_INCLUDED
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// Compressed sparse row representation of the binary implication graph.
+// The row of a literal 'lit' contains all literals 'other' of binary
+// clauses 'lit | other', i.e., exactly the binary watches of 'lit', but
+// without large clause watches interleaved, in one contiguous array.
+// Propagating a true literal 'lit' thus needs to traverse the row of
+// 'NOT (lit)'.  The graph is a snapshot taken at the start of a pass.
+// Removed binary clauses are patched by invalidating their two edges.
+
+typedef struct implications implications;
+
+struct implications {
+  size_t *offsets;
+  unsigned *targets;
+  size_t size;
+};
+
+#define BEGIN_IMPLICATIONS(G, LIT) ((G)->targets + (G)->offsets[LIT])
+#define END_IMPLICATIONS(G, LIT) ((G)->targets + (G)->offsets[(LIT) + 1])
+
+struct kissat;
+
+void kissat_build_implications (struct kissat *, implications *);
+void kissat_remove_implication (struct kissat *, implications *,
+                                unsigned lit, unsigned other);
+void kissat_release_implications (struct kissat *, implications *);
+
+#endif
@@ -10,6 +10,7 @@ static void adjust_imports_for_external_literal (kissat *solver,
     import.extension = false;
     import.imported = false;
     import.eliminated = false;
+    import.observed = false;
     PUSH_STACK (solver->import, import);
   }
 }
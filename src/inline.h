@@ -42,6 +42,7 @@ static inline void kissat_mark_removed_literal (kissat *solver,
   flags *flags = FLAGS (idx);
   if (flags->fixed)
     return;
+  flags->congruence = true;
   if (!flags->eliminate) {
     LOG ("marking %s to be eliminated", LOGVAR (idx));
     flags->eliminate = true;
@@ -53,6 +54,7 @@ static inline void kissat_mark_added_literal (kissat *solver,
                                               unsigned lit) {
   const unsigned idx = IDX (lit);
   flags *flags = FLAGS (idx);
+  flags->congruence = true;
   if (!flags->subsume) {
     LOG ("marking %s to forward subsume", LOGVAR (idx));
     flags->subsume = true;
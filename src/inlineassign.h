@@ -60,13 +60,17 @@ static inline void kissat_assign (kissat *solver, const bool probing,
 
   struct assigned b;
 
+#ifndef SPLIT_ASSIGNED
   b.level = level;
   b.trail = trail;
+#endif
 
   b.analyzed = false;
   b.binary = binary;
   b.poisoned = false;
+#ifndef SPLIT_ASSIGNED
   b.reason = reason;
+#endif
   b.removable = false;
   b.shrinkable = false;
 
@@ -75,6 +79,12 @@ static inline void kissat_assign (kissat *solver, const bool probing,
 #endif
   struct assigned *a = assigned + idx;
   *a = b;
+
+#ifdef SPLIT_ASSIGNED
+  ASSIGNED_LEVEL (assigned, idx) = level;
+  ASSIGNED_TRAIL (assigned, idx) = trail;
+  ASSIGNED_REASON (assigned, idx) = reason;
+#endif
 }
 
 static inline unsigned
@@ -86,8 +96,7 @@ kissat_assignment_level (kissat *solver, value *values, assigned *assigned,
       continue;
     assert (values[other] < 0), (void) values;
     const unsigned other_idx = IDX (other);
-    struct assigned *a = assigned + other_idx;
-    const unsigned level = a->level;
+    const unsigned level = ASSIGNED_LEVEL (assigned, other_idx);
     if (res < level)
       res = level;
   }
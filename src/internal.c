@@ -4,6 +4,8 @@
 #include "import.h"
 #include "inline.h"
 #include "inlineframes.h"
+#include "inlineheap.h"
+#include "inlinequeue.h"
 #include "print.h"
 #include "propsearch.h"
 #include "require.h"
@@ -42,6 +44,7 @@ kissat *kissat_init (void) {
   solver->first_reducible = INVALID_REF;
   solver->last_irredundant = INVALID_REF;
   kissat_reset_last_learned (solver);
+  kissat_init_payoffs (solver);
 #ifndef NDEBUG
   kissat_init_checker (solver);
 #endif
@@ -85,8 +88,15 @@ void kissat_release (kissat *solver) {
 
   RELEASE_STACK (solver->export);
   RELEASE_STACK (solver->import);
+  RELEASE_STACK (solver->sharing.exported);
+  RELEASE_STACK (solver->propagator.model);
 
   DEALLOC_VARIABLE_INDEXED (assigned);
+#ifdef SPLIT_ASSIGNED
+  DEALLOC_VARIABLE_INDEXED (assigned_levels);
+  DEALLOC_VARIABLE_INDEXED (assigned_positions);
+  DEALLOC_VARIABLE_INDEXED (assigned_reasons);
+#endif
   DEALLOC_VARIABLE_INDEXED (flags);
   DEALLOC_VARIABLE_INDEXED (links);
 
@@ -97,10 +107,13 @@ void kissat_release (kissat *solver) {
   RELEASE_STACK (solver->import);
   RELEASE_STACK (solver->eliminated);
   RELEASE_STACK (solver->extend);
+  RELEASE_STACK (solver->compressed);
+  RELEASE_STACK (solver->decompressed);
   RELEASE_STACK (solver->witness);
   RELEASE_STACK (solver->etrail);
 
   RELEASE_STACK (solver->delayed);
+  kissat_release_duplicates (solver);
 
   RELEASE_STACK (solver->clause);
   RELEASE_STACK (solver->shadow);
@@ -127,6 +140,8 @@ void kissat_release (kissat *solver) {
   RELEASE_STACK (solver->xorted[1]);
 
   RELEASE_STACK (solver->sweep_schedule);
+  RELEASE_STACK (solver->closure);
+  RELEASE_STACK (solver->backbones);
 
   RELEASE_STACK (solver->ranks);
 
@@ -263,212 +278,321 @@ void kissat_print_statistics (kissat *solver) {
   (void) solver;
 }
 
-void kissat_add (kissat *solver, int elit) {
-  kissat_require_initialized (solver);
-  kissat_require (!GET (searches), "incremental solving not supported");
+// Order dependent hash of all added original literals including the
+// terminating zeros, which is used to match cache files (see 'cache.h')
+// and snapshots (see 'snapshot.h').
+
+static inline void hash_original_literal (kissat *solver, int elit) {
+  const uint64_t mixed = solver->original_hash ^ (unsigned) elit;
+  solver->original_hash = 0x9e3779b97f4a7c15ull * mixed + 1;
+}
+
+static void add_literal (kissat *solver, int elit) {
+  hash_original_literal (solver, elit);
 #if !defined(NDEBUG) || !defined(NPROOFS) || defined(LOGGING)
   const int checking = kissat_checking (solver);
   const bool logging = kissat_logging (solver);
   const bool proving = kissat_proving (solver);
+  if (checking || logging || proving)
+    PUSH_STACK (solver->original, elit);
 #endif
-  if (elit) {
-    kissat_require_valid_external_internal (elit);
-#if !defined(NDEBUG) || !defined(NPROOFS) || defined(LOGGING)
-    if (checking || logging || proving)
-      PUSH_STACK (solver->original, elit);
-#endif
-    unsigned ilit = kissat_import_literal (solver, elit);
-
-    const mark mark = MARK (ilit);
-    if (!mark) {
-      const value value = kissat_fixed (solver, ilit);
-      if (value > 0) {
-        if (!solver->clause_satisfied) {
-          LOG ("adding root level satisfied literal %u(%d)@0=1", ilit,
-               elit);
-          solver->clause_satisfied = true;
-        }
-      } else if (value < 0) {
-        LOG ("adding root level falsified literal %u(%d)@0=-1", ilit, elit);
-        if (!solver->clause_shrink) {
-          solver->clause_shrink = true;
-          LOG ("thus original clause needs shrinking");
-        }
-      } else {
-        MARK (ilit) = 1;
-        MARK (NOT (ilit)) = -1;
-        assert (SIZE_STACK (solver->clause) < UINT_MAX);
-        PUSH_STACK (solver->clause, ilit);
-      }
-    } else if (mark < 0) {
-      assert (mark < 0);
-      if (!solver->clause_trivial) {
-        LOG ("adding dual literal %u(%d) and %u(%d)", NOT (ilit), -elit,
-             ilit, elit);
-        solver->clause_trivial = true;
+  unsigned ilit = kissat_import_literal (solver, elit);
+
+  const mark mark = MARK (ilit);
+  if (!mark) {
+    const value value = kissat_fixed (solver, ilit);
+    if (value > 0) {
+      if (!solver->clause_satisfied) {
+        LOG ("adding root level satisfied literal %u(%d)@0=1", ilit,
+             elit);
+        solver->clause_satisfied = true;
       }
-    } else {
-      assert (mark > 0);
-      LOG ("adding duplicated literal %u(%d)", ilit, elit);
+    } else if (value < 0) {
+      LOG ("adding root level falsified literal %u(%d)@0=-1", ilit, elit);
       if (!solver->clause_shrink) {
         solver->clause_shrink = true;
         LOG ("thus original clause needs shrinking");
       }
+    } else {
+      MARK (ilit) = 1;
+      MARK (NOT (ilit)) = -1;
+      assert (SIZE_STACK (solver->clause) < UINT_MAX);
+      PUSH_STACK (solver->clause, ilit);
+    }
+  } else if (mark < 0) {
+    assert (mark < 0);
+    if (!solver->clause_trivial) {
+      LOG ("adding dual literal %u(%d) and %u(%d)", NOT (ilit), -elit,
+           ilit, elit);
+      solver->clause_trivial = true;
     }
   } else {
+    assert (mark > 0);
+    LOG ("adding duplicated literal %u(%d)", ilit, elit);
+    if (!solver->clause_shrink) {
+      solver->clause_shrink = true;
+      LOG ("thus original clause needs shrinking");
+    }
+  }
+}
+
+static void add_clause (kissat *solver) {
+  hash_original_literal (solver, 0);
 #if !defined(NDEBUG) || !defined(NPROOFS) || defined(LOGGING)
-    const size_t offset = solver->offset_of_last_original_clause;
-    size_t esize = SIZE_STACK (solver->original) - offset;
-    int *elits = BEGIN_STACK (solver->original) + offset;
-    assert (esize <= UINT_MAX);
+  const int checking = kissat_checking (solver);
+  const bool logging = kissat_logging (solver);
+  const bool proving = kissat_proving (solver);
 #endif
-    ADD_UNCHECKED_EXTERNAL (esize, elits);
-    const size_t isize = SIZE_STACK (solver->clause);
-    unsigned *ilits = BEGIN_STACK (solver->clause);
-    assert (isize < (unsigned) INT_MAX);
-
-    if (solver->inconsistent)
-      LOG ("inconsistent thus skipping original clause");
-    else if (solver->clause_satisfied)
-      LOG ("skipping satisfied original clause");
-    else if (solver->clause_trivial)
-      LOG ("skipping trivial original clause");
-    else {
-      kissat_activate_literals (solver, isize, ilits);
-
-      if (!isize) {
-        if (solver->clause_shrink)
-          LOG ("all original clause literals root level falsified");
-        else
-          LOG ("found empty original clause");
-
-        if (!solver->inconsistent) {
-          LOG ("thus solver becomes inconsistent");
-          solver->inconsistent = true;
-          CHECK_AND_ADD_EMPTY ();
-          ADD_EMPTY_TO_PROOF ();
-        }
-      } else if (isize == 1) {
-        unsigned unit = TOP_STACK (solver->clause);
+#if !defined(NDEBUG) || !defined(NPROOFS) || defined(LOGGING)
+  const size_t offset = solver->offset_of_last_original_clause;
+  size_t esize = SIZE_STACK (solver->original) - offset;
+  int *elits = BEGIN_STACK (solver->original) + offset;
+  assert (esize <= UINT_MAX);
+#endif
+  ADD_UNCHECKED_EXTERNAL (esize, elits);
+  const size_t isize = SIZE_STACK (solver->clause);
+  unsigned *ilits = BEGIN_STACK (solver->clause);
+  assert (isize < (unsigned) INT_MAX);
+  unsigned hash = 0;
+
+  if (solver->inconsistent)
+    LOG ("inconsistent thus skipping original clause");
+  else if (solver->clause_satisfied)
+    LOG ("skipping satisfied original clause");
+  else if (solver->clause_trivial)
+    LOG ("skipping trivial original clause");
+  else if (isize > 2 &&
+           kissat_duplicated_original (solver, isize, ilits, &hash)) {
+    LOG ("skipping duplicated original clause");
+    solver->clause_duplicated = true;
+  } else {
+    kissat_activate_literals (solver, isize, ilits);
+
+    if (!isize) {
+      if (solver->clause_shrink)
+        LOG ("all original clause literals root level falsified");
+      else
+        LOG ("found empty original clause");
+
+      if (!solver->inconsistent) {
+        LOG ("thus solver becomes inconsistent");
+        solver->inconsistent = true;
+        CHECK_AND_ADD_EMPTY ();
+        ADD_EMPTY_TO_PROOF ();
+      }
+    } else if (isize == 1) {
+      unsigned unit = TOP_STACK (solver->clause);
 
-        if (solver->clause_shrink)
-          LOGUNARY (unit, "original clause shrinks to");
-        else
-          LOGUNARY (unit, "found original");
+      if (solver->clause_shrink)
+        LOGUNARY (unit, "original clause shrinks to");
+      else
+        LOGUNARY (unit, "found original");
 
-        kissat_original_unit (solver, unit);
+      kissat_original_unit (solver, unit);
 
-        COVER (solver->level);
-        if (!solver->level)
-          (void) kissat_search_propagate (solver);
+      COVER (solver->level);
+      if (!solver->level)
+        (void) kissat_search_propagate (solver);
+    } else {
+      reference res = kissat_new_original_clause (solver);
+      if (isize > 2 && GET_OPTION (deduplicate))
+        kissat_hash_original (solver, hash, res);
+
+      const unsigned a = ilits[0];
+      const unsigned b = ilits[1];
+
+      const value u = VALUE (a);
+      const value v = VALUE (b);
+
+      const unsigned k = u ? LEVEL (a) : UINT_MAX;
+      const unsigned l = v ? LEVEL (b) : UINT_MAX;
+
+      bool assign = false;
+
+      if (!u && v < 0) {
+        LOG ("original clause immediately forcing");
+        assign = true;
+      } else if (u < 0 && k == l) {
+        LOG ("both watches falsified at level @%u", k);
+        assert (v < 0);
+        assert (k > 0);
+        kissat_backtrack_without_updating_phases (solver, k - 1);
+      } else if (u < 0) {
+        LOG ("watches falsified at levels @%u and @%u", k, l);
+        assert (v < 0);
+        assert (k > l);
+        assert (l > 0);
+        assign = true;
+      } else if (u > 0 && v < 0) {
+        LOG ("first watch satisfied at level @%u "
+             "second falsified at level @%u",
+             k, l);
+        assert (k <= l);
+      } else if (!u && v > 0) {
+        LOG ("first watch unassigned "
+             "second falsified at level @%u",
+             l);
+        assign = true;
       } else {
-        reference res = kissat_new_original_clause (solver);
-
-        const unsigned a = ilits[0];
-        const unsigned b = ilits[1];
-
-        const value u = VALUE (a);
-        const value v = VALUE (b);
-
-        const unsigned k = u ? LEVEL (a) : UINT_MAX;
-        const unsigned l = v ? LEVEL (b) : UINT_MAX;
-
-        bool assign = false;
-
-        if (!u && v < 0) {
-          LOG ("original clause immediately forcing");
-          assign = true;
-        } else if (u < 0 && k == l) {
-          LOG ("both watches falsified at level @%u", k);
-          assert (v < 0);
-          assert (k > 0);
-          kissat_backtrack_without_updating_phases (solver, k - 1);
-        } else if (u < 0) {
-          LOG ("watches falsified at levels @%u and @%u", k, l);
-          assert (v < 0);
-          assert (k > l);
-          assert (l > 0);
-          assign = true;
-        } else if (u > 0 && v < 0) {
-          LOG ("first watch satisfied at level @%u "
-               "second falsified at level @%u",
-               k, l);
-          assert (k <= l);
-        } else if (!u && v > 0) {
-          LOG ("first watch unassigned "
-               "second falsified at level @%u",
-               l);
-          assign = true;
-        } else {
-          assert (!u);
-          assert (!v);
-        }
+        assert (!u);
+        assert (!v);
+      }
 
-        if (assign) {
-          assert (solver->level > 0);
-
-          if (isize == 2) {
-            assert (res == INVALID_REF);
-            kissat_assign_binary (solver, a, b);
-          } else {
-            assert (res != INVALID_REF);
-            clause *c = kissat_dereference_clause (solver, res);
-            kissat_assign_reference (solver, a, res, c);
-          }
+      if (assign) {
+        assert (solver->level > 0);
+
+        if (isize == 2) {
+          assert (res == INVALID_REF);
+          kissat_assign_binary (solver, a, b);
+        } else {
+          assert (res != INVALID_REF);
+          clause *c = kissat_dereference_clause (solver, res);
+          kissat_assign_reference (solver, a, res, c);
         }
       }
     }
+  }
 
 #if !defined(NDEBUG) || !defined(NPROOFS)
-    if (solver->clause_satisfied || solver->clause_trivial) {
+  if (solver->clause_satisfied || solver->clause_trivial ||
+      solver->clause_duplicated) {
 #ifndef NDEBUG
-      if (checking > 1)
-        kissat_remove_checker_external (solver, esize, elits);
+    if (checking > 1)
+      kissat_remove_checker_external (solver, esize, elits);
 #endif
 #ifndef NPROOFS
-      if (proving) {
-        if (esize == 1)
-          LOG ("skipping deleting unit from proof");
-        else
-          kissat_delete_external_from_proof (solver, esize, elits);
-      }
+    if (proving) {
+      if (esize == 1)
+        LOG ("skipping deleting unit from proof");
+      else
+        kissat_delete_external_from_proof (solver, esize, elits);
+    }
 #endif
-    } else if (!solver->inconsistent && solver->clause_shrink) {
+  } else if (!solver->inconsistent && solver->clause_shrink) {
 #ifndef NDEBUG
-      if (checking > 1) {
-        kissat_check_and_add_internal (solver, isize, ilits);
-        kissat_remove_checker_external (solver, esize, elits);
-      }
+    if (checking > 1) {
+      kissat_check_and_add_internal (solver, isize, ilits);
+      kissat_remove_checker_external (solver, esize, elits);
+    }
 #endif
 #ifndef NPROOFS
-      if (proving) {
-        kissat_add_lits_to_proof (solver, isize, ilits);
-        kissat_delete_external_from_proof (solver, esize, elits);
-      }
-#endif
+    if (proving) {
+      kissat_add_lits_to_proof (solver, isize, ilits);
+      kissat_delete_external_from_proof (solver, esize, elits);
     }
 #endif
+  }
+#endif
 
 #if !defined(NDEBUG) || !defined(NPROOFS) || defined(LOGGING)
-    if (checking) {
-      LOGINTS (esize, elits, "saved original");
-      PUSH_STACK (solver->original, 0);
-      solver->offset_of_last_original_clause =
-          SIZE_STACK (solver->original);
-    } else if (logging || proving) {
-      LOGINTS (esize, elits, "reset original");
-      CLEAR_STACK (solver->original);
-      solver->offset_of_last_original_clause = 0;
-    }
+  if (checking) {
+    LOGINTS (esize, elits, "saved original");
+    PUSH_STACK (solver->original, 0);
+    solver->offset_of_last_original_clause =
+        SIZE_STACK (solver->original);
+  } else if (logging || proving) {
+    LOGINTS (esize, elits, "reset original");
+    CLEAR_STACK (solver->original);
+    solver->offset_of_last_original_clause = 0;
+  }
 #endif
-    for (all_stack (unsigned, lit, solver->clause))
-      MARK (lit) = MARK (NOT (lit)) = 0;
+  for (all_stack (unsigned, lit, solver->clause))
+    MARK (lit) = MARK (NOT (lit)) = 0;
 
-    CLEAR_STACK (solver->clause);
+  CLEAR_STACK (solver->clause);
+
+  solver->clause_duplicated = false;
+  solver->clause_satisfied = false;
+  solver->clause_trivial = false;
+  solver->clause_shrink = false;
+}
+
+void kissat_add (kissat *solver, int elit) {
+  kissat_require_initialized (solver);
+  kissat_require (!GET (searches), "incremental solving not supported");
+  if (elit) {
+    kissat_require_valid_external_internal (elit);
+    add_literal (solver, elit);
+  } else
+    add_clause (solver);
+}
+
+// Adding clauses in bulk checks API usage only once per batch.  Before
+// adding the clauses all literals are validated, the maximum variable is
+// used to resize the solver once and the arena is enlarged to hold all
+// (non-binary) clauses, which avoids repeated resizing for large batches.
+
+static void require_no_pending_clause (kissat *solver) {
+  kissat_require (EMPTY_STACK (solver->clause) &&
+                      !solver->clause_satisfied &&
+                      !solver->clause_shrink && !solver->clause_trivial,
+                  "incomplete clause (terminating zero not added)");
+}
+
+static void reserve_clauses (kissat *solver, int max_var, size_t wards) {
+  assert (max_var <= EXTERNAL_MAX_VAR);
+  if ((unsigned) max_var > solver->size)
+    kissat_increase_size (solver, (unsigned) max_var);
+  if (wards)
+    kissat_reserve_arena (solver, wards);
+}
+
+static size_t clause_wards (size_t size) {
+  if (size <= 2)
+    return 0;
+  assert (size <= UINT_MAX);
+  return kissat_bytes_of_clause ((unsigned) size) / sizeof (ward);
+}
 
-    solver->clause_satisfied = false;
-    solver->clause_trivial = false;
-    solver->clause_shrink = false;
+void kissat_add_clause (kissat *solver, int size, const int *lits) {
+  kissat_require_initialized (solver);
+  kissat_require (!GET (searches), "incremental solving not supported");
+  kissat_require (0 <= size, "negative clause size '%d'", size);
+  kissat_require (!size || lits, "zero literals pointer");
+  require_no_pending_clause (solver);
+  int max_var = 0;
+  for (int i = 0; i < size; i++) {
+    const int elit = lits[i];
+    kissat_require_valid_external_internal (elit);
+    const int eidx = ABS (elit);
+    if (eidx > max_var)
+      max_var = eidx;
+  }
+  reserve_clauses (solver, max_var, clause_wards (size));
+  for (int i = 0; i < size; i++)
+    add_literal (solver, lits[i]);
+  add_clause (solver);
+}
+
+void kissat_add_clauses (kissat *solver, size_t size, const int *lits) {
+  kissat_require_initialized (solver);
+  kissat_require (!GET (searches), "incremental solving not supported");
+  kissat_require (!size || lits, "zero literals pointer");
+  kissat_require (!size || !lits[size - 1],
+                  "last clause not terminated by zero");
+  require_no_pending_clause (solver);
+  size_t wards = 0, clause_size = 0;
+  int max_var = 0;
+  for (const int *p = lits, *end = lits + size; p != end; p++) {
+    const int elit = *p;
+    if (elit) {
+      kissat_require_valid_external_internal (elit);
+      const int eidx = ABS (elit);
+      if (eidx > max_var)
+        max_var = eidx;
+      clause_size++;
+    } else {
+      wards += clause_wards (clause_size);
+      clause_size = 0;
+    }
+  }
+  reserve_clauses (solver, max_var, wards);
+  for (const int *p = lits, *end = lits + size; p != end; p++) {
+    const int elit = *p;
+    if (elit)
+      add_literal (solver, elit);
+    else
+      add_clause (solver);
   }
 }
 
@@ -476,7 +600,9 @@ int kissat_solve (kissat *solver) {
   kissat_require_initialized (solver);
   kissat_require (EMPTY_STACK (solver->clause),
                   "incomplete clause (terminating zero not added)");
-  kissat_require (!GET (searches), "incremental solving not supported");
+  kissat_require (!GET (searches) || solver->resumed,
+                  "incremental solving not supported");
+  kissat_release_duplicates (solver);
   return kissat_search (solver);
 }
 
@@ -493,6 +619,138 @@ void kissat_set_terminate (kissat *solver, void *state,
   solver->termination.terminate = terminate;
 }
 
+void kissat_set_cache_flush (kissat *solver, void *state,
+                             void (*flush) (void *state)) {
+  kissat_require_initialized (solver);
+  solver->flusher.state = state;
+  solver->flusher.flush = flush;
+  solver->limits.flush.conflicts = CONFLICTS + GET_OPTION (cacheint);
+}
+
+void kissat_set_checkpoint (kissat *solver, void *state,
+                            void (*write) (void *state)) {
+  kissat_require_initialized (solver);
+  solver->checkpoint.state = state;
+  solver->checkpoint.write = write;
+  const uint64_t delta = 1e6 * GET_OPTION (checkpointint);
+  solver->limits.checkpoint.ticks = solver->statistics.search_ticks + delta;
+}
+
+void kissat_request_checkpoint (kissat *solver) {
+  kissat_require_initialized (solver);
+  solver->checkpoint.requested = true;
+}
+
+void kissat_set_export (kissat *solver, void *state, int max_size,
+                        int max_glue,
+                        void (*export) (void *state, const int *clause)) {
+  kissat_require_initialized (solver);
+  kissat_require (0 <= max_size, "negative maximum size '%d'", max_size);
+  kissat_require (0 <= max_glue, "negative maximum glue '%d'", max_glue);
+  sharing *sharing = &solver->sharing;
+  sharing->export_state = state;
+  sharing->export = export;
+  sharing->max_size = max_size;
+  sharing->max_glue = max_glue;
+}
+
+void kissat_set_import (kissat *solver, void *state,
+                        const int *(*import) (void *state)) {
+  kissat_require_initialized (solver);
+  sharing *sharing = &solver->sharing;
+  sharing->import_state = state;
+  sharing->import = import;
+}
+
+void kissat_connect_propagator (kissat *solver,
+                                const kissat_propagator *callbacks) {
+  kissat_require_initialized (solver);
+  kissat_require (callbacks, "zero propagator");
+  kissat_require (!GET (searches), "incremental solving not supported");
+  kissat_require (!solver->propagator.connected,
+                  "propagator already connected");
+  propagator *propagator = &solver->propagator;
+  propagator->connected = true;
+  propagator->callbacks = *callbacks;
+}
+
+void kissat_observe (kissat *solver, int var) {
+  kissat_require_initialized (solver);
+  kissat_require (!GET (searches), "incremental solving not supported");
+  kissat_require (0 < var, "invalid variable argument '%d'", var);
+  kissat_require (var <= EXTERNAL_MAX_VAR,
+                  "invalid variable argument '%d'", var);
+  const unsigned ilit = kissat_import_literal (solver, var);
+  assert (VALID_INTERNAL_LITERAL (ilit));
+  kissat_activate_literal (solver, ilit);
+  PEEK_STACK (solver->import, (unsigned) var).observed = true;
+}
+
+// Hinted variables are imported and activated (unless already fixed at
+// the root-level) since 'activate_literal' expects cleared phases and
+// otherwise would not enqueue them.
+
+static unsigned import_hinted_literal (kissat *solver, int elit) {
+  const unsigned ilit = kissat_import_literal (solver, elit);
+  assert (VALID_INTERNAL_LITERAL (ilit));
+  const unsigned idx = IDX (ilit);
+  if (FLAGS (idx)->fixed)
+    return INVALID_LIT;
+  kissat_activate_literal (solver, ilit);
+  return ilit;
+}
+
+void kissat_set_phase (kissat *solver, int lit) {
+  kissat_require_initialized (solver);
+  kissat_require (!GET (searches), "incremental solving not supported");
+  kissat_require (lit, "invalid zero literal argument");
+  kissat_require_valid_external_internal (lit);
+  const unsigned ilit = import_hinted_literal (solver, lit);
+  if (ilit == INVALID_LIT)
+    return;
+  const unsigned idx = IDX (ilit);
+  const value phase = NEGATED (ilit) ? -1 : 1;
+  LOG ("setting initial phase of %s to %d", LOGVAR (idx), (int) phase);
+  SAVED (idx) = TARGET (idx) = phase;
+}
+
+void kissat_set_priority (kissat *solver, int var) {
+  kissat_require_initialized (solver);
+  kissat_require (!GET (searches), "incremental solving not supported");
+  kissat_require (0 < var, "invalid variable argument '%d'", var);
+  kissat_require (var <= EXTERNAL_MAX_VAR,
+                  "invalid variable argument '%d'", var);
+  const unsigned ilit = import_hinted_literal (solver, var);
+  if (ilit == INVALID_LIT)
+    return;
+  const unsigned idx = IDX (ilit);
+  LOG ("prioritizing %s", LOGVAR (idx));
+  kissat_move_to_front (solver, idx);
+  const double score = kissat_max_score_on_heap (SCORES) + 1.0;
+  kissat_update_heap (solver, SCORES, idx, score);
+}
+
+void kissat_extend_model (kissat *solver) {
+  if (!solver->extended && !EMPTY_STACK (solver->extend))
+    kissat_extend (solver);
+}
+
+int kissat_extended_value (kissat *solver, unsigned eidx) {
+  assert (!EMPTY_STACK (solver->extend) <= solver->extended);
+  if (eidx >= SIZE_STACK (solver->import))
+    return 0;
+  const import *const import = &PEEK_STACK (solver->import, eidx);
+  if (!import->imported)
+    return 0;
+  const unsigned ilit = import->lit;
+  value tmp;
+  if (import->eliminated)
+    tmp = PEEK_STACK (solver->eliminated, ilit);
+  else
+    tmp = VALUE (ilit);
+  return tmp;
+}
+
 int kissat_value (kissat *solver, int elit) {
   kissat_require_initialized (solver);
   kissat_require_valid_external_internal (elit);
@@ -504,8 +762,7 @@ int kissat_value (kissat *solver, int elit) {
     return 0;
   value tmp;
   if (import->eliminated) {
-    if (!solver->extended && !EMPTY_STACK (solver->extend))
-      kissat_extend (solver);
+    kissat_extend_model (solver);
     const unsigned eliminated = import->lit;
     tmp = PEEK_STACK (solver->eliminated, eliminated);
   } else {
@@ -518,3 +775,34 @@ int kissat_value (kissat *solver, int elit) {
     tmp = -tmp;
   return tmp < 0 ? -elit : elit;
 }
+
+void kissat_values (kissat *solver, int size, const int *lits,
+                    int *values) {
+  kissat_require_initialized (solver);
+  kissat_require (size >= 0, "negative size '%d'", size);
+  kissat_require (!size || lits, "zero literals pointer");
+  kissat_require (!size || values, "zero values pointer");
+  for (int i = 0; i < size; i++)
+    kissat_require_valid_external_internal (lits[i]);
+  kissat_extend_model (solver);
+  for (int i = 0; i < size; i++) {
+    const int elit = lits[i];
+    int tmp = kissat_extended_value (solver, ABS (elit));
+    if (elit < 0)
+      tmp = -tmp;
+    values[i] = !tmp ? 0 : tmp < 0 ? -elit : elit;
+  }
+}
+
+void kissat_model (kissat *solver, int max_var, int *values) {
+  kissat_require_initialized (solver);
+  kissat_require (0 <= max_var && max_var <= EXTERNAL_MAX_VAR,
+                  "invalid maximum variable '%d'", max_var);
+  kissat_require (values, "zero values pointer");
+  kissat_extend_model (solver);
+  values[0] = 0;
+  for (int eidx = 1; eidx <= max_var; eidx++) {
+    const int tmp = kissat_extended_value (solver, eidx);
+    values[eidx] = tmp < 0 ? -eidx : tmp > 0 ? eidx : 0;
+  }
+}
@@ -5,10 +5,13 @@
 #include "array.h"
 #include "assign.h"
 #include "averages.h"
+#include "bandit.h"
+#include "cache.h"
 #include "check.h"
 #include "classify.h"
 #include "clause.h"
 #include "cover.h"
+#include "duplicates.h"
 #include "extend.h"
 #include "flags.h"
 #include "format.h"
@@ -19,14 +22,18 @@
 #include "literal.h"
 #include "mode.h"
 #include "options.h"
+#include "payoff.h"
 #include "phases.h"
 #include "profile.h"
 #include "proof.h"
+#include "propagator.h"
 #include "queue.h"
 #include "random.h"
 #include "reluctant.h"
 #include "rephase.h"
+#include "share.h"
 #include "smooth.h"
+#include "snapshot.h"
 #include "stack.h"
 #include "statistics.h"
 #include "value.h"
@@ -47,6 +54,7 @@ struct import {
   bool extension;
   bool imported;
   bool eliminated;
+  bool observed;
 };
 
 typedef struct termination termination;
@@ -85,6 +93,7 @@ struct kissat {
   bool iterating;
   bool preprocessing;
   bool probing;
+  bool resumed;
 #ifndef QUIET
   bool sectioned;
 #endif
@@ -96,8 +105,6 @@ struct kissat {
   bool warming;
   bool watching;
 
-  bool large_clauses_watched_after_binary_clauses;
-
   termination termination;
 
   unsigned vars;
@@ -109,9 +116,16 @@ struct kissat {
   ints units;
   imports import;
   extensions extend;
+  compressed compressed;
+  unsigneds decompressed;
   unsigneds witness;
 
   assigned *assigned;
+#ifdef SPLIT_ASSIGNED
+  unsigned *assigned_levels;
+  unsigned *assigned_positions;
+  unsigned *assigned_reasons;
+#endif
   flags *flags;
 
   mark *marks;
@@ -162,11 +176,14 @@ struct kissat {
 
   clause conflict;
 
+  bool clause_duplicated;
   bool clause_satisfied;
   bool clause_shrink;
   bool clause_trivial;
+  uint64_t original_hash;
 
   unsigneds clause;
+  duplicates duplicates;
   unsigneds shadow;
 
   arena arena;
@@ -184,13 +201,19 @@ struct kissat {
   unsigned tier1[2], tier2[2];
   reluctant reluctant;
 
+  bandit bandit;
   bounds bounds;
+  checkpoint checkpoint;
+  flusher flusher;
   classification classification;
   delays delays;
   enabled enabled;
   limited limited;
   limits limits;
+  payoffs payoffs;
+  propagator propagator;
   remember last;
+  sharing sharing;
   unsigned walked;
 
   mode mode;
@@ -214,6 +237,9 @@ struct kissat {
 #endif
   bool sweep_incomplete;
   unsigneds sweep_schedule;
+  bool closure_imported;
+  unsigneds closure;
+  ints backbones;
 
 #if !defined(NDEBUG) || !defined(NPROOFS)
   unsigneds added;
@@ -292,4 +318,7 @@ static inline unsigned kissat_assigned (kissat *solver) {
 
 void kissat_reset_last_learned (kissat *solver);
 
+void kissat_extend_model (kissat *solver);
+int kissat_extended_value (kissat *solver, unsigned eidx);
+
 #endif
@@ -78,6 +78,8 @@ static void init_enabled (kissat *solver) {
     eliminate = false;
   else if (!GET_OPTION (eliminate))
     eliminate = false;
+  else if (solver->propagator.connected)
+    eliminate = false;
   else
     eliminate = true;
   kissat_very_verbose (solver, "eliminate %sabled",
@@ -43,9 +43,13 @@ struct limits {
     uint64_t marked;
   } factor;
 
+  struct {
+    uint64_t ticks;
+  } checkpoint;
+
   struct {
     uint64_t conflicts;
-  } probe, randec, reduce, reorder, rephase, restart;
+  } flush, probe, randec, reduce, reorder, rephase, restart;
 
   struct {
     uint64_t conflicts;
@@ -132,7 +136,7 @@ double kissat_logn (uint64_t);
 
 #include <inttypes.h>
 
-#define SET_EFFORT_LIMIT(LIMIT, NAME, START) \
+#define SET_SCALED_EFFORT_LIMIT(LIMIT, NAME, START, SCALE) \
   uint64_t LIMIT; \
   do { \
     const uint64_t OLD_LIMIT = solver->statistics.START; \
@@ -152,7 +156,8 @@ double kissat_logn (uint64_t);
           FORMAT_COUNT (REFERENCE), FORMAT_COUNT (TICKS), \
           FORMAT_COUNT (LAST)); \
     } \
-    const double EFFORT = (double) GET_OPTION (NAME##effort) * 1e-3; \
+    const double EFFORT = \
+        (double) GET_OPTION (NAME##effort) * 1e-3 * (SCALE); \
     const uint64_t DELTA = EFFORT * REFERENCE; \
 \
     kissat_extremely_verbose ( \
@@ -169,6 +174,9 @@ double kissat_logn (uint64_t);
 \
   } while (0)
 
+#define SET_EFFORT_LIMIT(LIMIT, NAME, START) \
+  SET_SCALED_EFFORT_LIMIT (LIMIT, NAME, START, 1)
+
 struct kissat;
 
 bool kissat_delaying (struct kissat *, delay *);
@@ -1,6 +1,8 @@
 #ifndef _kissat_h_INCLUDED
 #define _kissat_h_INCLUDED
 
+#include <stddef.h>
+
 typedef struct kissat kissat;
 
 // Default (partial) IPASIR interface.
@@ -15,11 +17,123 @@ void kissat_release (kissat *solver);
 void kissat_set_terminate (kissat *solver, void *state,
                            int (*terminate) (void *state));
 
+// The cache flush callback is called every 'cacheint' conflicts during
+// search in a consistent state (all literals propagated and no conflict),
+// for instance to write phases and learned clauses of long running jobs
+// to a cache file periodically.  Passing a zero callback disables it.
+
+void kissat_set_cache_flush (kissat *solver, void *state,
+                             void (*flush) (void *state));
+
+// The checkpoint callback is called at the root level during search every
+// 'checkpointint' mega ticks, after 'kissat_request_checkpoint' (which
+// can be called from a signal handler) and when search is interrupted by
+// limits or termination, for instance to write a snapshot of the solver
+// state (see 'kissat_write_snapshot' in 'snapshot.h').  Passing a zero
+// callback disables checkpoints.
+
+void kissat_set_checkpoint (kissat *solver, void *state,
+                            void (*checkpoint) (void *state));
+void kissat_request_checkpoint (kissat *solver);
+
+// Clause sharing callbacks (in the spirit of IPASIR-2).  The export
+// callback is called for every derived root-level unit (independent of
+// the limits and how the unit was derived) and every learned clause with
+// at most 'max_size' literals and glue at most 'max_glue' with a
+// zero-terminated array of external literals, which is only valid during
+// the call.  Learned clauses containing variables introduced by the solver
+// are not exported.  The import callback is polled before search and at
+// restarts and should return a zero-terminated array of literals (which
+// has to stay valid until the next call) or a zero pointer if no more
+// clauses are available.  Imported clauses have to be implied by the
+// formula and are added as redundant clauses (which in general breaks
+// proof checking).  Clauses with unknown or eliminated variables are
+// ignored.  Passing a zero callback disables sharing in that direction.
+
+void kissat_set_export (kissat *solver, void *state, int max_size,
+                        int max_glue,
+                        void (*export) (void *state, const int *clause));
+void kissat_set_import (kissat *solver, void *state,
+                        const int *(*import) (void *state));
+
+// External propagator interface (in the spirit of IPASIR-UP).  Only
+// assignments to observed variables are notified together with their
+// decision level.  If assignments on levels above 'new_level' are undone
+// 'notify_backtrack' is called.  Before each decision the solver asks for
+// new clauses through 'add_clause' (which should return a zero-terminated
+// clause or a zero pointer) and literals implied by the propagator through
+// 'propagate' (which should return zero if there are none).  For each such
+// literal 'explain' has to return a zero-terminated reason clause which
+// contains the literal with all other literals being false.  Finally a
+// complete assignment is only accepted if 'check_model' returns non-zero.
+// Otherwise 'add_clause' has to provide at least one clause which is
+// falsified by the model.  Returned clauses have to stay valid until the
+// next call to the same function.  All callbacks except 'state' can be
+// zero.  Connecting a propagator disables simplifications which remove
+// variables.  Thus all variables used by the propagator have to occur in
+// the formula or be observed before calling 'kissat_solve'.
+
+typedef struct kissat_propagator kissat_propagator;
+
+struct kissat_propagator {
+  void *state;
+  void (*notify_assignment) (void *state, int lit, int level);
+  void (*notify_backtrack) (void *state, int new_level);
+  const int *(*add_clause) (void *state);
+  int (*propagate) (void *state);
+  const int *(*explain) (void *state, int lit);
+  int (*check_model) (void *state, int size, const int *model);
+};
+
+void kissat_connect_propagator (kissat *solver,
+                                const kissat_propagator *propagator);
+void kissat_observe (kissat *solver, int var);
+
 // Additional API functions.
 
 void kissat_terminate (kissat *solver);
 void kissat_reserve (kissat *solver, int max_var);
 
+// Add many clauses at once.  The first function adds the single clause
+// 'lits[0..size-1]' (without terminating zero).  The second adds all
+// zero-terminated clauses in the flat buffer 'lits[0..size-1]', which has
+// to end with a zero.  Both are equivalent to calling 'kissat_add' for
+// each literal followed by zero, but check API usage only once and
+// allocate memory for all the clauses up-front.
+
+void kissat_add_clause (kissat *solver, int size, const int *lits);
+void kissat_add_clauses (kissat *solver, size_t size, const int *lits);
+
+// Hints for warm starts which have to be given before 'kissat_solve' and
+// preferably after adding the formula.  The first sets the initial saved
+// and target phase of the variable of 'lit' to the sign of 'lit' (which
+// has no effect if 'forcephase' is set).  The second moves the variable to
+// the front of the decision queue and gives it a higher score than all
+// other variables.  Thus variables prioritized last are decided first.
+// As with 'kissat_observe' hinted variables become active even if they do
+// not occur in the formula.
+
+void kissat_set_phase (kissat *solver, int lit);
+void kissat_set_priority (kissat *solver, int var);
+
+// After 'kissat_solve' returned '10' the following function returns
+// 'lit' if it is satisfied in all models, '-lit' if it is falsified in
+// all models and '0' otherwise (or if computing the backbone has been
+// terminated before 'lit' was found to be a backbone literal).  The full
+// backbone is computed on the first call.  This requires that the option
+// 'incremental' was set before solving.
+
+int kissat_backbone (kissat *solver, int lit);
+
+// Bulk versions of 'kissat_value'.  The first sets 'values[i]' to
+// 'kissat_value (solver, lits[i])' for all 'i < size'.  The second sets
+// 'values[idx]' to 'kissat_value (solver, idx)' for all variables 'idx'
+// from '1' to 'max_var' (and 'values[0]' to zero), thus 'values' needs to
+// have room for 'max_var + 1' integers.  Both extend the model only once.
+
+void kissat_values (kissat *solver, int size, const int *lits, int *values);
+void kissat_model (kissat *solver, int max_var, int *values);
+
 const char *kissat_id (void);
 const char *kissat_version (void);
 const char *kissat_compiler (void);
@@ -1261,13 +1261,11 @@ void completely_backtrack_to_root_level (kitten *kitten) {
   value *values = kitten->values;
   unsigneds *trail = &kitten->trail;
   unsigneds *units = &kitten->units;
-#ifndef NDEBUG
-  kar *vars = kitten->vars;
-#endif
-  for (all_stack (unsigned, lit, *trail)) {
-    assert (vars[lit / 2].level);
+  // Root-level assigned literals are on the trail too, if units have been
+  // propagated in a previous incremental call, and are assigned again by
+  // propagating their (possibly learned) unit clauses in 'kitten_solve'.
+  for (all_stack (unsigned, lit, *trail))
     unassign (kitten, values, lit);
-  }
   CLEAR_STACK (*trail);
   for (all_stack (unsigned, ref, *units)) {
     klause *c = dereference_klause (kitten, ref);
@@ -93,7 +93,7 @@ static reference learn_reference (kissat *solver, unsigned not_uip,
   for (unsigned *p = lits + 2; p != end; p++) {
     const unsigned lit = *p;
     const unsigned idx = IDX (lit);
-    const unsigned level = all_assigned[idx].level;
+    const unsigned level = ASSIGNED_LEVEL (all_assigned, idx);
     if (jump_level >= level)
       continue;
     jump_level = level;
@@ -195,6 +195,8 @@ void kissat_learn_clause (kissat *solver) {
   if (!solver->probing)
     kissat_update_learned (solver, glue, size);
   assert (size > 0);
+  if (size > 1 && solver->sharing.export)
+    kissat_export_learned_clause (solver, glue);
   reference ref = INVALID_REF;
   if (size == 1)
     learn_unit (solver, not_uip);
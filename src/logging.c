@@ -313,7 +313,10 @@ void kissat_log_extensions (kissat *solver, const char *prefix, size_t size,
   if (size > 1)
     fputs (" :", stdout);
   for (size_t i = 1; i < size; i++)
-    printf (" %d", exts[i].lit);
+    if (exts[i].lit)
+      printf (" %d", exts[i].lit);
+    else
+      fputs (" <compressed>", stdout);
   end_logging ();
 }
 
@@ -33,6 +33,15 @@ static void kissat_alarm_handler (void) {
   kissat_terminate (solver);
 }
 
+#ifndef __MINGW32__
+
+static void kissat_checkpoint_handler (void) {
+  assert (solver);
+  kissat_request_checkpoint (solver);
+}
+
+#endif
+
 #ifndef NDEBUG
 extern int kissat_dump (kissat *);
 #endif
@@ -46,7 +55,13 @@ int main (int argc, char **argv) {
   solver = kissat_init ();
   kissat_init_alarm (kissat_alarm_handler);
   kissat_init_signal_handler (kissat_signal_handler);
+#ifndef __MINGW32__
+  kissat_init_checkpoint_signal (kissat_checkpoint_handler);
+#endif
   res = kissat_application (solver, argc, argv);
+#ifndef __MINGW32__
+  kissat_reset_checkpoint_signal ();
+#endif
   kissat_reset_signal_handler ();
   ignore_alarm = true;
   kissat_reset_alarm ();
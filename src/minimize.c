@@ -2,17 +2,16 @@
 #include "inline.h"
 
 static inline int minimized_index (kissat *solver, bool minimizing,
-                                   assigned *a, unsigned lit, unsigned idx,
-                                   unsigned depth) {
+                                   assigned *assigned, unsigned lit,
+                                   unsigned idx, unsigned depth) {
 #if !defined(LOGGING) && defined(NDEBUG)
   (void) lit;
-#endif
-#ifdef NDEBUG
-  (void) idx;
 #endif
   assert (IDX (lit) == idx);
-  assert (solver->assigned + idx == a);
-  if (!a->level) {
+  assert (solver->assigned == assigned);
+  const struct assigned *const a = assigned + idx;
+  const unsigned level = ASSIGNED_LEVEL (assigned, idx);
+  if (!level) {
     LOG2 ("skipping root level literal %s", LOGLIT (lit));
     return 1;
   }
@@ -20,8 +19,9 @@ static inline int minimized_index (kissat *solver, bool minimizing,
     LOG2 ("skipping removable literal %s", LOGLIT (lit));
     return 1;
   }
-  assert (a->reason != UNIT_REASON);
-  if (a->reason == DECISION_REASON) {
+  const unsigned reason = ASSIGNED_REASON (assigned, idx);
+  assert (reason != UNIT_REASON);
+  if (reason == DECISION_REASON) {
     LOG2 ("can not remove decision literal %s", LOGLIT (lit));
     return -1;
   }
@@ -30,7 +30,7 @@ static inline int minimized_index (kissat *solver, bool minimizing,
     return -1;
   }
   if (minimizing || !depth) {
-    frame *frame = &FRAME (a->level);
+    frame *frame = &FRAME (level);
     if (frame->used <= 1) {
       LOG2 ("can not remove singleton frame literal %s", LOGLIT (lit));
       return -1;
@@ -65,19 +65,21 @@ static inline bool minimize_binary (kissat *solver, bool minimizing,
   for (unsigned next = lit;;) {
     const unsigned next_idx = IDX (next);
     struct assigned *a = assigned + next_idx;
-    int tmp = minimized_index (solver, minimizing, a, next, next_idx, 1);
+    int tmp =
+        minimized_index (solver, minimizing, assigned, next, next_idx, 1);
     if (tmp) {
       res = (tmp > 0);
       break;
     }
     PUSH_STACK (solver->minimize, next_idx);
+    const unsigned reason = ASSIGNED_REASON (assigned, next_idx);
     if (!a->binary) {
       const unsigned next_depth = (depth == UINT_MAX) ? depth : depth + 1;
-      res = minimize_reference (solver, minimizing, assigned, a->reason,
-                                next, next_depth);
+      res = minimize_reference (solver, minimizing, assigned, reason, next,
+                                next_depth);
       break;
     }
-    next = a->reason;
+    next = reason;
   }
   unsigned *begin = BEGIN_STACK (solver->minimize) + saved;
   const unsigned *const end = END_STACK (solver->minimize);
@@ -104,7 +106,7 @@ static bool minimize_literal (kissat *solver, bool minimizing,
     return false;
   const unsigned idx = IDX (lit);
   struct assigned *a = assigned + idx;
-  int tmp = minimized_index (solver, minimizing, a, lit, idx, depth);
+  int tmp = minimized_index (solver, minimizing, assigned, lit, idx, depth);
   if (tmp > 0)
     return true;
   if (tmp < 0)
@@ -114,12 +116,12 @@ static bool minimize_literal (kissat *solver, bool minimizing,
 #endif
   bool res;
   if (a->binary) {
-    const unsigned other = a->reason;
+    const unsigned other = ASSIGNED_REASON (assigned, idx);
     LOGBINARY2 (not_lit, other, "minimizing along %s reason",
                 LOGLIT (not_lit));
     res = minimize_binary (solver, minimizing, assigned, other, depth);
   } else {
-    const reference ref = a->reason;
+    const reference ref = ASSIGNED_REASON (assigned, idx);
     LOGREF2 (ref, "minimizing along %s reason", LOGLIT (not_lit));
     res =
         minimize_reference (solver, minimizing, assigned, ref, lit, depth);
@@ -167,7 +169,7 @@ void kissat_minimize_clause (kissat *solver) {
 #ifndef NDEBUG
   assert (lits < end);
   const unsigned not_uip = lits[0];
-  assert (assigned[IDX (not_uip)].level == solver->level);
+  assert (ASSIGNED_LEVEL (assigned, IDX (not_uip)) == solver->level);
 #endif
   for (const unsigned *p = lits; p != end; p++)
     kissat_push_removable (solver, assigned, IDX (*p));
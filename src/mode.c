@@ -204,6 +204,11 @@ void kissat_switch_search_mode (kissat *solver) {
   INC (switched);
   solver->limits.mode.count++;
 
+#ifndef NOPTIONS
+  if (GET_OPTION (bandit))
+    kissat_bandit_switch (solver);
+#endif
+
   if (solver->stable)
     switch_to_focused_mode (solver);
   else
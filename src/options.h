@@ -9,29 +9,37 @@
 #define OPTIONS \
   OPTION (ands, 1, 0, 1, "extract and eliminate and gates") \
   OPTION (backbone, 1, 0, 2, "binary clause backbone (2=eager)") \
+  OPTION (backbonechunk, 1e3, 1, INT_MAX, "full backbone chunk size limit") \
   OPTION (backboneeffort, 20, 0, 1e5, "effort in per mille") \
   OPTION (backbonemaxrounds, 1e3, 1, INT_MAX, "maximum backbone rounds") \
   OPTION (backbonerounds, 100, 1, INT_MAX, "backbone rounds limit") \
+  OPTION (bandit, 0, 0, 1, "bandit based configuration switching") \
   OPTION (bigbigfraction, 990, 0, 1000, "big binary clause fraction per mille") \
   OPTION (bump, 1, 0, 1, "enable variable bumping") \
   OPTION (bumpreasons, 1, 0, 1, "bump reason side literals too") \
   OPTION (bumpreasonslimit, 10, 1, INT_MAX, "relative reason literals limit") \
   OPTION (bumpreasonsrate, 10, 1, INT_MAX, "decision rate limit") \
+  OPTION (cacheint, 1e5, 1, INT_MAX, "cache flush interval") \
   DBGOPT (check, 2, 0, 2, "check model (1) and derived clauses (2)") \
+  OPTION (checkpointint, 1e4, 1, INT_MAX, "checkpoint interval in mega ticks") \
   OPTION (chrono, 1, 0, 1, "allow chronological backtracking") \
   OPTION (chronolevels, 100, 0, INT_MAX, "maximum jumped over levels") \
   OPTION (compact, 1, 0, 1, "enable compacting garbage collection") \
   OPTION (compactlim, 10, 0, 100, "compact inactive limit (in percent)") \
+  OPTION (compress, 1, 0, 1, "compress long eliminated clauses") \
+  OPTION (compresslim, 8, 3, INT_MAX, "compressed clause size limit") \
   OPTION (congruence, 1, 0, 1, "congruence closure on extracted gates") \
   OPTION (congruenceandarity, 1000000, 2, 50000000, "AND gate arity limit") \
   OPTION (congruenceands, 1, 0, 1, "extract AND gates for congruence closure") \
   OPTION (congruencebinaries, 1, 0, 1, "extract certain binary clauses") \
+  OPTION (congruenceincremental, 1, 0, 1, "reuse gates of previous closures") \
   OPTION (congruenceites, 1, 0, 1, "extract ITE gates for congruence closure") \
   OPTION (congruenceonce, 0, 0, 1, "congruence closure only initially") \
   OPTION (congruencexorarity, 4, 2, 20, "congruence XOR gate arity limit") \
   OPTION (congruencexorcounts, 2, 1, INT_MAX, "XOR counting rounds") \
   OPTION (congruencexors, 1, 0, 1, "extract XOR gates for congruence closure") \
   OPTION (decay, 50, 1, 200, "per mille scores decay") \
+  OPTION (deduplicate, 1, 0, 1, "remove duplicated original clauses") \
   OPTION (definitioncores, 2, 1, 100, "how many cores") \
   OPTION (definitions, 1, 0, 1, "extract general definitions") \
   OPTION (definitionticks, 1e6, 0, INT_MAX, "kitten ticks limits") \
@@ -70,6 +78,7 @@
   OPTION (forcephase, 0, 0, 1, "force initial phase") \
   OPTION (forward, 1, 0, 1, "forward subsumption in BVE") \
   OPTION (forwardeffort, 100, 0, 1e6, "effort in per mille") \
+  OPTION (forwardsig, 1, 0, 1, "forward subsumption signature filter") \
   OPTION (ifthenelse, 1, 0, 1, "extract and eliminate if-then-else gates") \
   OPTION (incremental, 0, 0, 1, "enable incremental solving") \
   OPTION (jumpreasons, 1, 0, 1, "jump binary reasons") \
@@ -84,6 +93,8 @@
   OPTION (modeinit, 1e3, 10, 1e8, "initial focused conflicts limit") \
   OPTION (modeint, 1e3, 10, 1e8, "focused conflicts interval") \
   OPTION (otfs, 1, 0, 1, "on-the-fly strengthening") \
+  OPTION (payoff, 0, 0, 1, "adapt simplification effort to payoff") \
+  OPTION (payoffscale, 2, 1, 100, "maximum payoff effort scaling") \
   OPTION (phase, 1, 0, 1, "initial decision phase") \
   OPTION (phasesaving, 1, 0, 1, "enable phase saving") \
   OPTION (preprocess, 1, 0, 1, "initial preprocessing") \
@@ -128,6 +139,7 @@
   OPTION (seed, 0, 0, INT_MAX, "random seed") \
   OPTION (shrink, 3, 0, 3, "learned clauses (1=bin,2=lrg,3=rec)") \
   OPTION (simplify, 1, 0, 1, "enable probing and elimination") \
+  OPTION (slabs, 1, 0, 1, "reuse freed watch vector blocks") \
   OPTION (smallclauses, 1e5, 0, INT_MAX, "small clauses limit") \
   OPTION (stable, STABLE_DEFAULT, 0, 2, "enable stable search mode") \
   NQTOPT (statistics, 0, 0, 1, "print complete statistics") \
@@ -153,8 +165,13 @@
   OPTION (tier2, 6, 1, 1e3, "learned clause tier two glue limit") \
   OPTION (tier2relative, 900, 0, 1000, "relative tier two glue limit") \
   OPTION (transitive, 1, 0, 1, "transitive reduction of binary clauses") \
+  OPTION (transitivebits, 1, 0, 1, "bit-set reachability on small graphs") \
+  OPTION (transitivebitslim, 1e4, 0, 1e5, "bit-set literals limit") \
   OPTION (transitiveeffort, 20, 0, 2e3, "effort in per mille") \
   OPTION (transitivekeep, 1, 0, 1, "keep transitivity candidates") \
+  OPTION (treelook, 1, 0, 1, "tree-look failed literal probing") \
+  OPTION (treelookeffort, 20, 0, 1e5, "effort in per mille") \
+  OPTION (treelookhbr, 1, 0, 2, "hyper binary resolvents (2=all)") \
   OPTION (tumble, 1, 0, 1, "tumbled external indices order") \
   NQTOPT (verbose, 0, 0, 3, "verbosity level") \
   OPTION (vivify, 1, 0, 1, "vivify clauses") \
@@ -1,5 +1,7 @@
 #include "parse.h"
 #include "collect.h"
+#include "congruence.h"
+#include "convert.h"
 #include "internal.h"
 #include "print.h"
 #include "profile.h"
@@ -7,6 +9,7 @@
 
 #include <ctype.h>
 #include <inttypes.h>
+#include <string.h>
 
 #define size_buffer (1u << 20)
 
@@ -66,9 +69,613 @@ faster_is_digit (int ch)
 
 #define ISDIGIT(CH) faster_is_digit (CH)
 
+// Combinational AIGER models in ASCII ('aag') or binary ('aig') format are
+// translated to CNF while parsing.  The disjunction of all outputs and bad
+// state properties is asserted and all invariant constraints are assumed.
+// Only AND gates in the cone-of-influence of these literals are visited.
+// Their inputs are simplified by constant propagation and structural
+// hashing, and only the remaining gates are Tseitin encoded, keeping the
+// variable indices of the model as DIMACS variable indices.  The encoded
+// gates are finally handed over to congruence closure, which then does
+// not need to extract them again from their clauses.
+
+#define AIGER_UNDEFINED 0
+#define AIGER_INPUT 1
+#define AIGER_AND 2
+#define AIGER_VISITING 3
+#define AIGER_MAPPED 4
+
+typedef struct aiger aiger;
+
+struct aiger
+{
+  kissat *solver;
+  read_buffer *buffer;
+  file *file;
+  uint64_t lineno;
+  int ch;
+  unsigned maxvar;
+  unsigned *rhs;
+  unsigned *map;
+  unsigned char *state;
+  unsigneds targets;
+  unsigneds constraints;
+  unsigneds stack;
+  uint64_t *keys;
+  unsigned *hashed;
+  size_t size_table;
+  ints gates;
+  unsigned simplified, merged, encoded;
+};
+
+#define NEXT_AIGER() \
+  (aiger->ch = next (aiger->buffer, aiger->file, &aiger->lineno))
+
+static const char *
+parse_aiger_unsigned (aiger * aiger, unsigned *res_ptr, int *terminator)
+{
+  int ch = NEXT_AIGER ();
+  if (!ISDIGIT (ch))
+    return "expected digit";
+  unsigned res = ch - '0';
+  while (ISDIGIT (ch = NEXT_AIGER ()))
+    {
+      if (UINT_MAX / 10 < res)
+	return "number too large";
+      res *= 10;
+      const unsigned digit = ch - '0';
+      if (UINT_MAX - digit < res)
+	return "number too large";
+      res += digit;
+    }
+  if (ch == '\r')
+    {
+      ch = NEXT_AIGER ();
+      if (ch != '\n')
+	return "expected new-line after carriage-return";
+    }
+  if (ch != ' ' && ch != '\n')
+    return "expected space or new-line after number";
+  *terminator = ch;
+  *res_ptr = res;
+  return 0;
+}
+
+static const char *
+parse_aiger_literal (aiger * aiger, unsigned *lit_ptr, int expected)
+{
+  int terminator;
+  const char *error = parse_aiger_unsigned (aiger, lit_ptr, &terminator);
+  if (error)
+    return error;
+  if (*lit_ptr / 2 > aiger->maxvar)
+    return "literal exceeds maximum variable index";
+  if (terminator != expected)
+    return expected == ' ' ? "expected space after literal" :
+      "expected new-line after literal";
+  return 0;
+}
+
+static const char *
+parse_aiger_delta (aiger * aiger, unsigned *delta_ptr)
+{
+  unsigned res = 0, shift = 0;
+  int ch;
+  while ((ch = NEXT_AIGER ()) != EOF && (ch & 0x80))
+    {
+      if (shift == 28)
+	return "delta encoding too large";
+      res |= (unsigned) (ch & 0x7f) << shift;
+      shift += 7;
+    }
+  if (ch == EOF)
+    return "unexpected end-of-file in binary AND gate";
+  if (shift == 28 && ch > 15)
+    return "delta encoding too large";
+  res |= (unsigned) ch << shift;
+  *delta_ptr = res;
+  return 0;
+}
+
+static const char *
+define_aiger_and (aiger * aiger, unsigned lhs, unsigned rhs0, unsigned rhs1)
+{
+  if (lhs < 2 || (lhs & 1))
+    return "invalid AND gate literal";
+  const unsigned idx = lhs / 2;
+  if (aiger->state[idx] != AIGER_UNDEFINED)
+    return "AND gate literal defined twice";
+  aiger->state[idx] = AIGER_AND;
+  aiger->rhs[2 * idx] = rhs0;
+  aiger->rhs[2 * idx + 1] = rhs1;
+  return 0;
+}
+
+static const char *
+parse_aiger_model (aiger * aiger, int *max_var_ptr)
+{
+  kissat *solver = aiger->solver;
+  int ch = NEXT_AIGER ();
+  bool binary;
+  if (ch == 'a')
+    binary = false;
+  else if (ch == 'i')
+    binary = true;
+  else
+    return "expected 'aag' or 'aig' header";
+  if (NEXT_AIGER () != 'g')
+    return "expected 'aag' or 'aig' header";
+  if (NEXT_AIGER () != ' ')
+    return "expected space after 'aag' or 'aig'";
+  unsigned header[9] = { 0 };
+  const char *error;
+  int terminator = ' ';
+  size_t parsed = 0;
+  while (terminator == ' ' && parsed != 9)
+    if ((error =
+	 parse_aiger_unsigned (aiger, header + parsed++, &terminator)))
+      return error;
+  if (terminator != '\n')
+    return "expected new-line after header";
+  if (parsed < 5)
+    return "expected at least five numbers in header";
+  const unsigned maxvar = header[0], inputs = header[1];
+  const unsigned latches = header[2], outputs = header[3];
+  const unsigned ands = header[4], bads = header[5];
+  const unsigned constraints = header[6];
+  if (maxvar > EXTERNAL_MAX_VAR)
+    return "maximum variable too large";
+  if (latches)
+    return "sequential models with latches not supported";
+  if (header[7] || header[8])
+    return "justice and fairness properties not supported";
+  if ((uint64_t) inputs + ands > maxvar)
+    return "maximum variable smaller than inputs and AND gates";
+  if (binary && inputs + ands != maxvar)
+    return "maximum variable does not match inputs and AND gates";
+  kissat_message (solver, "parsed '%s %u %u %u %u %u' header",
+		  binary ? "aig" : "aag",
+		  maxvar, inputs, latches, outputs, ands);
+  aiger->maxvar = maxvar;
+  *max_var_ptr = maxvar;
+  kissat_reserve (solver, maxvar);
+  CALLOC (aiger->state, maxvar + 1);
+  NALLOC (aiger->map, maxvar + 1);
+  NALLOC (aiger->rhs, 2 * (size_t) maxvar + 2);
+  aiger->state[0] = AIGER_MAPPED;
+  aiger->map[0] = 0;
+  unsigned lit;
+  for (unsigned i = 0; i != inputs; i++)
+    if (binary)
+      aiger->state[i + 1] = AIGER_INPUT;
+    else
+      {
+	if ((error = parse_aiger_literal (aiger, &lit, '\n')))
+	  return error;
+	if (lit < 2 || (lit & 1))
+	  return "invalid input literal";
+	if (aiger->state[lit / 2] != AIGER_UNDEFINED)
+	  return "input literal defined twice";
+	aiger->state[lit / 2] = AIGER_INPUT;
+      }
+  for (unsigned i = 0; i != outputs + bads; i++)
+    {
+      if ((error = parse_aiger_literal (aiger, &lit, '\n')))
+	return error;
+      PUSH_STACK (aiger->targets, lit);
+    }
+  for (unsigned i = 0; i != constraints; i++)
+    {
+      if ((error = parse_aiger_literal (aiger, &lit, '\n')))
+	return error;
+      PUSH_STACK (aiger->constraints, lit);
+    }
+  for (unsigned i = 0; i != ands; i++)
+    {
+      unsigned lhs, rhs0, rhs1;
+      if (binary)
+	{
+	  lhs = 2 * (inputs + i + 1);
+	  unsigned delta;
+	  if ((error = parse_aiger_delta (aiger, &delta)))
+	    return error;
+	  if (!delta || delta > lhs)
+	    return "invalid first delta in binary AND gate";
+	  rhs0 = lhs - delta;
+	  if ((error = parse_aiger_delta (aiger, &delta)))
+	    return error;
+	  if (delta > rhs0)
+	    return "invalid second delta in binary AND gate";
+	  rhs1 = rhs0 - delta;
+	}
+      else if ((error = parse_aiger_literal (aiger, &lhs, ' ')) ||
+	       (error = parse_aiger_literal (aiger, &rhs0, ' ')) ||
+	       (error = parse_aiger_literal (aiger, &rhs1, '\n')))
+	return error;
+      if ((error = define_aiger_and (aiger, lhs, rhs0, rhs1)))
+	return error;
+    }
+  while ((ch = NEXT_AIGER ()) != EOF)
+    ;
+  return 0;
+}
+
+static int
+aiger_dimacs_literal (unsigned lit)
+{
+  assert (lit > 1);
+  const int idx = lit / 2;
+  return (lit & 1) ? -idx : idx;
+}
+
+static unsigned
+aiger_mapped_literal (aiger * aiger, unsigned lit)
+{
+  assert (aiger->state[lit / 2] == AIGER_MAPPED);
+  return aiger->map[lit / 2] ^ (lit & 1);
+}
+
+static void
+encode_aiger_and (aiger * aiger, unsigned idx)
+{
+  kissat *solver = aiger->solver;
+  const unsigned *const rhs = aiger->rhs + 2 * idx;
+  unsigned a = aiger_mapped_literal (aiger, rhs[0]);
+  unsigned b = aiger_mapped_literal (aiger, rhs[1]);
+  if (a > b)
+    SWAP (unsigned, a, b);
+  unsigned res;
+  if (!a || (a ^ 1) == b)
+    res = 0;
+  else if (a == 1 || a == b)
+    res = b;
+  else
+    {
+      const uint64_t key = ((uint64_t) a << 32) | b;
+      const size_t mask = aiger->size_table - 1;
+      uint64_t hash = key * 0x9e3779b97f4a7c15u;
+      size_t pos = (hash ^ (hash >> 32)) & mask;
+      uint64_t *const keys = aiger->keys;
+      while (keys[pos] && keys[pos] != key)
+	pos = (pos + 1) & mask;
+      if (keys[pos])
+	{
+	  res = aiger->hashed[pos];
+	  aiger->merged++;
+	}
+      else
+	{
+	  res = 2 * idx;
+	  keys[pos] = key;
+	  aiger->hashed[pos] = res;
+	  const int lhs = idx;
+	  const int rhs0 = aiger_dimacs_literal (a);
+	  const int rhs1 = aiger_dimacs_literal (b);
+	  kissat_add (solver, -lhs);
+	  kissat_add (solver, rhs0);
+	  kissat_add (solver, 0);
+	  kissat_add (solver, -lhs);
+	  kissat_add (solver, rhs1);
+	  kissat_add (solver, 0);
+	  kissat_add (solver, lhs);
+	  kissat_add (solver, -rhs0);
+	  kissat_add (solver, -rhs1);
+	  kissat_add (solver, 0);
+	  PUSH_STACK (aiger->gates, lhs);
+	  PUSH_STACK (aiger->gates, rhs0);
+	  PUSH_STACK (aiger->gates, rhs1);
+	  aiger->encoded++;
+	}
+    }
+  if (res < 2)
+    aiger->simplified++;
+  aiger->map[idx] = res;
+  aiger->state[idx] = AIGER_MAPPED;
+}
+
+static const char *
+encode_aiger_cone (aiger * aiger, unsigned root)
+{
+  kissat *solver = aiger->solver;
+  unsigned char *const state = aiger->state;
+  unsigneds *const stack = &aiger->stack;
+  assert (EMPTY_STACK (*stack));
+  PUSH_STACK (*stack, root / 2);
+  while (!EMPTY_STACK (*stack))
+    {
+      const unsigned idx = TOP_STACK (*stack);
+      switch (state[idx])
+	{
+	case AIGER_UNDEFINED:
+	  return "undefined literal used";
+	case AIGER_INPUT:
+	  aiger->map[idx] = 2 * idx;
+	  state[idx] = AIGER_MAPPED;
+	  (void) POP_STACK (*stack);
+	  break;
+	case AIGER_MAPPED:
+	  (void) POP_STACK (*stack);
+	  break;
+	case AIGER_AND:
+	  state[idx] = AIGER_VISITING;
+	  for (unsigned i = 0; i != 2; i++)
+	    {
+	      const unsigned child = aiger->rhs[2 * idx + i] / 2;
+	      if (state[child] == AIGER_VISITING)
+		return "cyclic AND gate definition";
+	      if (state[child] != AIGER_MAPPED)
+		PUSH_STACK (*stack, child);
+	    }
+	  break;
+	default:
+	  assert (state[idx] == AIGER_VISITING);
+	  (void) POP_STACK (*stack);
+	  encode_aiger_and (aiger, idx);
+	  break;
+	}
+    }
+  return 0;
+}
+
+static const char *
+encode_aiger_model (aiger * aiger)
+{
+  kissat *solver = aiger->solver;
+  const char *error;
+  size_t size_table = 2;
+  while (size_table < 2 * (size_t) aiger->maxvar)
+    size_table *= 2;
+  aiger->size_table = size_table;
+  CALLOC (aiger->keys, size_table);
+  NALLOC (aiger->hashed, size_table);
+  bool satisfied = false;
+  for (all_stack (unsigned, lit, aiger->targets))
+    if ((error = encode_aiger_cone (aiger, lit)))
+      return error;
+    else if (aiger_mapped_literal (aiger, lit) == 1)
+      satisfied = true;
+  if (!satisfied)
+    {
+      for (all_stack (unsigned, lit, aiger->targets))
+	{
+	  const unsigned mapped = aiger_mapped_literal (aiger, lit);
+	  if (mapped)
+	    kissat_add (solver, aiger_dimacs_literal (mapped));
+	}
+      kissat_add (solver, 0);
+    }
+  for (all_stack (unsigned, lit, aiger->constraints))
+    {
+      if ((error = encode_aiger_cone (aiger, lit)))
+	return error;
+      const unsigned mapped = aiger_mapped_literal (aiger, lit);
+      if (mapped == 1)
+	continue;
+      if (mapped)
+	kissat_add (solver, aiger_dimacs_literal (mapped));
+      kissat_add (solver, 0);
+    }
+  kissat_message (solver,
+		  "encoded %u AND gates (%u merged, %u simplified)",
+		  aiger->encoded, aiger->merged, aiger->simplified);
+  kissat_import_and_gates (solver, SIZE_STACK (aiger->gates),
+			   BEGIN_STACK (aiger->gates));
+  return 0;
+}
+
+static const char *
+parse_aiger (kissat * solver, read_buffer * buffer, file * file,
+	     uint64_t * lineno_ptr, int *max_var_ptr)
+{
+  aiger aiger;
+  memset (&aiger, 0, sizeof aiger);
+  aiger.solver = solver;
+  aiger.buffer = buffer;
+  aiger.file = file;
+  aiger.lineno = 1;
+  const char *error = parse_aiger_model (&aiger, max_var_ptr);
+  if (error && aiger.ch == '\n')
+    {
+      assert (aiger.lineno > 1);
+      aiger.lineno--;
+    }
+  *lineno_ptr = aiger.lineno;
+  if (!error)
+    error = encode_aiger_model (&aiger);
+  const size_t size_vars = aiger.maxvar + 1;
+  if (aiger.state)
+    DEALLOC (aiger.state, size_vars);
+  if (aiger.map)
+    DEALLOC (aiger.map, size_vars);
+  if (aiger.rhs)
+    DEALLOC (aiger.rhs, 2 * size_vars);
+  if (aiger.keys)
+    DEALLOC (aiger.keys, aiger.size_table);
+  if (aiger.hashed)
+    DEALLOC (aiger.hashed, aiger.size_table);
+  RELEASE_STACK (aiger.targets);
+  RELEASE_STACK (aiger.constraints);
+  RELEASE_STACK (aiger.stack);
+  RELEASE_STACK (aiger.gates);
+  return error;
+}
+
+// Binary CNF files (see 'convert.h') are parsed block by block and all
+// clauses of a block are added at once through 'kissat_add_clauses'.
+
+static inline int
+next_binary (read_buffer * buffer, file * file)
+{
+  if (buffer->pos == buffer->end && !fill_buffer (buffer, file))
+    return EOF;
+  return buffer->chars[buffer->pos++];
+}
+
+static bool
+read_binary_varint (read_buffer * buffer, file * file, uint64_t * res_ptr)
+{
+  uint64_t res = 0;
+  unsigned shift = 0;
+  int ch;
+  do
+    {
+      if (shift > 56 || (ch = next_binary (buffer, file)) == EOF)
+	return false;
+      res |= (uint64_t) (ch & 127) << shift;
+      shift += 7;
+    }
+  while (ch & 128);
+  *res_ptr = res;
+  return true;
+}
+
+static bool
+read_payload_varint (read_buffer * buffer, file * file,
+		     uint64_t * remaining, uint32_t * hash,
+		     uint64_t * res_ptr)
+{
+  uint64_t res = 0;
+  unsigned shift = 0;
+  int ch;
+  do
+    {
+      if (!*remaining || shift > 56 ||
+	  (ch = next_binary (buffer, file)) == EOF)
+	return false;
+      *remaining -= 1;
+      *hash = kissat_convert_checksum (*hash, ch);
+      res |= (uint64_t) (ch & 127) << shift;
+      shift += 7;
+    }
+  while (ch & 128);
+  *res_ptr = res;
+  return true;
+}
+
+static const char *
+parse_binary_blocks (kissat * solver, read_buffer * buffer, file * file,
+		     uint64_t variables, uint64_t clauses, bool checksums,
+		     ints * lits)
+{
+  const uint64_t max_ulit = 2 * variables + 1;
+  uint64_t parsed = 0;
+  for (;;)
+    {
+      uint64_t count, remaining;
+      if (!read_binary_varint (buffer, file, &count))
+	return "invalid number of clauses in block";
+      if (!count)
+	break;
+      if (clauses - parsed < count)
+	return "too many clauses";
+      if (!read_binary_varint (buffer, file, &remaining))
+	return "invalid block size";
+      uint32_t hash = CONVERT_CHECKSUM_INIT;
+      for (uint64_t i = 0; i < count; i++)
+	{
+	  uint64_t size, ulit = 0;
+	  if (!read_payload_varint (buffer, file, &remaining, &hash, &size))
+	    return "invalid clause size";
+	  for (uint64_t j = 0; j < size; j++)
+	    {
+	      uint64_t delta;
+	      if (!read_payload_varint (buffer, file,
+					&remaining, &hash, &delta))
+		return "invalid literal";
+	      if (max_ulit - ulit < delta)
+		return "maximum variable index exceeded";
+	      ulit += delta;
+	      const int idx = ulit / 2;
+	      if (!idx)
+		return "invalid zero literal";
+	      PUSH_STACK (*lits, (ulit & 1) ? -idx : idx);
+	    }
+	  PUSH_STACK (*lits, 0);
+	}
+      if (remaining)
+	return "block size does not match its clauses";
+      if (checksums)
+	{
+	  uint32_t expected = 0;
+	  for (unsigned i = 0; i < 4; i++)
+	    {
+	      const int ch = next_binary (buffer, file);
+	      if (ch == EOF)
+		return "unexpected end-of-file in block checksum";
+	      expected |= (uint32_t) ch << (8 * i);
+	    }
+	  if (expected != hash)
+	    return "block checksum mismatch";
+	}
+      kissat_add_clauses (solver, SIZE_STACK (*lits), BEGIN_STACK (*lits));
+      CLEAR_STACK (*lits);
+      parsed += count;
+    }
+  if (parsed < clauses)
+    return "clauses missing";
+  if (next_binary (buffer, file) != EOF)
+    return "unexpected bytes after last block";
+  return 0;
+}
+
+static const char *
+parse_binary_number (read_buffer * buffer, file * file, uint64_t max,
+		     int terminator, uint64_t * res_ptr)
+{
+  int ch = next_binary (buffer, file);
+  if (!ISDIGIT (ch))
+    return "expected digit in binary CNF header";
+  uint64_t res = ch - '0';
+  while (ISDIGIT (ch = next_binary (buffer, file)))
+    {
+      if (max / 10 < res)
+	return "number too large in binary CNF header";
+      res *= 10;
+      const int digit = ch - '0';
+      if (max - digit < res)
+	return "number too large in binary CNF header";
+      res += digit;
+    }
+  if (ch != terminator)
+    return "invalid binary CNF header";
+  *res_ptr = res;
+  return 0;
+}
+
+static const char *
+parse_binary (kissat * solver, read_buffer * buffer, file * file,
+	      int *max_var_ptr)
+{
+  if (next_binary (buffer, file) != 'c' ||
+      next_binary (buffer, file) != 'n' ||
+      next_binary (buffer, file) != 'f' ||
+      next_binary (buffer, file) != ' ')
+    return "expected 'kcnf ' binary CNF header";
+  uint64_t variables, clauses, checksums;
+  const char *error;
+  if ((error = parse_binary_number (buffer, file, EXTERNAL_MAX_VAR, ' ',
+				    &variables)) ||
+      (error = parse_binary_number (buffer, file, UINT64_MAX, ' ',
+				    &clauses)) ||
+      (error = parse_binary_number (buffer, file, 1, '\n', &checksums)))
+    return error;
+  kissat_message (solver,
+		  "parsed 'kcnf %" PRIu64 " %" PRIu64 " %" PRIu64
+		  "' binary header", variables, clauses, checksums);
+  *max_var_ptr = variables;
+  kissat_reserve (solver, variables);
+  ints lits;
+  INIT_STACK (lits);
+  error = parse_binary_blocks (solver, buffer, file,
+			       variables, clauses, checksums, &lits);
+  RELEASE_STACK (lits);
+  return error;
+}
+
 static const char *
 parse_dimacs (kissat * solver, file * file,
-              strictness strict, uint64_t * lineno_ptr, int * max_var_ptr)
+              strictness strict, uint64_t * lineno_ptr, int * max_var_ptr,
+	      converter * converter)
 {
   read_buffer buffer;
   buffer.pos = buffer.end = 0;
@@ -80,6 +687,18 @@ parse_dimacs (kissat * solver, file * file,
       ch = NEXT ();
       if (ch == 'p')
 	break;
+      else if (first && ch == 'a')
+	{
+	  if (converter)
+	    return "can not convert AIGER models";
+	  return parse_aiger (solver, &buffer, file, lineno_ptr, max_var_ptr);
+	}
+      else if (first && ch == 'k')
+	{
+	  if (converter)
+	    return "input already in binary CNF format";
+	  return parse_binary (solver, &buffer, file, max_var_ptr);
+	}
       else if (ch == EOF)
 	{
 	  if (first)
@@ -307,7 +926,10 @@ parse_dimacs (kissat * solver, file * file,
   kissat_message (solver,
 		  "parsed 'p cnf %d %" PRIu64 "' header", variables, clauses);
   *max_var_ptr = variables;
-  kissat_reserve (solver, variables);
+  if (converter)
+    kissat_convert_header (converter, variables, clauses);
+  else
+    kissat_reserve (solver, variables);
   uint64_t parsed = 0;
   int lit = 0;
   for (;;)
@@ -414,7 +1036,10 @@ parse_dimacs (kissat * solver, file * file,
 	  parsed++;
 	  lit = 0;
 	}
-      kissat_add (solver, lit);
+      if (converter)
+	kissat_convert_literal (converter, lit);
+      else
+	kissat_add (solver, lit);
     }
   if (lit)
     return "trailing zero missing";
@@ -437,9 +1062,34 @@ kissat_parse_dimacs (kissat * solver,
 {
   START (parse);
   const char *res;
-  res = parse_dimacs (solver, file, strict, lineno_ptr, max_var_ptr);
-  if (!solver->inconsistent)
-    kissat_defrag_watches (solver);
+  res = parse_dimacs (solver, file, strict, lineno_ptr, max_var_ptr, 0);
+  if (!solver->inconsistent) {
+    if (GET_OPTION (slabs))
+      kissat_rebuild_slabs (solver, LITS, solver->watches);
+    else
+      kissat_defrag_watches (solver);
+  }
+  STOP (parse);
+  return res;
+}
+
+// The header of the binary format is written before the clauses are
+// parsed and thus has to be correct, i.e., relaxed parsing is disabled.
+
+const char *
+kissat_convert_dimacs (kissat * solver, strictness strict, file * input,
+		       file * output, uint64_t * lineno_ptr,
+		       int *max_var_ptr)
+{
+  START (parse);
+  if (strict == RELAXED_PARSING)
+    strict = NORMAL_PARSING;
+  converter converter;
+  kissat_init_converter (solver, &converter, output);
+  const char *res = parse_dimacs (solver, input, strict,
+				  lineno_ptr, max_var_ptr, &converter);
+  if (!kissat_release_converter (&converter) && !res)
+    res = "failed to write binary CNF";
   STOP (parse);
   return res;
 }
@@ -16,4 +16,10 @@ struct kissat;
 const char *kissat_parse_dimacs (struct kissat *, strictness, file *,
                                  uint64_t *linenoptr, int *max_var_ptr);
 
+// Translates DIMACS to the binary CNF format described in 'convert.h'.
+
+const char *kissat_convert_dimacs (struct kissat *, strictness, file *input,
+                                   file *output, uint64_t *linenoptr,
+                                   int *max_var_ptr);
+
 #endif
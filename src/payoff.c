@@ -0,0 +1,90 @@
+#include "payoff.h"
+#include "internal.h"
+#include "print.h"
+
+#include <inttypes.h>
+
+// The benefit of a simplifier is measured as the number of removed
+// variables and clauses plus the number of strengthened and vivified
+// clauses and found equivalences during its run.  Its cost is the increase
+// of its own counter, which differs between simplifiers (resolutions,
+// kitten ticks, probing ticks etc.).  Thus payoffs (benefit per million
+// cost units) of different simplifiers are not comparable and each one is
+// only compared to its own history.  The ratio of the smoothed payoff of
+// the last runs to the accumulated payoff of all runs gives the scale of
+// the next effort, bounded by the 'payoffscale' factor.  Effort is not
+// reallocated between simplifiers.  Since payoffs usually diminish over
+// time, the scale tends to settle below one, which is why 'payoff' is
+// disabled by default.
+
+void kissat_init_payoffs (kissat *solver) {
+  payoffs *payoffs = &solver->payoffs;
+#define PAYOFF(NAME) payoffs->NAME.scale = 1;
+  PAYOFFS
+#undef PAYOFF
+}
+
+static int64_t simplified (kissat *solver) {
+  const statistics *statistics = &solver->statistics;
+  int64_t res = statistics->strengthened + statistics->vivified;
+  res += statistics->sweep_equivalences;
+  res += statistics->treelook_equivalences;
+  res += statistics->treelook_strengthened;
+  res -= solver->active;
+  res -= BINIRR_CLAUSES;
+  return res;
+}
+
+void kissat_start_payoff (kissat *solver, payoff *payoff, uint64_t cost) {
+  payoff->benefit = simplified (solver);
+  payoff->cost = cost;
+}
+
+static void update_scale (payoff *payoff, double max_scale) {
+  const double min_scale = 1 / max_scale;
+  const double history = 1e6 * payoff->benefits / payoff->costs;
+  double scale;
+  if (history > 0) {
+    scale = payoff->average / history;
+    if (scale < min_scale)
+      scale = min_scale;
+    if (scale > max_scale)
+      scale = max_scale;
+  } else
+    scale = min_scale;
+  payoff->scale = scale;
+}
+
+void kissat_stop_payoff (kissat *solver, payoff *payoff, const char *name,
+                         uint64_t cost) {
+  if (!GET_OPTION (payoff))
+    return;
+  if (solver->inconsistent)
+    return;
+  assert (payoff->cost <= cost);
+  cost -= payoff->cost;
+  if (!cost)
+    return;
+  int64_t benefit = simplified (solver) - payoff->benefit;
+  if (benefit < 0)
+    benefit = 0;
+  const double current = 1e6 * benefit / (double) cost;
+  if (payoff->measured)
+    payoff->average = (payoff->average + current) / 2;
+  else {
+    payoff->average = current;
+    payoff->measured = true;
+  }
+  payoff->benefits += benefit;
+  payoff->costs += cost;
+  update_scale (payoff, GET_OPTION (payoffscale));
+  INC (payoffs);
+  kissat_very_verbose (solver,
+                       "%s payoff %.2f = %" PRId64 " / %s "
+                       "(average %.2f, scale %.2f)",
+                       name, current, benefit, FORMAT_COUNT (cost),
+                       payoff->average, payoff->scale);
+#ifdef QUIET
+  (void) name;
+#endif
+}
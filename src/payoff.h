@@ -0,0 +1,57 @@
+#ifndef _payoff_h_INCLUDED
+#define _payoff_h_INCLUDED
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Simplifiers with an effort limit (in ticks of their own 'COST' counter
+// relative to search ticks) scale their effort, while probing scales its
+// conflict interval and congruence closure its delay, by the measured
+// payoff (benefit per cost) relative to their own previous payoff.
+
+#define PAYOFFS \
+  PAYOFF (congruence) \
+  PAYOFF (eliminate) \
+  PAYOFF (probe) \
+  PAYOFF (sweep) \
+  PAYOFF (transitive) \
+  PAYOFF (treelook) \
+  PAYOFF (vivify)
+
+typedef struct payoff payoff;
+typedef struct payoffs payoffs;
+
+struct payoff {
+  bool measured;
+  double average;
+  double scale;
+  double benefits, costs;
+  int64_t benefit;
+  uint64_t cost;
+};
+
+struct payoffs {
+#define PAYOFF(NAME) payoff NAME;
+  PAYOFFS
+#undef PAYOFF
+};
+
+struct kissat;
+
+void kissat_init_payoffs (struct kissat *);
+void kissat_start_payoff (struct kissat *, payoff *, uint64_t cost);
+void kissat_stop_payoff (struct kissat *, payoff *, const char *name,
+                         uint64_t cost);
+
+#define START_PAYOFF(NAME, COST) \
+  kissat_start_payoff (solver, &solver->payoffs.NAME, \
+                       solver->statistics.COST)
+
+#define STOP_PAYOFF(NAME, COST) \
+  kissat_stop_payoff (solver, &solver->payoffs.NAME, #NAME, \
+                      solver->statistics.COST)
+
+#define SET_PAYOFF_EFFORT_LIMIT(LIMIT, NAME, START) \
+  SET_SCALED_EFFORT_LIMIT (LIMIT, NAME, START, solver->payoffs.NAME.scale)
+
+#endif
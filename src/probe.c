@@ -9,6 +9,7 @@
 #include "sweep.h"
 #include "terminate.h"
 #include "transitive.h"
+#include "treelook.h"
 #include "vivify.h"
 
 #include <inttypes.h>
@@ -33,6 +34,7 @@ static void probe (kissat *solver) {
   kissat_congruence (solver);
   kissat_substitute (solver, false);
   kissat_binary_clauses_backbone (solver);
+  kissat_treelook (solver);
   kissat_vivify (solver);
   kissat_sweep (solver);
   kissat_substitute (solver, false);
@@ -67,11 +69,43 @@ static void probe_initially (kissat *solver) {
     kissat_factor (solver);
 }
 
+// Probing runs several simplifiers and its cost is the sum of their ticks,
+// which is fine since its payoff is only compared to its own history.
+
+static uint64_t probing_cost (kissat *solver) {
+  const statistics *statistics = &solver->statistics;
+  uint64_t res = statistics->backbone_ticks;
+  res += statistics->congruence_ticks;
+  res += statistics->factor_ticks;
+  res += statistics->kitten_ticks;
+  res += statistics->probing_ticks;
+  res += statistics->substitute_ticks;
+  res += statistics->transitive_ticks;
+  res += statistics->treelook_ticks;
+  return res;
+}
+
+static void scale_probe_limit (kissat *solver) {
+  if (!GET_OPTION (payoff))
+    return;
+  limits *limits = &solver->limits;
+  const double scale = solver->payoffs.probe.scale;
+  const uint64_t delta = limits->probe.conflicts - CONFLICTS;
+  const uint64_t scaled = delta / scale;
+  limits->probe.conflicts = CONFLICTS + scaled;
+  kissat_very_verbose (solver,
+                       "probe limit delta %" PRIu64 " scaled by payoff "
+                       "to %" PRIu64 " conflicts",
+                       delta, scaled);
+}
+
 int kissat_probe (kissat *solver) {
   assert (!solver->inconsistent);
   INC (probings);
   assert (!solver->probing);
   solver->probing = true;
+  kissat_start_payoff (solver, &solver->payoffs.probe,
+                       probing_cost (solver));
   const unsigned max_rounds = GET_OPTION (proberounds);
   for (unsigned round = 0; round != max_rounds; round++) {
     unsigned before = solver->active;
@@ -81,8 +115,12 @@ int kissat_probe (kissat *solver) {
     if (before == solver->active)
       break;
   }
+  kissat_stop_payoff (solver, &solver->payoffs.probe, "probe",
+                      probing_cost (solver));
   kissat_classify (solver);
   UPDATE_CONFLICT_LIMIT (probe, probings, NLOGN, true);
+  if (!solver->inconsistent)
+    scale_probe_limit (solver);
   solver->last.ticks.probe = solver->statistics.search_ticks;
   assert (solver->probing);
   solver->probing = false;
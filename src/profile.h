@@ -46,6 +46,7 @@ typedef struct profiles profiles;
   PROF (search, 1) \
   PROF (shrink, 3) \
   PROF (simplify, 1) \
+  PROF (slabs, 3) \
   PROF (sort, 4) \
   PROF (stable, 2) \
   PROF (substitute, 2) \
@@ -55,6 +56,7 @@ typedef struct profiles profiles;
   PROF (sweepequivalences, 3) \
   PROF (total, 0) \
   PROF (transitive, 2) \
+  PROF (treelook, 2) \
   PROF (vivify, 2) \
   PROF (vivify0, 3) \
   PROF (vivify1, 3) \
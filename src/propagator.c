@@ -0,0 +1,286 @@
+#include "propagator.h"
+#include "backtrack.h"
+#include "error.h"
+#include "inline.h"
+#include "logging.h"
+#include "print.h"
+#include "propsearch.h"
+
+// Assignments are notified lazily in trail order right before the
+// external propagator is asked for clauses or propagations.  The position
+// of the first not yet notified literal on the trail is kept up-to-date
+// during backtracking (taking out-of-order literals into account which
+// stay assigned) and when the trail is flushed.
+
+void kissat_notify_assignments (kissat *solver) {
+  propagator *propagator = &solver->propagator;
+  assert (propagator->connected);
+  const unsigned *const trail = BEGIN_ARRAY (solver->trail);
+  const size_t size = SIZE_ARRAY (solver->trail);
+  assert (propagator->notified <= size);
+  void (*notify) (void *, int, int) =
+      propagator->callbacks.notify_assignment;
+  if (notify) {
+    void *state = propagator->callbacks.state;
+    const import *const imports = BEGIN_STACK (solver->import);
+    const assigned *const assigned = solver->assigned;
+    for (size_t i = propagator->notified; i != size; i++) {
+      const unsigned ilit = trail[i];
+      const int elit = kissat_export_literal (solver, ilit);
+      if (!elit)
+        continue;
+      if (!imports[ABS (elit)].observed)
+        continue;
+      const unsigned level = ASSIGNED_LEVEL (assigned, IDX (ilit));
+      LOG ("notifying assignment of %s", LOGLIT (ilit));
+      notify (state, elit, (int) level);
+    }
+  }
+  propagator->notified = size;
+}
+
+void kissat_notify_backtrack (kissat *solver, unsigned new_level,
+                              size_t new_trail) {
+  propagator *propagator = &solver->propagator;
+  assert (propagator->connected);
+  const size_t notified = propagator->notified;
+  if (notified <= new_trail)
+    return;
+  const unsigned *const trail = BEGIN_ARRAY (solver->trail);
+  const assigned *const assigned = solver->assigned;
+  size_t kept = 0;
+  for (size_t i = new_trail; i != notified; i++)
+    if (ASSIGNED_LEVEL (assigned, IDX (trail[i])) <= new_level)
+      kept++;
+  propagator->notified = new_trail + kept;
+  LOG ("notifying backtracking to level %u", new_level);
+  if (propagator->callbacks.notify_backtrack)
+    propagator->callbacks.notify_backtrack (propagator->callbacks.state,
+                                            (int) new_level);
+}
+
+static unsigned import_external_literal (kissat *solver, int elit) {
+  if (elit == INT_MIN)
+    kissat_fatal ("external propagator literal 'INT_MIN' invalid");
+  const unsigned eidx = ABS (elit);
+  if (eidx >= SIZE_STACK (solver->import))
+    kissat_fatal ("external propagator variable %u unknown", eidx);
+  const import *const import = &PEEK_STACK (solver->import, eidx);
+  if (!import->imported || import->eliminated || import->extension)
+    kissat_fatal ("external propagator variable %u not observed", eidx);
+  unsigned ilit = import->lit;
+  if (elit < 0)
+    ilit = NOT (ilit);
+  const unsigned idx = IDX (ilit);
+  if (!solver->flags[idx].active && !solver->flags[idx].fixed)
+    kissat_fatal ("external propagator variable %u not observed", eidx);
+  return ilit;
+}
+
+// Copy the external clause to 'solver->clause' while skipping duplicated
+// and root-level falsified literals.  Returns 'false' if the clause is
+// satisfied at the root-level or tautological.
+
+static bool import_external_clause (kissat *solver, const int *elits) {
+  assert (EMPTY_STACK (solver->clause));
+  const assigned *const assigned = solver->assigned;
+  const value *const values = solver->values;
+  mark *const marks = solver->marks;
+  bool res = true;
+  for (const int *p = elits; *p; p++) {
+    const unsigned ilit = import_external_literal (solver, *p);
+    const value value = values[ilit];
+    if (value && !ASSIGNED_LEVEL (assigned, IDX (ilit))) {
+      if (value > 0) {
+        res = false;
+        break;
+      }
+      continue;
+    }
+    const mark mark = marks[ilit];
+    if (mark > 0)
+      continue;
+    if (mark < 0) {
+      res = false;
+      break;
+    }
+    marks[ilit] = 1;
+    marks[NOT (ilit)] = -1;
+    PUSH_STACK (solver->clause, ilit);
+  }
+  for (all_stack (unsigned, ilit, solver->clause))
+    marks[ilit] = marks[NOT (ilit)] = 0;
+  if (!res) {
+    CLEAR_STACK (solver->clause);
+    return false;
+  }
+#ifndef NDEBUG
+  if (GET_OPTION (check) > 1) {
+    size_t size = 0;
+    while (elits[size])
+      size++;
+    ADD_UNCHECKED_EXTERNAL (size, elits);
+  }
+#endif
+  return true;
+}
+
+// Move non-falsified literals to the front followed by the falsified
+// literal with the highest level and return the number of non-falsified
+// literals.
+
+static unsigned sort_external_clause (kissat *solver) {
+  unsigned *const lits = BEGIN_STACK (solver->clause);
+  const unsigned size = SIZE_STACK (solver->clause);
+  const assigned *const assigned = solver->assigned;
+  const value *const values = solver->values;
+  unsigned unfalsified = 0;
+  for (unsigned i = 0; i != size; i++) {
+    const unsigned lit = lits[i];
+    if (values[lit] < 0)
+      continue;
+    lits[i] = lits[unfalsified];
+    lits[unfalsified++] = lit;
+  }
+  unsigned highest = unfalsified;
+  for (unsigned i = unfalsified + 1; i < size; i++)
+    if (ASSIGNED_LEVEL (assigned, IDX (lits[i])) >
+        ASSIGNED_LEVEL (assigned, IDX (lits[highest])))
+      highest = i;
+  if (highest < size) {
+    const unsigned lit = lits[highest];
+    lits[highest] = lits[unfalsified];
+    lits[unfalsified] = lit;
+  }
+  return unfalsified;
+}
+
+static void add_external_unit (kissat *solver, unsigned unit) {
+  if (solver->level)
+    kissat_backtrack_in_consistent_state (solver, 0);
+  assert (VALUE (unit) >= 0);
+  if (!VALUE (unit))
+    kissat_learned_unit (solver, unit);
+}
+
+// Add a clause from the external propagator during search, which might
+// force backtracking and then an assignment, or is returned as conflict.
+
+static clause *add_external_clause (kissat *solver, const int *elits,
+                                    bool redundant) {
+  if (!import_external_clause (solver, elits)) {
+    LOG ("skipping satisfied or tautological external clause");
+    return 0;
+  }
+  const unsigned size = SIZE_STACK (solver->clause);
+  clause *res = 0;
+  if (!size) {
+    LOG ("external empty clause");
+    solver->inconsistent = true;
+    CHECK_AND_ADD_EMPTY ();
+    ADD_EMPTY_TO_PROOF ();
+  } else if (size == 1)
+    add_external_unit (solver, PEEK_STACK (solver->clause, 0));
+  else {
+    const unsigned unfalsified = sort_external_clause (solver);
+    const unsigned *const lits = BEGIN_STACK (solver->clause);
+    const reference ref =
+        redundant ? kissat_new_redundant_clause (solver, size - 1)
+                  : kissat_new_irredundant_clause (solver);
+    clause *c =
+        ref == INVALID_REF ? 0 : kissat_dereference_clause (solver, ref);
+    const unsigned first = lits[0], second = lits[1];
+    if (!unfalsified) {
+      LOG ("external clause conflicting");
+      res = c ? c : kissat_binary_conflict (solver, first, second);
+    } else if (unfalsified == 1) {
+      const unsigned level = LEVEL (second);
+      const value value = VALUE (first);
+      if (value <= 0 || LEVEL (first) > level) {
+        if (solver->level > level)
+          kissat_backtrack_in_consistent_state (solver, level);
+        if (c)
+          kissat_assign_reference (solver, first, ref, c);
+        else
+          kissat_assign_binary (solver, first, second);
+      }
+    }
+  }
+  CLEAR_STACK (solver->clause);
+  return res;
+}
+
+static bool check_external_model (kissat *solver) {
+  propagator *propagator = &solver->propagator;
+  if (!propagator->callbacks.check_model)
+    return true;
+  ints *model = &propagator->model;
+  assert (EMPTY_STACK (*model));
+  const import *const imports = BEGIN_STACK (solver->import);
+  const size_t size = SIZE_STACK (solver->import);
+  for (size_t eidx = 1; eidx < size; eidx++) {
+    const import *const import = imports + eidx;
+    if (!import->observed || !import->imported)
+      continue;
+    const value value = VALUE (import->lit);
+    assert (value);
+    PUSH_STACK (*model, value < 0 ? -(int) eidx : (int) eidx);
+  }
+  const int accepted = propagator->callbacks.check_model (
+      propagator->callbacks.state, (int) SIZE_STACK (*model),
+      BEGIN_STACK (*model));
+  CLEAR_STACK (*model);
+  if (accepted)
+    return true;
+  INC (external_rejected);
+  LOG ("external propagator rejected model");
+  return false;
+}
+
+clause *kissat_external_propagate (kissat *solver) {
+  propagator *propagator = &solver->propagator;
+  assert (propagator->connected);
+  kissat_propagator *callbacks = &propagator->callbacks;
+  void *state = callbacks->state;
+  clause *conflict = 0;
+  for (;;) {
+    assert (kissat_propagated (solver));
+    kissat_notify_assignments (solver);
+    const int *elits =
+        callbacks->add_clause ? callbacks->add_clause (state) : 0;
+    if (elits) {
+      INC (external_clauses);
+      propagator->rejected = false;
+      conflict = add_external_clause (solver, elits, false);
+    } else if (propagator->rejected)
+      kissat_fatal ("external propagator rejected model "
+                    "without adding a clause");
+    else {
+      const int elit =
+          callbacks->propagate ? callbacks->propagate (state) : 0;
+      if (elit) {
+        const unsigned ilit = import_external_literal (solver, elit);
+        if (VALUE (ilit) > 0)
+          continue;
+        if (!callbacks->explain)
+          kissat_fatal ("external propagator without 'explain' callback");
+        INC (external_propagated);
+        elits = callbacks->explain (state, elit);
+        if (!elits)
+          kissat_fatal ("external propagator could not explain %d", elit);
+        conflict = add_external_clause (solver, elits, true);
+      } else if (solver->unassigned || check_external_model (solver))
+        break;
+      else {
+        propagator->rejected = true;
+        continue;
+      }
+    }
+    if (conflict || solver->inconsistent)
+      break;
+    conflict = kissat_search_propagate (solver);
+    if (conflict)
+      break;
+  }
+  return conflict;
+}
@@ -0,0 +1,28 @@
+#ifndef _propagator_h_INCLUDED
+#define _propagator_h_INCLUDED
+
+#include "kissat.h"
+#include "stack.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+
+typedef struct propagator propagator;
+
+struct propagator {
+  bool connected;
+  bool rejected;
+  size_t notified;
+  kissat_propagator callbacks;
+  ints model;
+};
+
+struct clause;
+struct kissat;
+
+void kissat_notify_assignments (struct kissat *);
+void kissat_notify_backtrack (struct kissat *, unsigned new_level,
+                              size_t new_trail);
+struct clause *kissat_external_propagate (struct kissat *);
+
+#endif
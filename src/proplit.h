@@ -63,9 +63,8 @@ static inline clause *PROPAGATE_LITERAL (kissat *solver,
   const size_t size_watches = SIZE_WATCHES (*watches);
   uint64_t ticks = 1 + kissat_cache_lines (size_watches, sizeof (watch));
   const unsigned idx = IDX (lit);
-  struct assigned *const a = assigned + idx;
   const bool probing = solver->probing;
-  const unsigned level = a->level;
+  const unsigned level = ASSIGNED_LEVEL (assigned, idx);
   clause *res = 0;
 
   while (p != end_watches) {
@@ -0,0 +1,305 @@
+#include "reconstruct.h"
+#include "allocate.h"
+#include "cache.h"
+#include "inline.h"
+#include "print.h"
+
+#include <ctype.h>
+
+static unsigned external_variables (kissat *solver) {
+  const size_t imported = SIZE_STACK (solver->import);
+  return imported ? imported - 1 : 0;
+}
+
+static bool simplified_variable (kissat *solver, const import *import) {
+  if (!import->imported || import->eliminated)
+    return false;
+  const unsigned idx = IDX (import->lit);
+  return FLAGS (idx)->active;
+}
+
+static bool write_simplified_clause (kissat *solver, const int *mapped,
+                                     unsigned size, const unsigned *lits,
+                                     FILE *file) {
+  for (unsigned i = 0; i < size; i++)
+    if (kissat_fixed (solver, lits[i]) > 0)
+      return false;
+  if (!file)
+    return true;
+  for (unsigned i = 0; i < size; i++) {
+    const unsigned ilit = lits[i];
+    if (kissat_fixed (solver, ilit))
+      continue;
+    const int slit = mapped[IDX (ilit)];
+    assert (slit);
+    fprintf (file, "%d ", NEGATED (ilit) ? -slit : slit);
+  }
+  fputs ("0\n", file);
+  return true;
+}
+
+static bool write_simplified_binary (kissat *solver, const int *mapped,
+                                     unsigned ilit, unsigned iother,
+                                     FILE *file) {
+  if (iother < ilit)
+    return false;
+  const unsigned lits[2] = {ilit, iother};
+  return write_simplified_clause (solver, mapped, 2, lits, file);
+}
+
+// Without file only counts the clauses, which are not root-level
+// satisfied, in order to write the header first.
+
+static size_t write_simplified_clauses (kissat *solver, const int *mapped,
+                                        FILE *file) {
+  size_t res = 0;
+  if (solver->watching) {
+    for (all_literals (ilit))
+      for (all_binary_blocking_watches (watch, WATCHES (ilit)))
+        if (watch.type.binary)
+          res += write_simplified_binary (solver, mapped, ilit,
+                                          watch.binary.lit, file);
+  } else {
+    for (all_literals (ilit))
+      for (all_binary_large_watches (watch, WATCHES (ilit)))
+        if (watch.type.binary)
+          res += write_simplified_binary (solver, mapped, ilit,
+                                          watch.binary.lit, file);
+  }
+  for (all_clauses (c))
+    if (!c->garbage && !c->redundant)
+      res += write_simplified_clause (solver, mapped, c->size, c->lits,
+                                      file);
+  return res;
+}
+
+bool kissat_write_simplified (kissat *solver, FILE *file) {
+  if (solver->inconsistent) {
+    fputs ("p cnf 0 1\n0\n", file);
+    return !ferror (file) && !fflush (file);
+  }
+  int *mapped;
+  CALLOC (mapped, VARS);
+  const unsigned vars = external_variables (solver);
+  const import *const imports = BEGIN_STACK (solver->import);
+  int simplified = 0;
+  for (unsigned eidx = 1; eidx <= vars; eidx++) {
+    const import *const import = imports + eidx;
+    if (!simplified_variable (solver, import))
+      continue;
+    const unsigned ilit = import->lit;
+    simplified++;
+    mapped[IDX (ilit)] = NEGATED (ilit) ? -simplified : simplified;
+  }
+  const size_t clauses = write_simplified_clauses (solver, mapped, 0);
+  fprintf (file, "p cnf %d %zu\n", simplified, clauses);
+  const size_t written = write_simplified_clauses (solver, mapped, file);
+  assert (written == clauses);
+  (void) written;
+  DEALLOC (mapped, VARS);
+  kissat_message (solver,
+                  "simplified formula has %d variables and %zu clauses",
+                  simplified, clauses);
+  return !ferror (file) && !fflush (file);
+}
+
+static void write_eliminated_variables (kissat *solver, FILE *file) {
+  const size_t size = SIZE_STACK (solver->eliminated);
+  unsigned *order;
+  CALLOC (order, size);
+  const unsigned vars = external_variables (solver);
+  const import *const imports = BEGIN_STACK (solver->import);
+  for (unsigned eidx = 1; eidx <= vars; eidx++) {
+    const import *const import = imports + eidx;
+    if (!import->imported || !import->eliminated)
+      continue;
+    assert (import->lit < size);
+    order[import->lit] = eidx;
+  }
+  for (size_t pos = 0; pos < size; pos++)
+    if (order[pos])
+      fprintf (file, "%u ", order[pos]);
+  fputs ("0\n", file);
+  DEALLOC (order, size);
+}
+
+// Traverses the 'extend' stack backward as 'kissat_extend' does.
+
+static size_t write_witness_labelled_clauses (kissat *solver,
+                                              FILE *file) {
+  const extension *const begin = BEGIN_STACK (solver->extend);
+  const extension *p = END_STACK (solver->extend);
+  const uint8_t *compressed = END_STACK (solver->compressed);
+  unsigneds *decompressed = &solver->decompressed;
+  assert (EMPTY_STACK (*decompressed));
+  size_t res = 0;
+  while (p != begin) {
+    int blocking = 0;
+    do {
+      assert (begin < p);
+      const extension ext = *--p;
+      const int elit = ext.lit;
+      if (ext.blocking)
+        blocking = elit;
+      else if (elit)
+        PUSH_STACK (*decompressed, elit < 0 ? 2u * -elit + 1 : 2u * elit);
+      else
+        compressed = kissat_decompress_extension (solver, compressed,
+                                                  decompressed);
+    } while (!blocking);
+    fprintf (file, "%d ", blocking);
+    for (all_stack (unsigned, ulit, *decompressed)) {
+      const int idx = ulit / 2;
+      fprintf (file, "%d ", (ulit & 1) ? -idx : idx);
+    }
+    fputs ("0\n", file);
+    CLEAR_STACK (*decompressed);
+    res++;
+  }
+  assert (compressed == BEGIN_STACK (solver->compressed));
+  return res;
+}
+
+bool kissat_write_reconstruction (kissat *solver, int max_var,
+                                  FILE *file) {
+  const unsigned vars = external_variables (solver);
+  const import *const imports = BEGIN_STACK (solver->import);
+  if (solver->inconsistent) {
+    fprintf (file, "kissat-reconstruction %d %u 0\n0\n0\n0\n", max_var,
+             vars);
+    return !ferror (file) && !fflush (file);
+  }
+  unsigned simplified = 0;
+  for (unsigned eidx = 1; eidx <= vars; eidx++)
+    simplified += simplified_variable (solver, imports + eidx);
+  fprintf (file, "kissat-reconstruction %d %u %u\n", max_var, vars,
+           simplified);
+  for (unsigned eidx = 1; eidx <= vars; eidx++)
+    if (simplified_variable (solver, imports + eidx))
+      fprintf (file, "%u ", eidx);
+  fputs ("0\n", file);
+  for (unsigned eidx = 1; eidx <= vars; eidx++) {
+    const import *const import = imports + eidx;
+    if (!import->imported || import->eliminated)
+      continue;
+    const value value = kissat_fixed (solver, import->lit);
+    if (value)
+      fprintf (file, "%d ", value < 0 ? -(int) eidx : (int) eidx);
+  }
+  fputs ("0\n", file);
+  write_eliminated_variables (solver, file);
+  const size_t clauses = write_witness_labelled_clauses (solver, file);
+  kissat_message (solver, "reconstruction stack has %zu clauses",
+                  clauses);
+  (void) clauses;
+  return !ferror (file) && !fflush (file);
+}
+
+static bool read_literal (FILE *file, int vars, int *res) {
+  return kissat_read_cached_int (file, res) && ABS (*res) <= vars;
+}
+
+// Follows 'extend_literal' in 'extend.c' where eliminated variables have
+// a positive position (in elimination order) and are initially unassigned.
+
+static void reconstruct_literal (const value *values,
+                                 const unsigned *positions, int elit,
+                                 bool *satisfied, int *eliminated,
+                                 unsigned *pos) {
+  const unsigned eidx = ABS (elit);
+  value value = values[eidx];
+  if (elit < 0)
+    value = -value;
+  if (value > 0)
+    *satisfied = true;
+  else if (!value && positions[eidx] &&
+           (!*eliminated || *pos < positions[eidx])) {
+    *eliminated = elit;
+    *pos = positions[eidx];
+  }
+}
+
+static const char *reconstruct (kissat *solver, FILE *file, int vars,
+                                int simplified, value *values,
+                                unsigned *positions) {
+  int elit;
+  for (int sidx = 1; sidx <= simplified; sidx++) {
+    if (!read_literal (file, vars, &elit) || elit <= 0 || values[elit])
+      return "invalid simplified variable";
+    values[elit] = kissat_value (solver, sidx) > 0 ? 1 : -1;
+  }
+  if (!read_literal (file, vars, &elit) || elit)
+    return "too many simplified variables";
+  for (;;) {
+    if (!read_literal (file, vars, &elit))
+      return "invalid fixed literal";
+    if (!elit)
+      break;
+    values[ABS (elit)] = elit < 0 ? -1 : 1;
+  }
+  unsigned eliminated = 0;
+  for (;;) {
+    if (!read_literal (file, vars, &elit) || elit < 0)
+      return "invalid eliminated variable";
+    if (!elit)
+      break;
+    if (values[elit] || positions[elit])
+      return "eliminated variable assigned";
+    positions[elit] = ++eliminated;
+  }
+  int ch;
+  while ((ch = getc (file)) != EOF) {
+    if (isspace (ch))
+      continue;
+    ungetc (ch, file);
+    int witness;
+    if (!read_literal (file, vars, &witness) || !witness ||
+        !positions[ABS (witness)])
+      return "invalid witness";
+    bool satisfied = false;
+    int unassigned = 0;
+    unsigned pos = 0;
+    elit = witness;
+    do {
+      reconstruct_literal (values, positions, elit, &satisfied,
+                           &unassigned, &pos);
+      if (!read_literal (file, vars, &elit))
+        return "invalid literal in witness labelled clause";
+    } while (elit);
+    if (satisfied)
+      continue;
+    if (!unassigned)
+      unassigned = witness;
+    values[ABS (unassigned)] = unassigned < 0 ? -1 : 1;
+  }
+  return 0;
+}
+
+const char *kissat_reconstruct (kissat *solver, FILE *file,
+                                int *max_var_ptr, ints *values) {
+  int max_var, vars, simplified;
+  if (fscanf (file, "kissat-reconstruction %d %d %d", &max_var, &vars,
+              &simplified) != 3 ||
+      max_var < 0 || max_var > EXTERNAL_MAX_VAR || vars < 0 ||
+      vars > EXTERNAL_MAX_VAR || simplified < 0 || simplified > vars)
+    return "invalid reconstruction header";
+  const size_t size = (size_t) MAX (max_var, vars) + 1;
+  value *evalues;
+  unsigned *positions;
+  CALLOC (evalues, size);
+  CALLOC (positions, size);
+  const char *error =
+      reconstruct (solver, file, vars, simplified, evalues, positions);
+  if (!error) {
+    CLEAR_STACK (*values);
+    PUSH_STACK (*values, 0);
+    for (int eidx = 1; eidx <= max_var; eidx++) {
+      const value value = evalues[eidx];
+      PUSH_STACK (*values, value < 0 ? -eidx : value > 0 ? eidx : 0);
+    }
+    *max_var_ptr = max_var;
+  }
+  DEALLOC (positions, size);
+  DEALLOC (evalues, size);
+  return error;
+}
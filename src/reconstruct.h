@@ -0,0 +1,37 @@
+#ifndef _reconstruct_h_INCLUDED
+#define _reconstruct_h_INCLUDED
+
+#include "stack.h"
+
+#include <stdbool.h>
+#include <stdio.h>
+
+// After preprocessing the remaining irredundant clauses can be written as
+// a simplified formula over the active variables, which are renumbered
+// consecutively.  The reconstruction file then holds everything needed to
+// map a model of the simplified formula back to the original variables:
+//
+//   kissat-reconstruction <max-var> <variables> <simplified-variables>
+//   <external variable of each simplified variable> 0
+//   <root-level fixed literals> 0
+//   <eliminated variables in the order they were eliminated> 0
+//   <witness> <other literals of witness labelled clause> 0
+//   ...
+//
+// where the witness labelled clauses of the 'extend' stack are listed in
+// the order in which they have to be processed during extension (thus
+// in reverse order of the stack), with compressed clauses expanded.
+
+struct kissat;
+
+bool kissat_write_simplified (struct kissat *, FILE *);
+bool kissat_write_reconstruction (struct kissat *, int max_var, FILE *);
+
+// Reads a reconstruction file and extends the model of the simplified
+// formula in the given solver to 'values[0..*max_var_ptr]' in the format
+// of 'kissat_model' for the original variables.
+
+const char *kissat_reconstruct (struct kissat *, FILE *, int *max_var_ptr,
+                                ints *values);
+
+#endif
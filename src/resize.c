@@ -58,6 +58,11 @@ void kissat_increase_size (kissat *solver, unsigned new_size) {
        FORMAT_BYTES (kissat_allocated (solver)), old_size, new_size);
 #endif
   CREALLOC_VARIABLE_INDEXED (assigned, assigned);
+#ifdef SPLIT_ASSIGNED
+  CREALLOC_VARIABLE_INDEXED (unsigned, assigned_levels);
+  CREALLOC_VARIABLE_INDEXED (unsigned, assigned_positions);
+  CREALLOC_VARIABLE_INDEXED (unsigned, assigned_reasons);
+#endif
   CREALLOC_VARIABLE_INDEXED (flags, flags);
   NREALLOC_VARIABLE_INDEXED (links, links);
 
@@ -87,6 +92,11 @@ void kissat_decrease_size (kissat *solver) {
 #endif
 
   NREALLOC_VARIABLE_INDEXED (assigned, assigned);
+#ifdef SPLIT_ASSIGNED
+  NREALLOC_VARIABLE_INDEXED (unsigned, assigned_levels);
+  NREALLOC_VARIABLE_INDEXED (unsigned, assigned_positions);
+  NREALLOC_VARIABLE_INDEXED (unsigned, assigned_reasons);
+#endif
   NREALLOC_VARIABLE_INDEXED (flags, flags);
   NREALLOC_VARIABLE_INDEXED (links, links);
 
@@ -109,7 +109,7 @@ static unsigned reuse_trail (kissat *solver) {
   return res;
 }
 
-void kissat_restart (kissat *solver) {
+int kissat_restart (kissat *solver) {
   START (restart);
   INC (restarts);
   ADD (restarts_levels, solver->level);
@@ -117,15 +117,20 @@ void kissat_restart (kissat *solver) {
     INC (stable_restarts);
   else
     INC (focused_restarts);
-  unsigned level = reuse_trail (solver);
+  const int *imported = kissat_poll_imported_clause (solver);
+  unsigned level = imported ? 0 : reuse_trail (solver);
   kissat_extremely_verbose (solver,
                             "restarting after %" PRIu64 " conflicts"
                             " (limit %" PRIu64 ")",
                             CONFLICTS, solver->limits.restart.conflicts);
   LOG ("restarting to level %u", level);
   kissat_backtrack_in_consistent_state (solver, level);
+  int res = 0;
+  if (imported)
+    res = kissat_import_clauses (solver, imported);
   if (!solver->stable)
     kissat_update_focused_restart_limit (solver);
   REPORT (1, 'R');
   STOP (restart);
+  return res;
 }
@@ -6,7 +6,7 @@
 struct kissat;
 
 bool kissat_restarting (struct kissat *);
-void kissat_restart (struct kissat *);
+int kissat_restart (struct kissat *);
 
 void kissat_update_focused_restart_limit (struct kissat *);
 
@@ -1,6 +1,7 @@
 #include "search.h"
 #include "analyze.h"
 #include "bump.h"
+#include "cache.h"
 #include "classify.h"
 #include "decide.h"
 #include "eliminate.h"
@@ -11,6 +12,7 @@
 #include "preprocess.h"
 #include "print.h"
 #include "probe.h"
+#include "propinitially.h"
 #include "propsearch.h"
 #include "reduce.h"
 #include "reluctant.h"
@@ -18,6 +20,8 @@
 #include "rephase.h"
 #include "report.h"
 #include "restart.h"
+#include "share.h"
+#include "snapshot.h"
 #include "terminate.h"
 #include "trail.h"
 #include "walk.h"
@@ -42,8 +46,7 @@ static void init_tiers (kissat *solver) {
   }
 }
 
-static void start_search (kissat *solver) {
-  START (search);
+static void init_search (kissat *solver) {
   INC (searches);
 
   bool stable = (GET_OPTION (stable) == 2);
@@ -69,6 +72,20 @@ static void start_search (kissat *solver) {
   unsigned seed = GET_OPTION (seed);
   solver->random = seed;
   LOG ("initialized random number generator with seed %u", seed);
+}
+
+// A search resumed from a snapshot (see 'snapshot.h') continues with the
+// restored limits, heuristics and random number generator.
+
+static void start_search (kissat *solver) {
+  START (search);
+
+  if (solver->resumed)
+    kissat_phase (solver, "search", GET (searches),
+                  "resuming %s search after %" PRIu64 " conflicts",
+                  (solver->stable ? "stable" : "focus"), CONFLICTS);
+  else
+    init_search (solver);
 
 #ifndef QUIET
   limits *limits = &solver->limits;
@@ -89,7 +106,7 @@ static void start_search (kissat *solver) {
         "starting search with decisions limited to %" PRIu64
         " and conflicts limited to %" PRIu64,
         limits->decisions, limits->conflicts);
-  if (stable) {
+  if (solver->stable) {
     START (stable);
     REPORT (0, '[');
   } else {
@@ -115,6 +132,8 @@ static void stop_search (kissat *solver) {
     solver->termination.flagged = 0;
   }
 
+  solver->resumed = false;
+
   if (solver->stable) {
     REPORT (0, ']');
     STOP (stable);
@@ -176,16 +195,32 @@ static bool searching (kissat *solver) {
   return true;
 }
 
+// Clauses which are already available (for instance read from a cache
+// file) are imported before lucky assignments and preprocessing.
+
+static int import_initial_clauses (kissat *solver) {
+  const int *imported = kissat_poll_imported_clause (solver);
+  if (!imported)
+    return 0;
+  int res = kissat_import_clauses (solver, imported);
+  if (!res && !kissat_initially_propagate (solver))
+    res = 20;
+  return res;
+}
+
 int kissat_search (kissat *solver) {
   REPORT (0, '*');
+  const bool resumed = solver->resumed;
   int res = 0;
   if (solver->inconsistent)
     res = 20;
-  if (!res && GET_OPTION (luckyearly))
+  if (!res)
+    res = import_initial_clauses (solver);
+  if (!res && !resumed && GET_OPTION (luckyearly))
     res = kissat_lucky (solver);
-  if (!res && kissat_preprocessing (solver))
+  if (!res && !resumed && kissat_preprocessing (solver))
     res = kissat_preprocess (solver);
-  if (!res && GET_OPTION (luckylate))
+  if (!res && !resumed && GET_OPTION (luckylate))
     res = kissat_lucky (solver);
   if (!res)
     kissat_classify (solver);
@@ -193,8 +228,12 @@ int kissat_search (kissat *solver) {
     start_search (solver);
     while (!res) {
       clause *conflict = kissat_search_propagate (solver);
+      if (!conflict && solver->propagator.connected)
+        conflict = kissat_external_propagate (solver);
       if (conflict)
         res = kissat_analyze (solver, conflict);
+      else if (solver->inconsistent)
+        res = 20;
       else if (solver->iterating)
         iterate (solver);
       else if (!solver->unassigned)
@@ -206,7 +245,7 @@ int kissat_search (kissat *solver) {
       else if (kissat_switching_search_mode (solver))
         kissat_switch_search_mode (solver);
       else if (kissat_restarting (solver))
-        kissat_restart (solver);
+        res = kissat_restart (solver);
       else if (kissat_reordering (solver))
         kissat_reorder (solver);
       else if (kissat_rephasing (solver))
@@ -215,6 +254,10 @@ int kissat_search (kissat *solver) {
         res = kissat_probe (solver);
       else if (kissat_eliminating (solver))
         res = kissat_eliminate (solver);
+      else if (kissat_flushing_cache (solver))
+        kissat_flush_cache (solver);
+      else if (kissat_checkpointing (solver))
+        kissat_checkpoint (solver);
       else if (conflict_limit_hit (solver))
         break;
       else if (decision_limit_hit (solver))
@@ -222,6 +265,8 @@ int kissat_search (kissat *solver) {
       else
         kissat_decide (solver);
     }
+    if (!res && solver->checkpoint.write)
+      kissat_checkpoint (solver);
     stop_search (solver);
   }
   report_search_result (solver, res);
@@ -0,0 +1,174 @@
+#include "share.h"
+#include "inline.h"
+#include "logging.h"
+
+// Units are exported independently of 'max_size' and 'max_glue' through
+// 'kissat_learned_unit', which covers units learned during conflict
+// analysis as well as those derived by failed literal probing, backbone
+// computation, tree-look-ahead, equivalent literal substitution etc.
+
+void kissat_export_learned_unit (kissat *solver, unsigned unit) {
+  sharing *sharing = &solver->sharing;
+  assert (sharing->export);
+  if (sharing->importing)
+    return;
+  const int elit = kissat_export_literal (solver, unit);
+  if (!elit)
+    return;
+  const import *const imports = BEGIN_STACK (solver->import);
+  if (imports[ABS (elit)].extension) {
+    LOG ("learned unit with extension variable not exported");
+    return;
+  }
+  const int unit_clause[2] = {elit, 0};
+  LOG ("exporting learned unit %d", elit);
+  INC (clauses_exported);
+  sharing->export (sharing->export_state, unit_clause);
+}
+
+void kissat_export_learned_clause (kissat *solver, unsigned glue) {
+  sharing *sharing = &solver->sharing;
+  assert (sharing->export);
+  const unsigned size = SIZE_STACK (solver->clause);
+  assert (size > 1);
+  if (size > sharing->max_size)
+    return;
+  if (glue > sharing->max_glue)
+    return;
+  ints *exported = &sharing->exported;
+  assert (EMPTY_STACK (*exported));
+  const import *const imports = BEGIN_STACK (solver->import);
+  for (all_stack (unsigned, ilit, solver->clause)) {
+    const int elit = kissat_export_literal (solver, ilit);
+    if (!elit || imports[ABS (elit)].extension) {
+      LOG ("learned clause with extension variable not exported");
+      CLEAR_STACK (*exported);
+      return;
+    }
+    PUSH_STACK (*exported, elit);
+  }
+  PUSH_STACK (*exported, 0);
+  LOGINTS (size, BEGIN_STACK (*exported), "exporting learned");
+  INC (clauses_exported);
+  sharing->export (sharing->export_state, BEGIN_STACK (*exported));
+  CLEAR_STACK (*exported);
+}
+
+const int *kissat_poll_imported_clause (kissat *solver) {
+  sharing *sharing = &solver->sharing;
+  if (!sharing->import)
+    return 0;
+  return sharing->import (sharing->import_state);
+}
+
+// Maps the external clause to internal literals on 'solver->clause' while
+// removing root-level falsified and duplicated literals.  Returns 'false'
+// if the clause is satisfied, tautological or contains variables which
+// are unknown, eliminated or extension variables and should be skipped.
+
+static bool import_external_clause (kissat *solver, const int *elits) {
+  assert (EMPTY_STACK (solver->clause));
+  const import *const imports = BEGIN_STACK (solver->import);
+  const unsigned imported = SIZE_STACK (solver->import);
+  const value *const values = solver->values;
+  const flags *const flags = solver->flags;
+  mark *const marks = solver->marks;
+  bool res = true;
+  for (const int *p = elits; res && *p; p++) {
+    const int elit = *p;
+    if (elit == INT_MIN) {
+      res = false;
+      break;
+    }
+    const unsigned eidx = ABS (elit);
+    if (eidx >= imported) {
+      res = false;
+      break;
+    }
+    const import *const import = imports + eidx;
+    if (!import->imported || import->eliminated || import->extension) {
+      res = false;
+      break;
+    }
+    unsigned ilit = import->lit;
+    if (elit < 0)
+      ilit = NOT (ilit);
+    const value value = values[ilit];
+    if (value > 0) {
+      res = false;
+      break;
+    }
+    if (value < 0)
+      continue;
+    if (!flags[IDX (ilit)].active) {
+      res = false;
+      break;
+    }
+    const int mark = marks[ilit];
+    if (mark > 0)
+      continue;
+    if (mark < 0) {
+      res = false;
+      break;
+    }
+    marks[ilit] = 1;
+    marks[NOT (ilit)] = -1;
+    PUSH_STACK (solver->clause, ilit);
+  }
+  for (all_stack (unsigned, ilit, solver->clause))
+    marks[ilit] = marks[NOT (ilit)] = 0;
+  if (!res)
+    CLEAR_STACK (solver->clause);
+  return res;
+}
+
+static int import_clause (kissat *solver, const int *elits) {
+  if (!import_external_clause (solver, elits)) {
+    INC (clauses_rejected);
+    return 0;
+  }
+  INC (clauses_imported);
+#ifndef NDEBUG
+  if (GET_OPTION (check) > 1) {
+    size_t size = 0;
+    while (elits[size])
+      size++;
+    ADD_UNCHECKED_EXTERNAL (size, elits);
+  }
+#endif
+  int res = 0;
+  const unsigned size = SIZE_STACK (solver->clause);
+  if (!size) {
+    LOG ("imported empty clause");
+    solver->inconsistent = true;
+    CHECK_AND_ADD_EMPTY ();
+    ADD_EMPTY_TO_PROOF ();
+    res = 20;
+  } else if (size == 1) {
+    const unsigned unit = PEEK_STACK (solver->clause, 0);
+    LOG ("imported unit clause %s", LOGLIT (unit));
+    sharing *sharing = &solver->sharing;
+    sharing->importing = true;
+    kissat_learned_unit (solver, unit);
+    sharing->importing = false;
+  } else {
+    const reference ref = kissat_new_redundant_clause (solver, size - 1);
+    if (ref != INVALID_REF) {
+      clause *c = kissat_dereference_clause (solver, ref);
+      c->used = MAX_USED;
+    }
+  }
+  CLEAR_STACK (solver->clause);
+  return res;
+}
+
+int kissat_import_clauses (kissat *solver, const int *first) {
+  assert (!solver->level);
+  assert (first);
+  sharing *sharing = &solver->sharing;
+  int res = 0;
+  for (const int *elits = first; !res && elits;
+       elits = sharing->import (sharing->import_state))
+    res = import_clause (solver, elits);
+  return res;
+}
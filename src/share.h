@@ -0,0 +1,32 @@
+#ifndef _share_h_INCLUDED
+#define _share_h_INCLUDED
+
+#include "stack.h"
+
+#include <stdbool.h>
+
+// Learned clauses can be exported to and external clauses imported from
+// other solvers through user provided callbacks (see 'kissat.h').  Clauses
+// are exchanged as zero-terminated arrays of external literals.
+
+typedef struct sharing sharing;
+
+struct sharing {
+  void *export_state;
+  void (*export) (void *, const int *);
+  unsigned max_size, max_glue;
+  bool importing;
+  ints exported;
+
+  void *import_state;
+  const int *(*import) (void *);
+};
+
+struct kissat;
+
+void kissat_export_learned_unit (struct kissat *, unsigned unit);
+void kissat_export_learned_clause (struct kissat *, unsigned glue);
+const int *kissat_poll_imported_clause (struct kissat *);
+int kissat_import_clauses (struct kissat *, const int *first);
+
+#endif
@@ -51,8 +51,9 @@ static inline int shrink_literal (kissat *solver, assigned *assigned,
 
   const unsigned idx = IDX (lit);
   struct assigned *a = assigned + idx;
-  assert (a->level <= level);
-  if (!a->level) {
+  const unsigned lit_level = ASSIGNED_LEVEL (assigned, idx);
+  assert (lit_level <= level);
+  if (!lit_level) {
     LOG2 ("skipping root level assigned %s", LOGLIT (lit));
     return 0;
   }
@@ -60,7 +61,7 @@ static inline int shrink_literal (kissat *solver, assigned *assigned,
     LOG2 ("skipping already shrinkable literal %s", LOGLIT (lit));
     return 0;
   }
-  if (a->level < level) {
+  if (lit_level < level) {
     if (a->removable) {
       LOG2 ("skipping removable thus shrinkable %s", LOGLIT (lit));
       return 0;
@@ -72,7 +73,7 @@ static inline int shrink_literal (kissat *solver, assigned *assigned,
       return 0;
     }
     LOG ("literal %s on lower level %u < %u not removable/shrinkable",
-         LOGLIT (lit), a->level, level);
+         LOGLIT (lit), lit_level, level);
     return -1;
   }
   LOG2 ("marking %s as shrinkable", LOGLIT (lit));
@@ -202,13 +203,14 @@ static inline unsigned shrink_along_reason (kissat *solver,
   const unsigned uip_idx = IDX (uip);
   struct assigned *a = assigned + uip_idx;
   assert (a->shrinkable);
-  assert (a->level == level);
-  assert (a->reason != DECISION_REASON);
+  assert (ASSIGNED_LEVEL (assigned, uip_idx) == level);
+  const unsigned reason = ASSIGNED_REASON (assigned, uip_idx);
+  assert (reason != DECISION_REASON);
   if (a->binary) {
-    const unsigned other = a->reason;
+    const unsigned other = reason;
     open = shrink_along_binary (solver, assigned, level, uip, other);
   } else {
-    reference ref = a->reason;
+    reference ref = reason;
     if (resolve_large_clauses)
       open = shrink_along_large (solver, assigned, level, uip, ref,
                                  failed_ptr);
@@ -282,8 +284,7 @@ static unsigned *next_block (kissat *solver, unsigned *begin_lits,
     const unsigned lit = begin_block[-1];
     assert (lit != INVALID_LIT);
     const unsigned idx = IDX (lit);
-    struct assigned *a = assigned + idx;
-    unsigned lit_level = a->level;
+    unsigned lit_level = ASSIGNED_LEVEL (assigned, idx);
     if (level == INVALID_LEVEL) {
       level = lit_level;
       LOG ("starting to shrink level %u", level);
@@ -293,7 +294,7 @@ static unsigned *next_block (kissat *solver, unsigned *begin_lits,
         break;
     }
     begin_block--;
-    const unsigned trail = a->trail;
+    const unsigned trail = ASSIGNED_TRAIL (assigned, idx);
     if (trail > max_trail)
       max_trail = trail;
   }
@@ -0,0 +1,469 @@
+#include "snapshot.h"
+#include "backtrack.h"
+#include "error.h"
+#include "inline.h"
+#include "print.h"
+#include "require.h"
+#include "resize.h"
+#include "resources.h"
+
+#include <inttypes.h>
+#include <string.h>
+
+#define SNAPSHOT_MAGIC "kissnap"
+
+// Members of the solver saved as raw bytes.
+
+#define SNAPSHOT_FIELDS \
+  RAW_FIELD (stable) \
+  RAW_FIELD (active) \
+  RAW_FIELD (randec) \
+  RAW_FIELD (queue) \
+  RAW_FIELD (scinc) \
+  RAW_FIELD (best_assigned) \
+  RAW_FIELD (target_assigned) \
+  RAW_FIELD (unflushed) \
+  RAW_FIELD (unassigned) \
+  RAW_FIELD (first_reducible) \
+  RAW_FIELD (last_irredundant) \
+  RAW_FIELD (random) \
+  RAW_FIELD (averages) \
+  RAW_FIELD (tier1) \
+  RAW_FIELD (tier2) \
+  RAW_FIELD (reluctant) \
+  RAW_FIELD (bandit) \
+  RAW_FIELD (bounds) \
+  RAW_FIELD (classification) \
+  RAW_FIELD (delays) \
+  RAW_FIELD (enabled) \
+  RAW_FIELD (limits) \
+  RAW_FIELD (payoffs) \
+  RAW_FIELD (last) \
+  RAW_FIELD (walked) \
+  RAW_FIELD (mode) \
+  RAW_FIELD (ticks) \
+  RAW_FIELD (sweep_incomplete) \
+  RAW_FIELD (closure_imported) \
+  RAW_FIELD (statistics)
+
+// Stacks of the solver saved with their size.
+
+#define SNAPSHOT_STACKS \
+  STACK_FIELD (export) \
+  STACK_FIELD (units) \
+  STACK_FIELD (import) \
+  STACK_FIELD (extend) \
+  STACK_FIELD (compressed) \
+  STACK_FIELD (eliminated) \
+  STACK_FIELD (etrail) \
+  STACK_FIELD (sweep_schedule) \
+  STACK_FIELD (closure)
+
+#define MAX_LAYOUT 64
+
+static uint32_t snapshot_layout (kissat *solver, uint32_t *sizes) {
+  uint32_t count = 0;
+#define RAW_FIELD(NAME) sizes[count++] = sizeof solver->NAME;
+  SNAPSHOT_FIELDS
+#undef RAW_FIELD
+#define STACK_FIELD(NAME) sizes[count++] = sizeof *solver->NAME.begin;
+  SNAPSHOT_STACKS
+#undef STACK_FIELD
+  sizes[count++] = sizeof (assigned);
+#ifdef SPLIT_ASSIGNED
+  sizes[count++] = sizeof *solver->assigned_levels;
+#else
+  sizes[count++] = 0;
+#endif
+  sizes[count++] = sizeof (flags);
+  sizes[count++] = sizeof (links);
+  sizes[count++] = sizeof (value);
+  sizes[count++] = sizeof (ward);
+  assert (count <= MAX_LAYOUT);
+  return count;
+}
+
+/*------------------------------------------------------------------------*/
+
+static void write_bytes (FILE *file, const void *ptr, size_t bytes) {
+  if (bytes)
+    fwrite (ptr, 1, bytes, file);
+}
+
+#define WRITE(PTR, BYTES) write_bytes (file, (PTR), (BYTES))
+#define WRITE_VALUE(V) WRITE (&(V), sizeof (V))
+#define WRITE_ARRAY(PTR, N) WRITE ((PTR), (N) * sizeof *(PTR))
+
+#define WRITE_STACK(S) \
+  do { \
+    const uint64_t SIZE = SIZE_STACK (S); \
+    WRITE_VALUE (SIZE); \
+    WRITE_ARRAY (BEGIN_STACK (S), SIZE); \
+  } while (0)
+
+static void write_variables (kissat *solver, FILE *file) {
+  const unsigned vars = VARS;
+  WRITE_ARRAY (solver->assigned, vars);
+#ifdef SPLIT_ASSIGNED
+  WRITE_ARRAY (solver->assigned_levels, vars);
+  WRITE_ARRAY (solver->assigned_positions, vars);
+  WRITE_ARRAY (solver->assigned_reasons, vars);
+#endif
+  WRITE_ARRAY (solver->flags, vars);
+  WRITE_ARRAY (solver->links, vars);
+  WRITE_ARRAY (solver->values, 2 * vars);
+  WRITE_ARRAY (solver->phases.best, vars);
+  WRITE_ARRAY (solver->phases.saved, vars);
+  WRITE_ARRAY (solver->phases.target, vars);
+}
+
+static void write_heap (heap *heap, FILE *file) {
+  WRITE_VALUE (heap->tainted);
+  WRITE_VALUE (heap->vars);
+  WRITE_ARRAY (heap->score, heap->vars);
+  WRITE_ARRAY (heap->pos, heap->vars);
+  WRITE_STACK (heap->stack);
+}
+
+// Binary clauses only exist as watches and are saved explicitly.
+
+static void write_binaries (kissat *solver, FILE *file) {
+  uint64_t binaries = 0;
+  for (all_literals (lit))
+    for (all_binary_blocking_watches (watch, WATCHES (lit)))
+      if (watch.type.binary && lit < watch.binary.lit)
+        binaries++;
+  WRITE_VALUE (binaries);
+  for (all_literals (lit))
+    for (all_binary_blocking_watches (watch, WATCHES (lit)))
+      if (watch.type.binary && lit < watch.binary.lit) {
+        const litpair pair = kissat_litpair (lit, watch.binary.lit);
+        WRITE_VALUE (pair);
+      }
+}
+
+bool kissat_write_snapshot (kissat *solver, FILE *file) {
+  assert (!solver->level);
+  assert (!solver->inconsistent);
+  assert (kissat_propagated (solver));
+  assert (solver->watching);
+  uint32_t sizes[MAX_LAYOUT];
+  const uint32_t count = snapshot_layout (solver, sizes);
+  const uint32_t version = SNAPSHOT_VERSION;
+  WRITE (SNAPSHOT_MAGIC, sizeof SNAPSHOT_MAGIC);
+  WRITE_VALUE (version);
+  WRITE_VALUE (count);
+  WRITE_ARRAY (sizes, count);
+  WRITE_VALUE (solver->original_hash);
+  WRITE_VALUE (solver->vars);
+#define RAW_FIELD(NAME) WRITE_VALUE (solver->NAME);
+  SNAPSHOT_FIELDS
+#undef RAW_FIELD
+#define STACK_FIELD(NAME) WRITE_STACK (solver->NAME);
+  SNAPSHOT_STACKS
+#undef STACK_FIELD
+  write_variables (solver, file);
+  write_heap (SCORES, file);
+  WRITE_STACK (solver->trail);
+  WRITE_STACK (solver->arena);
+  write_binaries (solver, file);
+  WRITE (SNAPSHOT_MAGIC, sizeof SNAPSHOT_MAGIC);
+  LOG ("wrote snapshot of %u variables after %" PRIu64 " conflicts",
+       solver->vars, CONFLICTS);
+  return !ferror (file);
+}
+
+/*------------------------------------------------------------------------*/
+
+static bool read_bytes (FILE *file, void *ptr, size_t bytes) {
+  return !bytes || fread (ptr, 1, bytes, file) == bytes;
+}
+
+#define READ(PTR, BYTES) \
+  do { \
+    if (!read_bytes (file, (PTR), (BYTES))) \
+      return "truncated snapshot"; \
+  } while (0)
+
+#define READ_VALUE(V) READ (&(V), sizeof (V))
+#define READ_ARRAY(PTR, N) READ ((PTR), (N) * sizeof *(PTR))
+
+#define READ_STACK(S) \
+  do { \
+    uint64_t SIZE; \
+    READ_VALUE (SIZE); \
+    CLEAR_STACK (S); \
+    while (CAPACITY_STACK (S) < SIZE) \
+      ENLARGE_STACK (S); \
+    READ_ARRAY (BEGIN_STACK (S), SIZE); \
+    (S).end = BEGIN_STACK (S) + SIZE; \
+  } while (0)
+
+static const char *read_header (kissat *solver, FILE *file) {
+  char magic[sizeof SNAPSHOT_MAGIC];
+  READ (magic, sizeof magic);
+  if (memcmp (magic, SNAPSHOT_MAGIC, sizeof magic))
+    return "invalid snapshot header";
+  uint32_t version;
+  READ_VALUE (version);
+  if (version != SNAPSHOT_VERSION)
+    return "unsupported snapshot version";
+  uint32_t expected[MAX_LAYOUT], sizes[MAX_LAYOUT];
+  const uint32_t expected_count = snapshot_layout (solver, expected);
+  uint32_t count;
+  READ_VALUE (count);
+  if (count != expected_count)
+    return "snapshot written by incompatible build";
+  READ_ARRAY (sizes, count);
+  if (memcmp (sizes, expected, count * sizeof *sizes))
+    return "snapshot written by incompatible build";
+  uint64_t hash;
+  READ_VALUE (hash);
+  if (hash != solver->original_hash)
+    return "snapshot of different formula";
+  return 0;
+}
+
+#ifdef LOGGING
+
+// Smoothed averages have names for logging, which are pointers.
+
+static void fix_average_names (averages *averages) {
+#define FIX_NAME(EMA) averages->EMA.name = #EMA
+  FIX_NAME (level);
+  FIX_NAME (size);
+  FIX_NAME (trail);
+  FIX_NAME (fast_glue);
+  FIX_NAME (slow_glue);
+  FIX_NAME (decision_rate);
+#undef FIX_NAME
+}
+
+#endif
+
+// Allocation metrics and limits set through the API before resuming are
+// kept.  The latter are interpreted relative to the restored counters.
+
+static const char *read_fields (kissat *solver, FILE *file) {
+  const uint64_t conflicts = solver->limits.conflicts - CONFLICTS;
+  const uint64_t decisions =
+      solver->limits.decisions - solver->statistics.decisions;
+#ifdef METRICS
+  const uint64_t allocated_collected = GET (allocated_collected);
+  const uint64_t allocated_current = GET (allocated_current);
+  const uint64_t allocated_max = GET (allocated_max);
+#endif
+#define RAW_FIELD(NAME) READ_VALUE (solver->NAME);
+  SNAPSHOT_FIELDS
+#undef RAW_FIELD
+#ifdef METRICS
+  solver->statistics.allocated_collected = allocated_collected;
+  solver->statistics.allocated_current = allocated_current;
+  solver->statistics.allocated_max = allocated_max;
+#endif
+  if (solver->limited.conflicts)
+    solver->limits.conflicts = CONFLICTS + conflicts;
+  if (solver->limited.decisions)
+    solver->limits.decisions = solver->statistics.decisions + decisions;
+#ifdef LOGGING
+  fix_average_names (&solver->averages[0]);
+  fix_average_names (&solver->averages[1]);
+#endif
+#ifndef QUIET
+  solver->mode.entered = kissat_process_time ();
+#endif
+  kissat_reset_last_learned (solver);
+  return 0;
+}
+
+// All variable indexed arrays are resized to exactly the number of
+// variables in the snapshot, which drops the watches and the trail.
+
+static void resize_variables (kissat *solver, unsigned vars) {
+  kissat_release_vectors (solver);
+  CLEAR_ARRAY (solver->trail);
+  kissat_reset_propagate (solver);
+  if (vars > solver->size)
+    kissat_increase_size (solver, vars);
+  solver->vars = vars;
+  if (solver->size > vars)
+    kissat_decrease_size (solver);
+  memset (solver->watches, 0, LITS * sizeof (watches));
+}
+
+static const char *read_variables (kissat *solver, FILE *file) {
+  const unsigned vars = VARS;
+  READ_ARRAY (solver->assigned, vars);
+#ifdef SPLIT_ASSIGNED
+  READ_ARRAY (solver->assigned_levels, vars);
+  READ_ARRAY (solver->assigned_positions, vars);
+  READ_ARRAY (solver->assigned_reasons, vars);
+#endif
+  READ_ARRAY (solver->flags, vars);
+  READ_ARRAY (solver->links, vars);
+  READ_ARRAY (solver->values, 2 * vars);
+  READ_ARRAY (solver->phases.best, vars);
+  READ_ARRAY (solver->phases.saved, vars);
+  READ_ARRAY (solver->phases.target, vars);
+  return 0;
+}
+
+static const char *read_heap (kissat *solver, heap *heap, FILE *file) {
+  kissat_release_heap (solver, heap);
+  kissat_resize_heap (solver, heap, solver->size);
+  READ_VALUE (heap->tainted);
+  READ_VALUE (heap->vars);
+  if (heap->vars > solver->vars)
+    return "invalid number of scores";
+  READ_ARRAY (heap->score, heap->vars);
+  READ_ARRAY (heap->pos, heap->vars);
+  READ_STACK (heap->stack);
+  if (SIZE_STACK (heap->stack) > heap->vars)
+    return "invalid scores heap";
+  return 0;
+}
+
+static const char *read_trail (kissat *solver, FILE *file) {
+  uint64_t size;
+  READ_VALUE (size);
+  if (size > VARS)
+    return "invalid trail";
+  READ_ARRAY (BEGIN_ARRAY (solver->trail), size);
+  solver->trail.end = BEGIN_ARRAY (solver->trail) + size;
+  solver->propagate = END_ARRAY (solver->trail);
+  return 0;
+}
+
+static const char *read_arena (kissat *solver, FILE *file) {
+  uint64_t size;
+  READ_VALUE (size);
+  if (size > MAX_ARENA)
+    return "invalid arena size";
+  CLEAR_STACK (solver->arena);
+  kissat_reserve_arena (solver, size);
+  READ_ARRAY (BEGIN_STACK (solver->arena), size);
+  solver->arena.end = BEGIN_STACK (solver->arena) + size;
+  return 0;
+}
+
+static const char *read_binaries (kissat *solver, FILE *file) {
+  uint64_t binaries;
+  READ_VALUE (binaries);
+  watches *watches = solver->watches;
+  while (binaries--) {
+    litpair pair;
+    READ_VALUE (pair);
+    const unsigned lit = pair.lits[0], other = pair.lits[1];
+    if (lit >= other || other >= LITS)
+      return "invalid binary clause";
+    kissat_push_binary_watch (solver, watches + lit, other);
+    kissat_push_binary_watch (solver, watches + other, lit);
+  }
+  return 0;
+}
+
+#ifndef NDEBUG
+
+// The checker only knows the original clauses of the formula and thus
+// the root-level units (which might have been flushed from the trail)
+// and the clauses of the snapshot are added without checking them.
+
+static void check_snapshot_clauses (kissat *solver) {
+  if (GET_OPTION (check) < 2)
+    return;
+  const value *const values = solver->values;
+  for (all_literals (lit))
+    if (values[lit] > 0)
+      kissat_add_unchecked_internal (solver, 1, &lit);
+  for (all_literals (lit))
+    for (all_binary_blocking_watches (watch, WATCHES (lit)))
+      if (watch.type.binary && lit < watch.binary.lit) {
+        unsigned lits[2] = {lit, watch.binary.lit};
+        kissat_add_unchecked_internal (solver, 2, lits);
+      }
+  for (all_clauses (c))
+    if (!c->garbage)
+      kissat_add_unchecked_internal (solver, c->size, c->lits);
+}
+
+#endif
+
+#define TRY(CALL) \
+  do { \
+    const char *error = (CALL); \
+    if (error) \
+      return error; \
+  } while (0)
+
+const char *kissat_read_snapshot (kissat *solver, FILE *file) {
+  kissat_require_initialized (solver);
+  kissat_require (!GET (searches), "can only resume before solving");
+  kissat_require (!solver->propagator.connected,
+                  "can not resume with connected propagator");
+#ifndef NPROOFS
+  if (solver->proof)
+    return "can not resume while writing a proof";
+#endif
+  if (solver->inconsistent)
+    return "formula already inconsistent";
+  assert (!solver->level);
+  TRY (read_header (solver, file));
+  unsigned vars;
+  READ_VALUE (vars);
+  if (vars > INTERNAL_MAX_VAR + 1)
+    return "invalid number of variables";
+  TRY (read_fields (solver, file));
+#define STACK_FIELD(NAME) READ_STACK (solver->NAME);
+  SNAPSHOT_STACKS
+#undef STACK_FIELD
+  resize_variables (solver, vars);
+  TRY (read_variables (solver, file));
+  TRY (read_heap (solver, SCORES, file));
+  TRY (read_trail (solver, file));
+  TRY (read_arena (solver, file));
+  TRY (read_binaries (solver, file));
+  char magic[sizeof SNAPSHOT_MAGIC];
+  READ (magic, sizeof magic);
+  if (memcmp (magic, SNAPSHOT_MAGIC, sizeof magic))
+    return "invalid snapshot trailer";
+  kissat_watch_large_clauses (solver);
+#ifndef NDEBUG
+  check_snapshot_clauses (solver);
+#endif
+  solver->resumed = true;
+  kissat_message (solver,
+                  "resuming %s search with %u variables after %" PRIu64
+                  " conflicts",
+                  solver->stable ? "stable" : "focused", solver->vars,
+                  CONFLICTS);
+  return 0;
+}
+
+/*------------------------------------------------------------------------*/
+
+bool kissat_checkpointing (kissat *solver) {
+  const checkpoint *const checkpoint = &solver->checkpoint;
+  if (!checkpoint->write)
+    return false;
+  if (checkpoint->requested)
+    return true;
+  return solver->statistics.search_ticks >=
+         solver->limits.checkpoint.ticks;
+}
+
+void kissat_checkpoint (kissat *solver) {
+  checkpoint *checkpoint = &solver->checkpoint;
+  assert (checkpoint->write);
+  assert (kissat_propagated (solver));
+  checkpoint->requested = false;
+  INC (checkpoints);
+  if (solver->level)
+    kissat_backtrack_in_consistent_state (solver, 0);
+  const uint64_t delta = 1e6 * GET_OPTION (checkpointint);
+  solver->limits.checkpoint.ticks = solver->statistics.search_ticks + delta;
+  kissat_very_verbose (solver,
+                       "checkpoint %" PRIu64 " after %" PRIu64
+                       " conflicts",
+                       solver->statistics.checkpoints, CONFLICTS);
+  checkpoint->write (checkpoint->state);
+}
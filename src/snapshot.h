@@ -0,0 +1,45 @@
+#ifndef _snapshot_h_INCLUDED
+#define _snapshot_h_INCLUDED
+
+#include <stdbool.h>
+#include <stdio.h>
+
+// A snapshot is a binary image of the complete solver state taken at the
+// root level during search.  It starts with the magic string 'kissnap',
+// the format version and the sizes of all data structures stored as raw
+// bytes (which differ between builds), followed by the hash of the
+// original clauses (see 'cache.h').  Then the number of variables, the
+// import, export and extension stacks, all per-variable data (flags,
+// assignments, phases, queue links and scores), the trail of root-level
+// units, the arena, the binary clauses, statistics, limits and the state
+// of heuristics follow.  Watches are rebuilt when a snapshot is read.
+// Snapshots are only read by the same build for the same formula, which
+// has to be added before, and replace the whole state of the solver
+// except for options, limits set through the API and callbacks.  After a
+// failure the solver can only be released.
+
+#define SNAPSHOT_VERSION 1
+
+typedef struct checkpoint checkpoint;
+
+// During search the checkpoint callback (see 'kissat_set_checkpoint') is
+// called every 'checkpointint' mega search ticks, if requested through
+// 'kissat_request_checkpoint' and when search is interrupted.  Before it
+// is called the solver backtracks to the root level such that the
+// callback can write a snapshot.
+
+struct checkpoint {
+  volatile bool requested;
+  void *state;
+  void (*write) (void *);
+};
+
+struct kissat;
+
+bool kissat_checkpointing (struct kissat *);
+void kissat_checkpoint (struct kissat *);
+
+bool kissat_write_snapshot (struct kissat *, FILE *);
+const char *kissat_read_snapshot (struct kissat *, FILE *);
+
+#endif
@@ -19,7 +19,7 @@ move_smallest_literal_to_front (kissat *solver, const value *const values,
 
   {
     const unsigned i = IDX (a);
-    unsigned k = (u ? assigned[i].level : UINT_MAX);
+    unsigned k = (u ? ASSIGNED_LEVEL (assigned, i) : UINT_MAX);
 
     assert (start < UINT_MAX);
     for (unsigned i = start + 1; i < size; i++) {
@@ -34,7 +34,7 @@ move_smallest_literal_to_front (kissat *solver, const value *const values,
       }
 
       const unsigned j = IDX (b);
-      const unsigned l = (v ? assigned[j].level : UINT_MAX);
+      const unsigned l = (v ? ASSIGNED_LEVEL (assigned, j) : UINT_MAX);
 
       bool better;
 
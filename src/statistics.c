@@ -81,6 +81,12 @@ kissat_statistics_print (kissat * solver, bool verbose)
 #define PER_CLS_UNFACTORED(NAME) \
   RELATIVE (NAME, clauses_unfactored)
 
+#define PER_COMPRESSED_CLAUSE(NAME) \
+  RELATIVE (NAME, weakened_compressed)
+
+#define PER_COMPRESSED_LITERAL(NAME) \
+  RELATIVE (NAME, weakened_compressed_literals)
+
 #define PER_CONFLICT(NAME) \
   RELATIVE (NAME, conflicts)
 
@@ -113,6 +119,9 @@ kissat_statistics_print (kissat * solver, bool verbose)
 #define PER_FORWARD_CHECK(NAME) \
   RELATIVE (NAME, forward_checks)
 
+#define PER_IMPLICATIONS(NAME) \
+  RELATIVE (NAME, implications_built)
+
 #define PER_KITTEN_PROP(NAME) \
   RELATIVE (NAME, kitten_propagations)
 
@@ -158,6 +167,9 @@ kissat_statistics_print (kissat * solver, bool verbose)
 #define PCNT_ARENA_RESIZED(NAME) \
   PERCENT (NAME, arena_resized)
 
+#define PCNT_BACKBONE_CANDIDATES(NAME) \
+  PERCENT (NAME, backbone_candidates)
+
 #define PCNT_CLS_ADDED(NAME) \
   PERCENT (NAME, clauses_added)
 
@@ -170,6 +182,9 @@ kissat_statistics_print (kissat * solver, bool verbose)
 #define PCNT_CLS_FACTORED(NAME) \
   PERCENT (NAME, clauses_factored)
 
+#define PCNT_CLS_IMPORTED(NAME) \
+  PERCENT (NAME, clauses_imported)
+
 #define PCNT_CLS_LEARNED(NAME) \
   PERCENT (NAME, clauses_learned)
 
@@ -293,6 +308,9 @@ kissat_statistics_print (kissat * solver, bool verbose)
 #define PCNT_SWEEP_SOLVED(NAME) \
   PERCENT (NAME, sweep_solved)
 
+#define PCNT_SWITCHED(NAME) \
+  PERCENT (NAME, switched)
+
 #ifndef STATISTICS
 #define PCNT_TICKS(NAME) \
   -1
@@ -301,9 +319,21 @@ kissat_statistics_print (kissat * solver, bool verbose)
   PERCENT (NAME, ticks)
 #endif
 
+#define PCNT_TRANSITIVE(NAME) \
+  PERCENT (NAME, transitive_reductions)
+
+#define PCNT_TREELOOK_HBRS(NAME) \
+  PERCENT (NAME, treelook_hbrs)
+
 #define PCNT_VARIABLES(NAME) \
   kissat_percent (statistics->NAME, variables)
 
+#define PCNT_VECTORS_MOVED(NAME) \
+  PERCENT (NAME, vectors_moved)
+
+#define PCNT_VECTORS_REUSED(NAME) \
+  PERCENT (NAME, vectors_reused)
+
 #define PCNT_VIVIFIED(NAME) \
   PERCENT (NAME, vivified)
 
@@ -328,6 +358,9 @@ kissat_statistics_print (kissat * solver, bool verbose)
 #define PCNT_WALKS(NAME) \
   PERCENT (NAME, walks)
 
+#define PCNT_WEAKENED(NAME) \
+  PERCENT (NAME, weakened)
+
 #define COUNTER(NAME,VERBOSE,OTHER,UNITS,TYPE) \
   if (verbose || !VERBOSE || (VERBOSE == 1 && statistics->NAME)) \
     PRINT_STAT (#NAME, statistics->NAME, OTHER(NAME), UNITS, TYPE);
@@ -17,19 +17,28 @@
   METRIC (arena_garbage, 1, PCNT_RESIDENT_SET, "%", "resident set") \
   METRIC (arena_resized, 1, CONF_INT, "", "interval") \
   METRIC (arena_shrunken, 1, PCNT_ARENA_RESIZED, "%", "resize") \
+  STATISTIC (backbone_candidates, 1, PCNT_VARIABLES, "%", "variables") \
   COUNTER (backbone_computations, 2, CONF_INT, "", "interval") \
+  STATISTIC (backbone_flipped, 1, PCNT_BACKBONE_CANDIDATES, "%", "candidates") \
   METRIC (backbone_implied, 1, PER_BACKBONE_UNIT, 0, "per unit") \
+  STATISTIC (backbone_literals, 1, PCNT_BACKBONE_CANDIDATES, "%", "candidates") \
   METRIC (backbone_probes, 2, PER_VARIABLE, "", "per variable") \
   METRIC (backbone_propagations, 2, PCNT_PROPS, "%", "propagations") \
   METRIC (backbone_rounds, 2, PER_BACKBONE, 0, "per backbone") \
+  STATISTIC (backbone_solved, 1, PCNT_BACKBONE_CANDIDATES, "%", "candidates") \
   COUNTER (backbone_ticks, 2, PCNT_TICKS, "%", "ticks") \
   STATISTIC (backbone_units, 1, PCNT_VARIABLES, "%", "variables") \
+  COUNTER (bandit_switched, 1, PCNT_SWITCHED, "%", "switched") \
   METRIC (best_saved, 1, CONF_INT, "", "interval") \
+  COUNTER (cache_flushes, 1, CONF_INT, "", "interval") \
+  COUNTER (checkpoints, 1, CONF_INT, "", "interval") \
   COUNTER (chronological, 1, PCNT_CONFLICTS, "%", "conflicts") \
   COUNTER (clauses_added, 2, PCNT_CLS_ADDED, "%", "added") \
   COUNTER (clauses_binary, 2, PCNT_CLS_ADDED, "%", "added") \
   STATISTIC (clauses_deleted, 1, PCNT_CLS_ADDED, "%", "added") \
+  COUNTER (clauses_exported, 1, PCNT_CLS_LEARNED, "%", "learned") \
   STATISTIC (clauses_factored, 1, PCNT_CLS_ADDED, "%", "added") \
+  COUNTER (clauses_imported, 1, NO_SECONDARY, 0, 0) \
   STATISTIC (clauses_improved, 1, PCNT_CLS_LEARNED, "%", "learned") \
   COUNTER (clauses_irredundant, 2, PCNT_CLS_ADDED, "%", "added") \
   STATISTIC (clauses_kept1, 1, PCNT_CLS_IMPROVED, "%", "improved") \
@@ -44,6 +53,7 @@
   STATISTIC (clauses_reduced_tier2, 1, PCNT_CLS_REDUCED, "%", "reduced") \
   STATISTIC (clauses_reduced_tier3, 1, PCNT_CLS_REDUCED, "%", "reduced") \
   COUNTER (clauses_redundant, 2, NO_SECONDARY, 0, 0) \
+  COUNTER (clauses_rejected, 1, PCNT_CLS_IMPORTED, "%", "imported") \
   STATISTIC (clauses_unfactored, 1, PCNT_CLS_FACTORED, "%", "factored") \
   COUNTER (clauses_used, 2, PCNT_CLS_LEARNED, "%", "learned") \
   COUNTER (clauses_used_focused, 2, PCNT_CLS_USED, "%", "used") \
@@ -51,6 +61,7 @@
   COUNTER (closures, 2, CONF_INT, "", "interval") \
   METRIC (compacted, 1, PCNT_REDUCTIONS, "%", "reductions") \
   COUNTER (conflicts, 0, PER_SECOND, 0, "per second") \
+  COUNTER (congruence_ticks, 2, PCNT_TICKS, "%", "ticks") \
   COUNTER (congruent, 1, PCNT_VARIABLES, "%", "variables") \
   STATISTIC (congruent_ands, 1, PCNT_CONGRUENT, "%", "congruent") \
   STATISTIC (congruent_arity, 1, PER_CONGRGATES, 0, "per gate") \
@@ -68,6 +79,7 @@
   COUNTER (congruent_gates_ites, 2, PCNT_CONGRGATES, "%", "gates") \
   COUNTER (congruent_gates_xors, 2, PCNT_CONGRGATES, "%", "gates") \
   STATISTIC (congruent_indexed, 1, PER_CONGRGATES, 0, "per gate") \
+  STATISTIC (congruent_loaded, 1, PCNT_CONGRGATES, "%", "gates") \
   STATISTIC (congruent_lookups, 1, PER_CONGRGATES, 0, "per gate") \
   STATISTIC (congruent_lookups_find, 1, PCNT_CONGRLOOKUP, "%", "lookups") \
   STATISTIC (congruent_lookups_removed, 1, PCNT_CONGRLOOKUP, "%", "lookups") \
@@ -92,6 +104,7 @@
   STATISTIC (congruent_units, 1, PCNT_VARIABLES, "%", "variables") \
   STATISTIC (congruent_xors, 1, PCNT_CONGRUENT, "%", "congruent") \
   COUNTER (decisions, 0, PER_CONFLICT, 0, "per conflict") \
+  STATISTIC (deduplicated, 1, PCNT_CLS_ORIGINAL, "%", "original") \
   METRIC (definitions_checked, 1, PCNT_ELIM_ATTEMPTS, "%", "attempts") \
   STATISTIC (definitions_eliminated, 1, PCNT_ELIMINATED, "%", "eliminated") \
   METRIC (definitions_extracted, 1, PCNT_EXTRACTED, "%", "extracted") \
@@ -110,6 +123,9 @@
   STATISTIC (equivalences_eliminated, 1, PCNT_ELIMINATED, "%", "eliminated") \
   METRIC (equivalences_extracted, 1, PCNT_EXTRACTED, "%", "extracted") \
   METRIC (extensions, 1, PCNT_SEARCHES, "%", "searches") \
+  COUNTER (external_clauses, 1, PCNT_CONFLICTS, "%", "conflicts") \
+  COUNTER (external_propagated, 1, PCNT_PROPS, "%", "propagations") \
+  COUNTER (external_rejected, 1, PCNT_SEARCHES, "%", "searches") \
   COUNTER (factored, 1, PCNT_VARIABLES, "%", "variables") \
   COUNTER (factorizations, 2, CONF_INT, "", "interval") \
   COUNTER (factor_ticks, 2, PCNT_TICKS, "%", "ticks") \
@@ -125,6 +141,7 @@
   METRIC (focused_restarts, 1, PCNT_RESTARTS, "%", "restarts") \
   METRIC (focused_ticks, 1, PCNT_TICKS, "%", "ticks") \
   COUNTER (forward_checks, 2, NO_SECONDARY, 0, 0) \
+  METRIC (forward_filtered, 2, PER_FORWARD_CHECK, 0, "per check") \
   COUNTER (forward_steps, 2, PER_FORWARD_CHECK, 0, "per check") \
   STATISTIC (forward_strengthened, 1, PCNT_STRENGTHENED, "%", "per strengthened") \
   STATISTIC (forward_subsumed, 1, PCNT_SUBSUMED, "%", "per subsumed") \
@@ -135,6 +152,8 @@
   METRIC (gates_extracted, 1, PCNT_ELIM_ATTEMPTS, "%", "attempts") \
   STATISTIC (if_then_else_eliminated, 1, PCNT_ELIMINATED, "%", "eliminated") \
   METRIC (if_then_else_extracted, 1, PCNT_EXTRACTED, "%", "extracted") \
+  METRIC (implications_built, 2, CONF_INT, "", "interval") \
+  METRIC (implications_edges, 2, PER_IMPLICATIONS, 0, "per graph") \
   METRIC (initial_decisions, 1, PCNT_DECISIONS, "%", "decisions") \
   COUNTER (iterations, 1, PCNT_VARIABLES, "%", "variables") \
   STATISTIC (jumped_reasons, 1, PCNT_PROPS, "%", "propagations") \
@@ -160,6 +179,7 @@
   METRIC (moved, 1, PCNT_REDUCTIONS, "%", "reductions") \
   STATISTIC (on_the_fly_strengthened, 1, PCNT_CONFLICTS, "%", "of conflicts") \
   STATISTIC (on_the_fly_subsumed, 1, PCNT_CONFLICTS, "%", "of conflicts") \
+  METRIC (payoffs, 2, CONF_INT, "", "interval") \
   METRIC (probing_propagations, 1, PCNT_PROPS, "%", "propagations") \
   COUNTER (probings, 2, CONF_INT, "", "interval") \
   COUNTER (probing_ticks, 2, PCNT_TICKS, "%", "ticks") \
@@ -228,12 +248,20 @@
   METRIC (target_decisions, 1, PCNT_DECISIONS, "%", "decisions") \
   METRIC (target_saved, 1, CONF_INT, "", "interval") \
   STATISTIC (ticks, 2, PER_PROPAGATION, 0, "per prop") \
+  METRIC (transitive_bitsets, 1, PCNT_TRANSITIVE, "%", "reductions") \
   METRIC (transitive_probes, 2, PER_VARIABLE, "", "per variable") \
   METRIC (transitive_propagations, 2, PCNT_PROPS, "%", "propagations") \
   METRIC (transitive_reduced, 1, PCNT_CLS_ADDED, "%", "added") \
   METRIC (transitive_reductions, 1, CONF_INT, "", "interval") \
   COUNTER (transitive_ticks, 2, PCNT_TICKS, "%", "ticks") \
   METRIC (transitive_units, 1, PCNT_VARIABLES, "%", "variables") \
+  COUNTER (treelook_equivalences, 1, PCNT_VARIABLES, "%", "variables") \
+  STATISTIC (treelook_failed, 1, PCNT_VARIABLES, "%", "variables") \
+  COUNTER (treelook_hbrs, 1, PCNT_CLS_ADDED, "%", "added") \
+  METRIC (treelook_probes, 2, PER_VARIABLE, "", "per variable") \
+  COUNTER (treelook_strengthened, 1, PCNT_TREELOOK_HBRS, "%", "resolvents") \
+  COUNTER (treelook_ticks, 2, PCNT_TICKS, "%", "ticks") \
+  COUNTER (treelooks, 1, CONF_INT, "", "interval") \
   COUNTER (units, 2, PCNT_VARIABLES, "%", "variables") \
   COUNTER (variables_activated, 2, PER_VARIABLE, 0, "per variable") \
   COUNTER (variables_eliminate, 2, PER_VARIABLE, 0, "variables") \
@@ -243,6 +271,10 @@
   COUNTER (variables_subsume, 2, PER_VARIABLE, 0, "per variable") \
   METRIC (vectors_defrags_needed, 1, PCNT_DEFRAGS, "%", "defrags") \
   METRIC (vectors_enlarged, 2, CONF_INT, "", "interval") \
+  METRIC (vectors_moved, 2, CONF_INT, "", "interval") \
+  METRIC (vectors_rebuilds, 1, CONF_INT, "", "interval") \
+  METRIC (vectors_reused, 2, PCNT_VECTORS_MOVED, "%", "moved") \
+  METRIC (vectors_split, 2, PCNT_VECTORS_REUSED, "%", "reused") \
   COUNTER (vivifications, 2, CONF_INT, "", "interval") \
   COUNTER (vivified, 1, PCNT_VIVIFY_CHECK, "%", "checks") \
   STATISTIC (vivified_asym, 1, PCNT_VIVIFIED, "%", "vivified") \
@@ -277,7 +309,10 @@
   COUNTER (warming_decisions, 2, PER_WALKS, 0, "per walk") \
   COUNTER (warming_propagations, 2, PCNT_PROPS, "%", "propagations") \
   COUNTER (warmups, 2, PCNT_WALKS, "%", "walks") \
-  METRIC (weakened, 1, PCNT_CLS_ADDED, "%", "added")
+  METRIC (weakened, 1, PCNT_CLS_ADDED, "%", "added") \
+  METRIC (weakened_compressed, 1, PCNT_WEAKENED, "%", "weakened") \
+  METRIC (weakened_compressed_bytes, 1, PER_COMPRESSED_LITERAL, 0, "per literal") \
+  METRIC (weakened_compressed_literals, 1, PER_COMPRESSED_CLAUSE, 0, "per clause")
 
 // clang-format on
 
@@ -592,8 +592,6 @@ static void substitute_rounds (kissat *solver, bool complete) {
   }
   if (!solver->inconsistent) {
     kissat_watch_large_clauses (solver);
-    LOG ("now all large clauses are watched after binary clauses");
-    solver->large_clauses_watched_after_binary_clauses = true;
     kissat_reset_propagate (solver);
     assert (!solver->level);
     (void) kissat_probing_propagate (solver, 0, true);
@@ -607,10 +605,10 @@ void kissat_substitute (kissat *solver, bool complete) {
   assert (solver->probing);
   assert (solver->watching);
   assert (!solver->level);
-  LOG ("assuming not all large clauses watched after binary clauses");
-  solver->large_clauses_watched_after_binary_clauses = false;
   if (!GET_OPTION (substitute))
     return;
+  if (solver->propagator.connected)
+    return;
   if (TERMINATED (substitute_terminated_1))
     return;
   substitute_rounds (solver, complete);
@@ -140,7 +140,7 @@ static void init_sweeper (kissat *solver, sweeper *sweeper) {
     sweeper->limit.ticks = UINT64_MAX;
     kissat_extremely_verbose (solver, "unlimited sweeper ticks limit");
   } else {
-    SET_EFFORT_LIMIT (ticks_limit, sweep, kitten_ticks);
+    SET_PAYOFF_EFFORT_LIMIT (ticks_limit, sweep, kitten_ticks);
     sweeper->limit.ticks = ticks_limit;
   }
   set_kitten_ticks_limit (sweeper);
@@ -1658,6 +1658,7 @@ bool kissat_sweep (kissat *solver) {
   assert (!solver->unflushed);
   START (sweep);
   INC (sweep);
+  START_PAYOFF (sweep, kitten_ticks);
   statistics *statistics = &solver->statistics;
   uint64_t equivalences = statistics->sweep_equivalences;
   uint64_t units = statistics->sweep_units;
@@ -1719,6 +1720,7 @@ bool kissat_sweep (kissat *solver) {
     BUMP_DELAY (sweep);
   else
     REDUCE_DELAY (sweep);
+  STOP_PAYOFF (sweep, kitten_ticks);
   STOP (sweep);
   return eliminated;
 }
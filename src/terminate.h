@@ -42,45 +42,48 @@ static inline bool kissat_terminated (kissat *solver, int bit,
 #define backbone_terminated_1 1
 #define backbone_terminated_2 2
 #define backbone_terminated_3 3
-#define congruence_terminated_1 4
-#define congruence_terminated_2 5
-#define congruence_terminated_3 6
-#define congruence_terminated_4 7
-#define congruence_terminated_5 8
-#define congruence_terminated_6 9
-#define congruence_terminated_7 10
-#define congruence_terminated_8 11
-#define congruence_terminated_9 12
-#define congruence_terminated_10 13
-#define congruence_terminated_11 14
-#define congruence_terminated_12 15
-#define eliminate_terminated_1 16
-#define eliminate_terminated_2 17
-#define factor_terminated_1 18
-#define fastel_terminated_1 19
-#define forward_terminated_1 20
-#define kitten_terminated_1 21
-#define kitten_terminated_2 22
-#define preprocess_terminated_1 23
-#define search_terminated_1 24
-#define substitute_terminated_1 25
-#define sweep_terminated_1 26
-#define sweep_terminated_2 27
-#define sweep_terminated_3 28
-#define sweep_terminated_4 29
-#define sweep_terminated_5 30
-#define sweep_terminated_6 31
-#define sweep_terminated_7 32
-#define sweep_terminated_8 33
-#define transitive_terminated_1 34
-#define transitive_terminated_2 35
-#define transitive_terminated_3 36
-#define vivify_terminated_1 37
-#define vivify_terminated_2 38
-#define vivify_terminated_3 39
-#define vivify_terminated_4 40
-#define vivify_terminated_5 41
-#define walk_terminated_1 42
-#define warmup_terminated_1 43
+#define backbones_terminated_1 4
+#define congruence_terminated_1 5
+#define congruence_terminated_2 6
+#define congruence_terminated_3 7
+#define congruence_terminated_4 8
+#define congruence_terminated_5 9
+#define congruence_terminated_6 10
+#define congruence_terminated_7 11
+#define congruence_terminated_8 12
+#define congruence_terminated_9 13
+#define congruence_terminated_10 14
+#define congruence_terminated_11 15
+#define congruence_terminated_12 16
+#define eliminate_terminated_1 17
+#define eliminate_terminated_2 18
+#define factor_terminated_1 19
+#define fastel_terminated_1 20
+#define forward_terminated_1 21
+#define kitten_terminated_1 22
+#define kitten_terminated_2 23
+#define preprocess_terminated_1 24
+#define search_terminated_1 25
+#define substitute_terminated_1 26
+#define sweep_terminated_1 27
+#define sweep_terminated_2 28
+#define sweep_terminated_3 29
+#define sweep_terminated_4 30
+#define sweep_terminated_5 31
+#define sweep_terminated_6 32
+#define sweep_terminated_7 33
+#define sweep_terminated_8 34
+#define transitive_terminated_1 35
+#define transitive_terminated_2 36
+#define transitive_terminated_3 37
+#define treelook_terminated_1 38
+#define treelook_terminated_2 39
+#define vivify_terminated_1 40
+#define vivify_terminated_2 41
+#define vivify_terminated_3 42
+#define vivify_terminated_4 43
+#define vivify_terminated_5 44
+#define walk_terminated_1 45
+#define warmup_terminated_1 46
 
 #endif
@@ -9,6 +9,10 @@ void kissat_flush_trail (kissat *solver) {
   assert (!solver->inconsistent);
   assert (kissat_propagated (solver));
   assert (SIZE_ARRAY (solver->trail) == solver->unflushed);
+  if (solver->propagator.connected) {
+    kissat_notify_assignments (solver);
+    solver->propagator.notified = 0;
+  }
   LOG ("flushed %zu units from trail", SIZE_ARRAY (solver->trail));
   CLEAR_ARRAY (solver->trail);
   kissat_reset_propagate (solver);
@@ -23,12 +27,13 @@ void kissat_mark_reason_clauses (kissat *solver, reference start) {
   unsigned reasons = 0;
 #endif
   ward *arena = BEGIN_STACK (solver->arena);
+  const assigned *const assigned = solver->assigned;
   for (all_stack (unsigned, lit, solver->trail)) {
-    assigned *a = ASSIGNED (lit);
-    assert (a->level > 0);
-    if (a->binary)
+    const unsigned idx = IDX (lit);
+    assert (ASSIGNED_LEVEL (assigned, idx) > 0);
+    if (assigned[idx].binary)
       continue;
-    const reference ref = a->reason;
+    const reference ref = ASSIGNED_REASON (assigned, idx);
     assert (ref != UNIT_REASON);
     if (ref == DECISION_REASON)
       continue;
@@ -69,12 +74,13 @@ void kissat_unmark_reason_clauses (kissat *solver, reference start) {
   unsigned reasons = 0;
 #endif
   ward *arena = BEGIN_STACK (solver->arena);
+  const assigned *const assigned = solver->assigned;
   for (all_stack (unsigned, lit, solver->trail)) {
-    assigned *a = ASSIGNED (lit);
-    assert (a->level > 0);
-    if (a->binary)
+    const unsigned idx = IDX (lit);
+    assert (ASSIGNED_LEVEL (assigned, idx) > 0);
+    if (assigned[idx].binary)
       continue;
-    const reference ref = a->reason;
+    const reference ref = ASSIGNED_REASON (assigned, idx);
     assert (ref != UNIT_REASON);
     if (ref == DECISION_REASON)
       continue;
@@ -2,6 +2,7 @@
 #include "allocate.h"
 #include "analyze.h"
 #include "heap.h"
+#include "implications.h"
 #include "inline.h"
 #include "inlinevector.h"
 #include "logging.h"
@@ -45,47 +46,61 @@ static void transitive_backtrack (kissat *solver, unsigned *saved) {
   solver->level = 0;
 }
 
-static void prioritize_binaries (kissat *solver) {
-  assert (solver->watching);
-  statches large;
-  INIT_STACK (large);
-  watches *all_watches = solver->watches;
-  for (all_literals (lit)) {
-    assert (EMPTY_STACK (large));
-    watches *watches = all_watches + lit;
-    watch *begin_watches = BEGIN_WATCHES (*watches), *q = begin_watches;
-    const watch *const end_watches = END_WATCHES (*watches), *p = q;
-    while (p != end_watches) {
-      const watch head = *q++ = *p++;
-      if (head.type.binary)
-        continue;
-      const watch tail = *p++;
-      PUSH_STACK (large, head);
-      PUSH_STACK (large, tail);
+// Only the watch in the destination watch list is removed here.  The
+// watches of the source literal are compacted in one pass after all its
+// implications have been tried (see 'flush_transitive_watches'), which
+// avoids quadratic behaviour for sources with many reduced binaries.
+
+static void remove_transitive_binary (kissat *solver, implications *graph,
+                                      unsigned src, unsigned dst) {
+  LOGBINARY (src, dst, "transitive reduce");
+  INC (transitive_reduced);
+  const watch dst_watch = kissat_binary_watch (src);
+  REMOVE_WATCHES (WATCHES (dst), dst_watch);
+  kissat_delete_binary (solver, src, dst);
+  kissat_remove_implication (solver, graph, src, dst);
+  mark *const marks = solver->marks;
+  assert (marks[dst] < 127);
+  marks[dst]++;
+}
+
+static void flush_transitive_watches (kissat *solver, unsigned src,
+                                      unsigned reduced) {
+  mark *const marks = solver->marks;
+  watches *const src_watches = &WATCHES (src);
+  watch *const begin = BEGIN_WATCHES (*src_watches);
+  const watch *const end = END_WATCHES (*src_watches);
+  watch *q = begin;
+  const watch *p = q;
+  while (p != end) {
+    const watch head = *q++ = *p++;
+    if (!head.type.binary) {
+      *q++ = *p++;
+      continue;
+    }
+    const unsigned other = head.binary.lit;
+    if (marks[other] > 0) {
+      marks[other]--;
       q--;
     }
-    const watch *const end_large = END_STACK (large);
-    watch const *r = BEGIN_STACK (large);
-    while (r != end_large)
-      *q++ = *r++;
-    assert (q == end_watches);
-    CLEAR_STACK (large);
   }
-  RELEASE_STACK (large);
+  assert (end - q == (ptrdiff_t) reduced);
+  SET_END_OF_WATCHES (*src_watches, q);
+#ifdef NDEBUG
+  (void) reduced;
+#endif
 }
 
-static bool transitive_reduce (kissat *solver, unsigned src, uint64_t limit,
+static void transitive_reduce (kissat *solver, implications *graph,
+                               unsigned src, uint64_t limit,
                                uint64_t *reduced_ptr, unsigned *units) {
-  bool res = false;
   assert (!VALUE (src));
   LOG ("transitive reduce %s", LOGLIT (src));
-  watches *all_watches = solver->watches;
-  watches *src_watches = all_watches + src;
-  watch *end_src = END_WATCHES (*src_watches);
-  watch *begin_src = BEGIN_WATCHES (*src_watches);
-  const size_t size_src_watches = SIZE_WATCHES (*src_watches);
+  unsigned *const begin_src = BEGIN_IMPLICATIONS (graph, src);
+  unsigned *const end_src = END_IMPLICATIONS (graph, src);
+  const size_t size_src = end_src - begin_src;
   const unsigned src_ticks =
-      1 + kissat_cache_lines (size_src_watches, sizeof (watch));
+      1 + kissat_cache_lines (size_src, sizeof (unsigned));
   ADD (transitive_ticks, src_ticks);
   ADD (probing_ticks, src_ticks);
   ADD (ticks, src_ticks);
@@ -93,11 +108,10 @@ static bool transitive_reduce (kissat *solver, unsigned src, uint64_t limit,
   const unsigned not_src = NOT (src);
   unsigned reduced = 0;
   bool failed = false;
-  for (watch *p = begin_src; p != end_src; p++) {
-    const watch src_watch = *p;
-    if (!src_watch.type.binary)
-      break;
-    const unsigned dst = src_watch.binary.lit;
+  for (unsigned *p = begin_src; p != end_src; p++) {
+    const unsigned dst = *p;
+    if (dst == INVALID_LIT)
+      continue;
     if (dst < src)
       continue;
     if (VALUE (dst))
@@ -116,21 +130,16 @@ static bool transitive_reduce (kissat *solver, unsigned src, uint64_t limit,
       LOG ("transitive propagate %s", LOGLIT (lit));
       assert (VALUE (lit) > 0);
       const unsigned not_lit = NOT (lit);
-      watches *lit_watches = all_watches + not_lit;
-      const watch *const end_lit = END_WATCHES (*lit_watches);
-      const watch *const begin_lit = BEGIN_WATCHES (*lit_watches);
-      const size_t size_lit_watches = SIZE_WATCHES (*lit_watches);
-      inner_ticks +=
-          1 + kissat_cache_lines (size_lit_watches, sizeof (watch));
-      for (const watch *q = begin_lit; q != end_lit; q++) {
+      const unsigned *const begin_lit = BEGIN_IMPLICATIONS (graph, not_lit);
+      const unsigned *const end_lit = END_IMPLICATIONS (graph, not_lit);
+      const size_t size_lit = end_lit - begin_lit;
+      inner_ticks += 1 + kissat_cache_lines (size_lit, sizeof (unsigned));
+      for (const unsigned *q = begin_lit; q != end_lit; q++) {
         if (p == q)
           continue;
-        const watch lit_watch = *q;
-        if (!lit_watch.type.binary)
-          break;
-        if (not_lit == src && lit_watch.binary.lit == ILLEGAL_LIT)
+        const unsigned other = *q;
+        if (other == INVALID_LIT)
           continue;
-        const unsigned other = lit_watch.binary.lit;
         if (other == dst) {
           transitive = true;
           break;
@@ -163,17 +172,9 @@ static bool transitive_reduce (kissat *solver, unsigned src, uint64_t limit,
     transitive_backtrack (solver, saved);
 
     if (transitive) {
-      LOGBINARY (src, dst, "transitive reduce");
-      INC (transitive_reduced);
-      watches *dst_watches = all_watches + dst;
-      watch dst_watch = src_watch;
-      assert (dst_watch.binary.lit == dst);
-      dst_watch.binary.lit = src;
-      REMOVE_WATCHES (*dst_watches, dst_watch);
-      kissat_delete_binary (solver, src, dst);
-      p->binary.lit = ILLEGAL_LIT;
+      remove_transitive_binary (solver, graph, src, dst);
+      assert (*p == INVALID_LIT);
       reduced++;
-      res = true;
     }
 
     if (failed)
@@ -186,35 +187,19 @@ static bool transitive_reduce (kissat *solver, unsigned src, uint64_t limit,
 
   if (reduced) {
     *reduced_ptr += reduced;
-    assert (begin_src == BEGIN_WATCHES (WATCHES (src)));
-    assert (end_src == END_WATCHES (WATCHES (src)));
-    watch *q = begin_src;
-    for (const watch *p = begin_src; p != end_src; p++) {
-      const watch src_watch = *q++ = *p;
-      if (!src_watch.type.binary) {
-        *q++ = *++p;
-        continue;
-      }
-      if (src_watch.binary.lit == ILLEGAL_LIT)
-        q--;
-    }
-    assert (end_src - q == (ptrdiff_t) reduced);
-    SET_END_OF_WATCHES (*src_watches, q);
+    flush_transitive_watches (solver, src, reduced);
   }
 
   if (failed) {
     LOG ("transitive failed literal %s", LOGLIT (not_src));
     INC (transitive_units);
     *units += 1;
-    res = true;
 
     kissat_learned_unit (solver, src);
 
     assert (!solver->level);
     (void) kissat_probing_propagate (solver, 0, true);
   }
-
-  return res;
 }
 
 static inline bool less_stable_transitive (kissat *solver,
@@ -296,40 +281,232 @@ static void schedule_transitive (kissat *solver, unsigneds *probes) {
                        SIZE_STACK (*probes));
 }
 
-void kissat_transitive_reduction (kissat *solver) {
-  if (solver->inconsistent)
+static inline bool less_transitive_node (const unsigned *nodes, unsigned a,
+                                         unsigned b) {
+  return nodes[a] > nodes[b];
+}
+
+#define LESS_TRANSITIVE_NODE(A, B) less_transitive_node (nodes, (A), (B))
+
+// Finds the strongly connected components of the implication graph with
+// Tarjan's algorithm and numbers literals in the order in which their
+// components are completed, which is a reverse topological order.  Since
+// 'substitute' ran right before, equivalent literals have usually been
+// removed.  Thus we give up as soon as we find a non-trivial component
+// and fall back to probing, which leaves the numbering in 'nodes' as a
+// topological order of the acyclic implication graph otherwise.
+
+static bool number_transitive_nodes (kissat *solver, implications *graph,
+                                     unsigned *nodes, unsigned *lits) {
+  const value *const values = solver->values;
+  const unsigned size = LITS;
+  unsigned *visited = kissat_calloc (solver, size, sizeof (unsigned));
+  unsigned *lowlink = kissat_nalloc (solver, size, sizeof (unsigned));
+  unsigned *cursor = kissat_nalloc (solver, size, sizeof (unsigned));
+  unsigneds work, component;
+  INIT_STACK (work);
+  INIT_STACK (component);
+  unsigned time = 0, completed = 0;
+  bool acyclic = true;
+  for (all_literals (lit))
+    nodes[lit] = INVALID_LIT;
+  for (all_literals (root)) {
+    if (values[root] || visited[root])
+      continue;
+    if (!ACTIVE (IDX (root)))
+      continue;
+    visited[root] = lowlink[root] = ++time;
+    cursor[root] = 0;
+    PUSH_STACK (work, root);
+    PUSH_STACK (component, root);
+    while (acyclic && !EMPTY_STACK (work)) {
+      const unsigned lit = TOP_STACK (work);
+      const unsigned not_lit = NOT (lit);
+      const unsigned *const begin = BEGIN_IMPLICATIONS (graph, not_lit);
+      const unsigned *const end = END_IMPLICATIONS (graph, not_lit);
+      if (begin + cursor[lit] != end) {
+        const unsigned other = begin[cursor[lit]++];
+        if (other == INVALID_LIT || values[other])
+          continue;
+        if (!visited[other]) {
+          visited[other] = lowlink[other] = ++time;
+          cursor[other] = 0;
+          PUSH_STACK (work, other);
+          PUSH_STACK (component, other);
+        } else if (nodes[other] == INVALID_LIT &&
+                   visited[other] < lowlink[lit])
+          lowlink[lit] = visited[other];
+        continue;
+      }
+      (void) POP_STACK (work);
+      if (lowlink[lit] == visited[lit]) {
+        const unsigned top = POP_STACK (component);
+        if (top != lit) {
+          LOG ("non-trivial strongly connected component with %s and %s",
+               LOGLIT (lit), LOGLIT (top));
+          acyclic = false;
+          break;
+        }
+        lits[completed] = lit;
+        nodes[lit] = completed++;
+      }
+      if (!EMPTY_STACK (work)) {
+        const unsigned parent = TOP_STACK (work);
+        if (lowlink[lit] < lowlink[parent])
+          lowlink[parent] = lowlink[lit];
+      }
+    }
+    if (!acyclic)
+      break;
+    assert (EMPTY_STACK (component));
+  }
+  RELEASE_STACK (component);
+  RELEASE_STACK (work);
+  kissat_dealloc (solver, cursor, size, sizeof (unsigned));
+  kissat_dealloc (solver, lowlink, size, sizeof (unsigned));
+  kissat_dealloc (solver, visited, size, sizeof (unsigned));
+  assert (!acyclic || completed == 2 * solver->active);
+  return acyclic;
+}
+
+// If probing ran out of effort on dense implication graphs, we finish
+// small enough acyclic graphs by computing the set of reachable literals
+// for all literals at once, as bit-sets indexed by topological order,
+// visiting literals after all their successors.  Successors of a literal
+// are merged in topological order and thus an edge to a successor already
+// reached through an earlier successor is transitive.  This removes all
+// remaining transitive binary clauses in one pass.  Reaching the negation
+// of a literal makes it a failed literal, whose negation is learned as
+// unit afterwards.  For sparse graphs probing is usually cheaper, since
+// it needs neither the quadratic bit-sets nor the condensation.
+
+static void reduce_transitive_bitsets (kissat *solver, implications *graph,
+                                       uint64_t *reduced_ptr,
+                                       unsigned *units_ptr) {
+  if (!GET_OPTION (transitivebits))
     return;
-  assert (solver->watching);
-  assert (solver->probing);
-  assert (!solver->level);
-  if (!GET_OPTION (transitive))
+  const unsigned size = LITS;
+  const unsigned active = 2 * solver->active;
+  if (active > (unsigned) GET_OPTION (transitivebitslim)) {
+    kissat_extremely_verbose (solver,
+                              "too many literals %u for transitive "
+                              "bit-sets (limit %d)",
+                              active, GET_OPTION (transitivebitslim));
     return;
-  if (TERMINATED (transitive_terminated_2))
+  }
+  unsigned *nodes = kissat_nalloc (solver, size, sizeof (unsigned));
+  unsigned *lits = kissat_nalloc (solver, active, sizeof (unsigned));
+  if (!number_transitive_nodes (solver, graph, nodes, lits)) {
+    kissat_dealloc (solver, lits, active, sizeof (unsigned));
+    kissat_dealloc (solver, nodes, size, sizeof (unsigned));
+    kissat_extremely_verbose (solver, "cyclic implication graph prevents "
+                                      "transitive bit-sets");
     return;
-  START (transitive);
-  INC (transitive_reductions);
-#if !defined(NDEBUG) || defined(METRICS)
-  assert (!solver->transitive_reducing);
-  solver->transitive_reducing = true;
-#endif
-  prioritize_binaries (solver);
-  bool success = false;
-  uint64_t reduced = 0;
+  }
+  INC (transitive_bitsets);
+  const size_t words = (active + 63) / 64;
+  uint64_t *reach =
+      kissat_calloc (solver, active * words, sizeof (uint64_t));
+  const value *const values = solver->values;
+  unsigneds successors, failed;
+  INIT_STACK (successors);
+  INIT_STACK (failed);
+  uint64_t reduced = 0, ticks = 0;
+  for (unsigned node = 0; node != active; node++) {
+    const unsigned lit = lits[node];
+    const unsigned not_lit = NOT (lit);
+    assert (nodes[lit] == node);
+    assert (EMPTY_STACK (successors));
+    const unsigned *const begin = BEGIN_IMPLICATIONS (graph, not_lit);
+    const unsigned *const end = END_IMPLICATIONS (graph, not_lit);
+    for (const unsigned *p = begin; p != end; p++) {
+      const unsigned other = *p;
+      if (other != INVALID_LIT && !values[other])
+        PUSH_STACK (successors, other);
+    }
+    ticks += 1 + kissat_cache_lines (end - begin, sizeof (unsigned));
+    SORT_STACK (unsigned, successors, LESS_TRANSITIVE_NODE);
+    uint64_t *const lit_reach = reach + node * words;
+    unsigned lit_reduced = 0;
+    for (all_stack (unsigned, other, successors)) {
+      const unsigned other_node = nodes[other];
+      assert (other_node != INVALID_LIT);
+      assert (other_node < node);
+      const uint64_t bit = (uint64_t) 1 << (other_node & 63);
+      uint64_t *const word = lit_reach + (other_node >> 6);
+      if (*word & bit) {
+        remove_transitive_binary (solver, graph, not_lit, other);
+        lit_reduced++;
+        continue;
+      }
+      *word |= bit;
+      const uint64_t *const other_reach = reach + other_node * words;
+      const size_t other_words = (other_node >> 6) + 1;
+      for (size_t i = 0; i != other_words; i++)
+        lit_reach[i] |= other_reach[i];
+      ticks += kissat_cache_lines (2 * other_words, sizeof (unsigned));
+    }
+    CLEAR_STACK (successors);
+    if (lit_reduced) {
+      flush_transitive_watches (solver, not_lit, lit_reduced);
+      reduced += lit_reduced;
+    }
+    const unsigned not_lit_node = nodes[not_lit];
+    assert (not_lit_node != INVALID_LIT);
+    const uint64_t not_lit_bit = (uint64_t) 1 << (not_lit_node & 63);
+    const uint64_t *const not_lit_word = lit_reach + (not_lit_node >> 6);
+    if (not_lit_node < node && (*not_lit_word & not_lit_bit)) {
+      LOG ("transitive failed literal %s", LOGLIT (lit));
+      PUSH_STACK (failed, not_lit);
+    }
+  }
+  RELEASE_STACK (successors);
+  kissat_dealloc (solver, reach, active * words, sizeof (uint64_t));
+  kissat_dealloc (solver, lits, active, sizeof (unsigned));
+  kissat_dealloc (solver, nodes, size, sizeof (unsigned));
+
+  ADD (transitive_ticks, ticks);
+  ADD (probing_ticks, ticks);
+  ADD (ticks, ticks);
+
   unsigned units = 0;
+  for (all_stack (unsigned, unit, failed)) {
+    if (solver->inconsistent)
+      break;
+    const value value = values[unit];
+    assert (value >= 0);
+    if (value)
+      continue;
+    INC (transitive_units);
+    units++;
+    kissat_learned_unit (solver, unit);
+    (void) kissat_probing_propagate (solver, 0, true);
+  }
+  RELEASE_STACK (failed);
 
-  SET_EFFORT_LIMIT (limit, transitive, transitive_ticks);
+  for (all_variables (idx))
+    solver->flags[idx].transitive = false;
 
+  kissat_phase (solver, "transitive", GET (probings),
+                "bit-sets on %u literals: reduced %" PRIu64 ", units %u",
+                active, reduced, units);
+  *reduced_ptr += reduced;
+  *units_ptr += units;
+}
+
+static bool probe_transitive (kissat *solver, implications *graph,
+                              uint64_t *reduced_ptr, unsigned *units_ptr) {
+  SET_PAYOFF_EFFORT_LIMIT (limit, transitive, transitive_ticks);
 #ifndef QUIET
   const unsigned active = solver->active;
-  const uint64_t old_ticks = solver->statistics.transitive_ticks;
-  kissat_extremely_verbose (
-      solver, "starting with %" PRIu64 " transitive ticks", old_ticks);
   unsigned probed = 0;
 #endif
+  uint64_t reduced = 0;
+  unsigned units = 0;
   unsigneds probes;
   INIT_STACK (probes);
   schedule_transitive (solver, &probes);
-  bool terminate = false;
+  bool terminate = false, exhausted = false;
   while (!terminate && !EMPTY_STACK (probes)) {
     const unsigned idx = POP_STACK (probes);
     solver->flags[idx].transitive = false;
@@ -342,12 +519,11 @@ void kissat_transitive_reduction (kissat *solver) {
 #ifndef QUIET
       probed++;
 #endif
-      if (transitive_reduce (solver, lit, limit, &reduced, &units))
-        success = true;
+      transitive_reduce (solver, graph, lit, limit, &reduced, &units);
       if (solver->inconsistent)
         terminate = true;
       else if (solver->statistics.transitive_ticks > limit)
-        terminate = true;
+        terminate = exhausted = true;
       else if (TERMINATED (transitive_terminated_3))
         terminate = true;
     }
@@ -365,6 +541,44 @@ void kissat_transitive_reduction (kissat *solver) {
   } else
     kissat_very_verbose (solver, "transitive reduction complete");
   RELEASE_STACK (probes);
+  kissat_phase (solver, "transitive", GET (probings),
+                "probed %u (%.0f%%): reduced %" PRIu64 ", units %u", probed,
+                kissat_percent (probed, 2 * active), reduced, units);
+  *reduced_ptr += reduced;
+  *units_ptr += units;
+  return exhausted;
+}
+
+void kissat_transitive_reduction (kissat *solver) {
+  if (solver->inconsistent)
+    return;
+  assert (solver->watching);
+  assert (solver->probing);
+  assert (!solver->level);
+  if (!GET_OPTION (transitive))
+    return;
+  if (TERMINATED (transitive_terminated_2))
+    return;
+  START (transitive);
+  INC (transitive_reductions);
+  START_PAYOFF (transitive, transitive_ticks);
+#if !defined(NDEBUG) || defined(METRICS)
+  assert (!solver->transitive_reducing);
+  solver->transitive_reducing = true;
+#endif
+  implications graph;
+  kissat_build_implications (solver, &graph);
+  uint64_t reduced = 0;
+  unsigned units = 0;
+
+#ifndef QUIET
+  const uint64_t old_ticks = solver->statistics.transitive_ticks;
+  kissat_extremely_verbose (
+      solver, "starting with %" PRIu64 " transitive ticks", old_ticks);
+#endif
+  if (probe_transitive (solver, &graph, &reduced, &units))
+    reduce_transitive_bitsets (solver, &graph, &reduced, &units);
+  kissat_release_implications (solver, &graph);
 
 #ifndef QUIET
   const uint64_t new_ticks = solver->statistics.transitive_ticks;
@@ -373,15 +587,14 @@ void kissat_transitive_reduction (kissat *solver) {
       solver, "finished at %" PRIu64 " after %" PRIu64 " transitive ticks",
       new_ticks, delta_ticks);
 #endif
-  kissat_phase (solver, "transitive", GET (probings),
-                "probed %u (%.0f%%): reduced %" PRIu64 ", units %u", probed,
-                kissat_percent (probed, 2 * active), reduced, units);
 
 #if !defined(NDEBUG) || defined(METRICS)
   assert (solver->transitive_reducing);
   solver->transitive_reducing = false;
 #endif
+  const bool success = reduced || units;
   REPORT (!success, 't');
+  STOP_PAYOFF (transitive, transitive_ticks);
   STOP (transitive);
 #ifdef QUIET
   (void) success;
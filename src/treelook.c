@@ -0,0 +1,359 @@
+#include "treelook.h"
+#include "allocate.h"
+#include "backtrack.h"
+#include "decide.h"
+#include "inline.h"
+#include "logging.h"
+#include "print.h"
+#include "proprobe.h"
+#include "random.h"
+#include "report.h"
+#include "terminate.h"
+
+// Failed literal probing with full propagation organized as 'tree-look'.
+// If 'lit' implies 'other' through the binary clause '-lit other' then
+// the propagation of 'other' is a subset of the propagation of 'lit'.
+// Thus we first decide 'other', propagate it and then decide 'lit' on
+// top of it on the next decision level, which shares the propagation
+// of 'other'.  The probes are traversed as depth-first search along the
+// reversed edges of the binary implication graph starting from literals
+// without outgoing binary implications.  This way each literal is probed
+// at most once but the trail is only reset after leaving a subtree.
+
+// All literals on the trail are implied by the decision on the highest
+// level.  Hence the trail forms a tree rooted in that decision, where
+// the parent of a literal is its binary reason, the parent of a decision
+// the decision one level higher and the parent of a literal forced by a
+// large clause the (lazily computed) dominator of the negations of the
+// other literals in that clause.  The latter corresponds to the hyper
+// binary resolvent of the reason clause.  It is only added as binary
+// clause if it subsumes the reason (by default) or for 'treelookhbr=2'
+// always.  Failed literals are determined as the dominator of the
+// conflicting literals, which gives the strongest failed literal unit.
+
+typedef struct treelooker treelooker;
+
+struct treelooker {
+  kissat *solver;
+  bool *probed;
+  unsigned *parents;
+  unsigneds roots;
+  unsigneds stack;
+  uint64_t limit;
+  unsigned equivalences;
+  unsigned failed;
+  unsigned hbrs;
+  unsigned probes;
+};
+
+static void init_treelooker (kissat *solver, treelooker *treelooker) {
+  treelooker->solver = solver;
+  treelooker->probed = kissat_calloc (solver, LITS, sizeof (bool));
+  treelooker->parents = kissat_malloc (solver, VARS * sizeof (unsigned));
+  INIT_STACK (treelooker->roots);
+  INIT_STACK (treelooker->stack);
+  treelooker->equivalences = 0;
+  treelooker->failed = 0;
+  treelooker->hbrs = 0;
+  treelooker->probes = 0;
+}
+
+static void release_treelooker (treelooker *treelooker) {
+  kissat *solver = treelooker->solver;
+  kissat_free (solver, treelooker->probed, LITS * sizeof (bool));
+  kissat_free (solver, treelooker->parents, VARS * sizeof (unsigned));
+  RELEASE_STACK (treelooker->roots);
+  RELEASE_STACK (treelooker->stack);
+}
+
+static unsigned parent_literal (treelooker *treelooker, unsigned lit) {
+  kissat *solver = treelooker->solver;
+  const assigned *const a = ASSIGNED (lit);
+  const unsigned level = LEVEL (lit);
+  assert (level);
+  const unsigned reason = REASON (lit);
+  if (reason == DECISION_REASON) {
+    if (level == solver->level)
+      return INVALID_LIT;
+    return FRAME (level + 1).decision;
+  }
+  if (a->binary)
+    return NOT (reason);
+  return treelooker->parents[IDX (lit)];
+}
+
+static bool deeper_literal (kissat *solver, unsigned a, unsigned b) {
+  const unsigned a_level = LEVEL (a);
+  const unsigned b_level = LEVEL (b);
+  if (a_level != b_level)
+    return a_level < b_level;
+  return TRAIL (a) > TRAIL (b);
+}
+
+static unsigned dominator (treelooker *treelooker, unsigned a, unsigned b) {
+  kissat *solver = treelooker->solver;
+  while (a != b) {
+    if (deeper_literal (solver, a, b))
+      a = parent_literal (treelooker, a);
+    else
+      b = parent_literal (treelooker, b);
+    assert (a != INVALID_LIT);
+    assert (b != INVALID_LIT);
+  }
+  return a;
+}
+
+static unsigned clause_dominator (treelooker *treelooker, clause *c,
+                                  unsigned except) {
+  kissat *solver = treelooker->solver;
+  unsigned res = INVALID_LIT;
+  for (all_literals_in_clause (other, c)) {
+    if (other == except)
+      continue;
+    assert (VALUE (other) < 0);
+    if (!LEVEL (other))
+      continue;
+    const unsigned not_other = NOT (other);
+    if (res == INVALID_LIT)
+      res = not_other;
+    else
+      res = dominator (treelooker, res, not_other);
+  }
+  assert (res != INVALID_LIT);
+  return res;
+}
+
+static void hyper_binary_resolve (treelooker *treelooker, size_t start,
+                                  bool add) {
+  kissat *solver = treelooker->solver;
+  const int hbr = add ? GET_OPTION (treelookhbr) : 0;
+  unsigned_array *trail = &solver->trail;
+  for (size_t i = start; i < SIZE_ARRAY (*trail); i++) {
+    const unsigned lit = PEEK_ARRAY (*trail, i);
+    assigned *const a = ASSIGNED (lit);
+    if (a->binary || REASON (lit) == DECISION_REASON)
+      continue;
+    assert (LEVEL (lit));
+    clause *c = kissat_dereference_clause (solver, REASON (lit));
+    const unsigned dom = clause_dominator (treelooker, c, lit);
+    treelooker->parents[IDX (lit)] = dom;
+    if (!hbr)
+      continue;
+    const unsigned not_dom = NOT (dom);
+    bool subsumes = false;
+    for (all_literals_in_clause (other, c))
+      if (other == not_dom) {
+        subsumes = true;
+        break;
+      }
+    if (!subsumes && hbr < 2)
+      continue;
+    LOGCLS (c, "hyper binary resolving %s with dominator %s on",
+            LOGLIT (lit), LOGLIT (dom));
+    kissat_new_binary_clause (solver, not_dom, lit);
+    a->binary = true;
+    REASON (lit) = not_dom;
+    treelooker->hbrs++;
+    INC (treelook_hbrs);
+    if (subsumes) {
+      LOGCLS (c, "subsumed by hyper binary resolvent");
+      kissat_mark_clause_as_garbage (solver, c);
+      INC (treelook_strengthened);
+    }
+  }
+}
+
+static void treelook_equivalence (treelooker *treelooker, unsigned decision,
+                                  unsigned lit) {
+  kissat *solver = treelooker->solver;
+  LOG ("probe %s implies %s which implies the probe", LOGLIT (decision),
+       LOGLIT (lit));
+  treelooker->equivalences++;
+  INC (treelook_equivalences);
+  unsigned other = lit;
+  while (other != decision) {
+    const assigned *const a = ASSIGNED (other);
+    if (!a->binary && REASON (other) != DECISION_REASON) {
+      LOGBINARY (NOT (decision), lit, "equivalence");
+      kissat_new_binary_clause (solver, NOT (decision), lit);
+      return;
+    }
+    other = parent_literal (treelooker, other);
+  }
+  LOG ("equivalence already implied by binary clauses");
+}
+
+static void push_children (treelooker *treelooker, unsigned lit) {
+  kissat *solver = treelooker->solver;
+  watches *const watches = &WATCHES (lit);
+  for (all_binary_blocking_watches (watch, *watches)) {
+    if (!watch.type.binary)
+      continue;
+    const unsigned child = NOT (watch.binary.lit);
+    if (treelooker->probed[child])
+      continue;
+    PUSH_STACK (treelooker->stack, child);
+  }
+  const size_t size = SIZE_WATCHES (*watches);
+  ADD (treelook_ticks, 1 + kissat_cache_lines (size, sizeof (watch)));
+}
+
+static bool treelook_root (treelooker *treelooker, unsigned root) {
+  kissat *solver = treelooker->solver;
+  unsigneds *const stack = &treelooker->stack;
+  assert (EMPTY_STACK (*stack));
+  assert (!solver->level);
+  LOG ("tree-look probing root %s", LOGLIT (root));
+  PUSH_STACK (*stack, root);
+  unsigned unit = INVALID_LIT;
+  bool res = true;
+  while (!EMPTY_STACK (*stack)) {
+    const unsigned lit = POP_STACK (*stack);
+    if (lit == INVALID_LIT) {
+      assert (solver->level);
+      kissat_backtrack_without_updating_phases (solver, solver->level - 1);
+      continue;
+    }
+    if (treelooker->probed[lit])
+      continue;
+    const value value = VALUE (lit);
+    if (value) {
+      if (!LEVEL (lit))
+        continue;
+      const unsigned decision = FRAME (solver->level).decision;
+      if (value < 0) {
+        LOG ("probe %s implies %s which implies the negation",
+             LOGLIT (lit), LOGLIT (decision));
+        unit = NOT (lit);
+        break;
+      }
+      treelook_equivalence (treelooker, decision, lit);
+      continue;
+    }
+    if (solver->statistics.treelook_ticks > treelooker->limit) {
+      res = false;
+      break;
+    }
+    if (TERMINATED (treelook_terminated_1)) {
+      res = false;
+      break;
+    }
+    treelooker->probed[lit] = true;
+    treelooker->probes++;
+    INC (treelook_probes);
+    const size_t start = SIZE_ARRAY (solver->trail);
+    kissat_internal_assume (solver, lit);
+    clause *conflict = kissat_probing_propagate (solver, 0, false);
+    ADD (treelook_ticks, solver->ticks);
+    if (conflict) {
+      hyper_binary_resolve (treelooker, start, false);
+      unit = NOT (clause_dominator (treelooker, conflict, INVALID_LIT));
+      LOG ("probe %s failed with dominator %s", LOGLIT (lit),
+           LOGLIT (NOT (unit)));
+      break;
+    }
+    hyper_binary_resolve (treelooker, start, true);
+    PUSH_STACK (*stack, INVALID_LIT);
+    push_children (treelooker, lit);
+  }
+  CLEAR_STACK (*stack);
+  if (solver->level)
+    kissat_backtrack_without_updating_phases (solver, 0);
+  if (unit != INVALID_LIT) {
+    treelooker->failed++;
+    INC (treelook_failed);
+    kissat_learned_unit (solver, unit);
+    clause *conflict = kissat_probing_propagate (solver, 0, true);
+    ADD (treelook_ticks, solver->ticks);
+    if (conflict)
+      res = false;
+  }
+  return res;
+}
+
+static bool has_binary_watch (kissat *solver, unsigned lit) {
+  watches *const watches = &WATCHES (lit);
+  for (all_binary_blocking_watches (watch, *watches))
+    if (watch.type.binary)
+      return true;
+  return false;
+}
+
+static void schedule_roots (treelooker *treelooker) {
+  kissat *solver = treelooker->solver;
+  unsigneds *const roots = &treelooker->roots;
+  for (all_variables (idx)) {
+    if (!ACTIVE (idx))
+      continue;
+    const unsigned lit = LIT (idx);
+    const unsigned not_lit = NOT (lit);
+    const bool positive = has_binary_watch (solver, lit);
+    const bool negative = has_binary_watch (solver, not_lit);
+    if (positive && !negative)
+      PUSH_STACK (*roots, lit);
+    if (negative && !positive)
+      PUSH_STACK (*roots, not_lit);
+  }
+  kissat_extremely_verbose (solver, "scheduled %zu tree-look roots",
+                            SIZE_STACK (*roots));
+}
+
+static void treelook_roots (treelooker *treelooker) {
+  kissat *solver = treelooker->solver;
+  schedule_roots (treelooker);
+  const unsigneds *const roots = &treelooker->roots;
+  const size_t size = SIZE_STACK (*roots);
+  if (!size)
+    return;
+  const size_t start = kissat_pick_random (&solver->random, 0, size);
+  for (size_t i = 0; i < size; i++) {
+    const unsigned root = PEEK_STACK (*roots, (start + i) % size);
+    if (treelooker->probed[root] || VALUE (root))
+      continue;
+    if (!treelook_root (treelooker, root))
+      return;
+  }
+  for (all_literals (lit)) {
+    if (treelooker->probed[lit] || VALUE (lit))
+      continue;
+    if (!ACTIVE (IDX (lit)))
+      continue;
+    if (!has_binary_watch (solver, NOT (lit)))
+      continue;
+    if (!treelook_root (treelooker, lit))
+      return;
+  }
+}
+
+void kissat_treelook (kissat *solver) {
+  if (solver->inconsistent)
+    return;
+  if (!GET_OPTION (treelook))
+    return;
+  if (TERMINATED (treelook_terminated_2))
+    return;
+  assert (solver->watching);
+  assert (solver->probing);
+  assert (!solver->level);
+  START (treelook);
+  INC (treelooks);
+  treelooker treelooker;
+  init_treelooker (solver, &treelooker);
+  START_PAYOFF (treelook, treelook_ticks);
+  SET_PAYOFF_EFFORT_LIMIT (limit, treelook, treelook_ticks);
+  treelooker.limit = limit;
+  treelook_roots (&treelooker);
+  kissat_phase (solver, "treelook", GET (treelooks),
+                "%u probes %u failed %u equivalences %u hyper binary",
+                treelooker.probes, treelooker.failed,
+                treelooker.equivalences, treelooker.hbrs);
+  const bool success = treelooker.failed || treelooker.equivalences ||
+                       treelooker.hbrs;
+  release_treelooker (&treelooker);
+  REPORT (!success, 'L');
+  STOP_PAYOFF (treelook, treelook_ticks);
+  STOP (treelook);
+#ifdef QUIET
+  (void) success;
+#endif
+}
@@ -0,0 +1,8 @@
+#ifndef _treelook_h_INCLUDED
+#define _treelook_h_INCLUDED
+
+struct kissat;
+
+void kissat_treelook (struct kissat *);
+
+#endif
@@ -40,6 +40,140 @@ static void fix_vector_pointers_after_moving_stack (kissat *solver,
 
 #endif
 
+static void clear_slabs (kissat *solver) {
+  sizes *slabs = solver->vectors.slabs;
+  for (unsigned i = 0; i < SIZE_SLABS; i++)
+    CLEAR_STACK (slabs[i]);
+}
+
+static void release_slabs (kissat *solver) {
+  sizes *slabs = solver->vectors.slabs;
+  for (unsigned i = 0; i < SIZE_SLABS; i++)
+    RELEASE_STACK (slabs[i]);
+}
+
+static bool unused_block (const unsigned *begin, size_t size) {
+  const unsigned *const end = begin + size;
+  const unsigned *p = begin;
+  while (p != end && *p == INVALID_VECTOR_ELEMENT)
+    p++;
+  return p == end;
+}
+
+// Parts of a free block might have been taken over in the mean time by a
+// preceding vector growing in place or by another free block overlapping
+// this one.  Such stale entries are only detected when the block is about
+// to be reused.  To bound the size of the free lists they are flushed
+// (and if this does not help cleared, since they are only hints) as soon
+// as they have more entries than there are blocks of that size class.
+
+static void flush_stale_slabs (kissat *solver, unsigned ld) {
+  sizes *slab = solver->vectors.slabs + ld;
+  const unsigned *const begin_stack = BEGIN_STACK (solver->vectors.stack);
+  const size_t size = (size_t) 1 << ld;
+  size_t *q = BEGIN_STACK (*slab);
+  for (all_stack (size_t, offset, *slab))
+    if (unused_block (begin_stack + offset, size))
+      *q++ = offset;
+  SET_END_OF_STACK (*slab, q);
+  LOG ("flushed stale slabs of size %zu thus %zu remain", size,
+       SIZE_STACK (*slab));
+  if (SIZE_STACK (*slab) > SIZE_STACK (solver->vectors.stack) >> ld)
+    CLEAR_STACK (*slab);
+}
+
+static void push_slab (kissat *solver, unsigned ld, size_t offset) {
+  assert (ld < SIZE_SLABS);
+  sizes *slab = solver->vectors.slabs + ld;
+  if (SIZE_STACK (*slab) > SIZE_STACK (solver->vectors.stack) >> ld)
+    flush_stale_slabs (solver, ld);
+  LOG2 ("freeing slab %zu[%zu]", offset, (size_t) 1 << ld);
+  PUSH_STACK (*slab, offset);
+}
+
+// Freed blocks of arbitrary size are split into blocks of the size
+// classes (largest first).  Blocks of size one are too small to be reused
+// by an enlarged vector and thus simply dropped.
+
+static void free_slab (kissat *solver, unsigned *begin, size_t size) {
+  if (!GET_OPTION (slabs))
+    return;
+  unsigneds *stack = &solver->vectors.stack;
+  size_t offset = begin - BEGIN_STACK (*stack);
+  assert (offset + size <= SIZE_STACK (*stack));
+  while (size > 1) {
+    const unsigned ld = kissat_log2_floor_of_uint64 (size);
+    const size_t block = (size_t) 1 << ld;
+    push_slab (solver, ld, offset);
+    offset += block;
+    size -= block;
+  }
+}
+
+// Take a free block of the size class of 'size' or split the smallest
+// larger free block (putting back its unused remainder).
+
+static unsigned *reuse_slab (kissat *solver, size_t size) {
+  assert (kissat_is_power_of_two (size));
+  unsigneds *stack = &solver->vectors.stack;
+  unsigned *const begin_stack = BEGIN_STACK (*stack);
+  for (unsigned ld = kissat_log2_floor_of_uint64 (size); ld < SIZE_SLABS;
+       ld++) {
+    sizes *slab = solver->vectors.slabs + ld;
+    while (!EMPTY_STACK (*slab)) {
+      const size_t offset = POP_STACK (*slab);
+      const size_t block = (size_t) 1 << ld;
+      assert (offset + block <= SIZE_STACK (*stack));
+      unsigned *const begin = begin_stack + offset;
+      if (!unused_block (begin, size)) {
+        LOG2 ("skipping stale slab %zu[%zu]", offset, block);
+        continue;
+      }
+      LOG2 ("reusing slab %zu[%zu]", offset, block);
+      if (block > size) {
+        INC (vectors_split);
+        free_slab (solver, begin + size, block - size);
+      }
+      INC (vectors_reused);
+      return begin;
+    }
+  }
+  return 0;
+}
+
+static unsigned *move_vector (kissat *solver, vector *vector,
+                              unsigned *begin_new_vector,
+                              size_t old_vector_size) {
+  unsigned *begin_old_vector = kissat_begin_vector (solver, vector);
+  unsigned *middle_new_vector = begin_new_vector + old_vector_size;
+  const size_t old_bytes = old_vector_size * sizeof (unsigned);
+  if (old_bytes) {
+    memcpy (begin_new_vector, begin_old_vector, old_bytes);
+    memset (begin_old_vector, 0xff, old_bytes);
+    free_slab (solver, begin_old_vector, old_vector_size);
+  }
+  INC (vectors_moved);
+#ifdef COMPACT
+  unsigneds *stack = &solver->vectors.stack;
+  const uint64_t offset = begin_new_vector - BEGIN_STACK (*stack);
+  assert (offset <= MAX_VECTORS);
+  vector->offset = offset;
+  LOG2 ("enlarged vector at %p to %u[%u]", (void *) vector, vector->offset,
+        vector->size);
+#else
+  vector->begin = begin_new_vector;
+  vector->end = middle_new_vector;
+#ifdef LOGGING
+  const size_t new_offset =
+      vector->begin - BEGIN_STACK (solver->vectors.stack);
+  LOG2 ("enlarged vector at %p to %zu[%zu]", (void *) vector, new_offset,
+        old_vector_size);
+#endif
+#endif
+  assert (kissat_size_vector (vector) == old_vector_size);
+  return middle_new_vector;
+}
+
 unsigned *kissat_enlarge_vector (kissat *solver, vector *vector) {
   unsigneds *stack = &solver->vectors.stack;
   const size_t old_vector_size = kissat_size_vector (vector);
@@ -50,6 +184,17 @@ unsigned *kissat_enlarge_vector (kissat *solver, vector *vector) {
 #endif
   assert (old_vector_size < MAX_VECTORS / 2);
   const size_t new_vector_size = old_vector_size ? 2 * old_vector_size : 1;
+  if (old_vector_size && GET_OPTION (slabs)) {
+    const unsigned ld = kissat_log2_ceiling_of_uint64 (new_vector_size);
+    const size_t block = (size_t) 1 << ld;
+    unsigned *begin_new_vector = reuse_slab (solver, block);
+    if (begin_new_vector) {
+      // All the entries of the reused block were usable before, as are
+      // all the entries of the old vector now, thus 'usable' is unchanged.
+      return move_vector (solver, vector, begin_new_vector,
+                          old_vector_size);
+    }
+  }
   size_t old_stack_size = SIZE_STACK (*stack);
   size_t capacity = CAPACITY_STACK (*stack);
   assert (kissat_is_power_of_two (MAX_VECTORS));
@@ -97,42 +242,20 @@ unsigned *kissat_enlarge_vector (kissat *solver, vector *vector) {
     assert (capacity <= MAX_VECTORS);
     assert (new_vector_size <= available);
   }
-  unsigned *begin_old_vector = kissat_begin_vector (solver, vector);
   unsigned *begin_new_vector = END_STACK (*stack);
   unsigned *middle_new_vector = begin_new_vector + old_vector_size;
   unsigned *end_new_vector = begin_new_vector + new_vector_size;
   assert (end_new_vector <= stack->allocated);
-  const size_t old_bytes = old_vector_size * sizeof (unsigned);
   const size_t delta_size = new_vector_size - old_vector_size;
   assert (MAX_SIZE_T / sizeof (unsigned) >= delta_size);
   const size_t delta_bytes = delta_size * sizeof (unsigned);
-  if (old_bytes) {
-    memcpy (begin_new_vector, begin_old_vector, old_bytes);
-    memset (begin_old_vector, 0xff, old_bytes);
-  }
   solver->vectors.usable += old_vector_size;
   kissat_add_usable (solver, delta_size);
   if (delta_bytes)
     memset (middle_new_vector, 0xff, delta_bytes);
-#ifdef COMPACT
-  const uint64_t offset = SIZE_STACK (*stack);
-  assert (offset <= MAX_VECTORS);
-  vector->offset = offset;
-  LOG2 ("enlarged vector at %p to %u[%u]", (void *) vector, vector->offset,
-        vector->size);
-#else
-  vector->begin = begin_new_vector;
-  vector->end = middle_new_vector;
-#ifdef LOGGING
-  const size_t new_offset = vector->begin - stack->begin;
-  LOG2 ("enlarged vector at %p to %zu[%zu]", (void *) vector, new_offset,
-        old_vector_size);
-#endif
-#endif
   stack->end = end_new_vector;
   assert (begin_new_vector < end_new_vector);
-  assert (kissat_size_vector (vector) == old_vector_size);
-  return middle_new_vector;
+  return move_vector (solver, vector, begin_new_vector, old_vector_size);
 }
 
 #ifdef COMPACT
@@ -156,6 +279,14 @@ static inline rank rank_offset (vector *unsorted, unsigned i) {
 
 #define RANK_OFFSET(A) rank_offset (unsorted, (A))
 
+static void reset_empty_vector (vector *vector) {
+#ifdef COMPACT
+  vector->offset = 0;
+#else
+  vector->begin = vector->end = 0;
+#endif
+}
+
 void kissat_defrag_vectors (kissat *solver, size_t size_unsorted,
                             vector *unsorted) {
   unsigneds *stack = &solver->vectors.stack;
@@ -172,11 +303,7 @@ void kissat_defrag_vectors (kissat *solver, size_t size_unsorted,
   for (unsigned i = 0; i < size_unsorted; i++) {
     vector *vector = unsorted + i;
     if (kissat_empty_vector (vector))
-#ifdef COMPACT
-      vector->offset = 0;
-#else
-      vector->begin = vector->end = 0;
-#endif
+      reset_empty_vector (vector);
     else
       sorted[size_sorted++] = i;
   }
@@ -229,10 +356,74 @@ void kissat_defrag_vectors (kissat *solver, size_t size_unsorted,
     fix_vector_pointers_after_moving_stack (solver, moved);
 #endif
   solver->vectors.usable = 0;
+  clear_slabs (solver);
   kissat_check_vectors (solver);
   STOP (defrag);
 }
 
+// Rebuilds the free lists from scratch in linear time without moving any
+// vector.  A vector keeps the usable entries following it up to the size
+// class of its size for growing in place, which are marked in a bit-set.
+// All other maximal gaps of usable entries in the stack are freed (split
+// into size classes) or removed from the stack if at its end.  This is
+// called after watches have been flushed and reconnected in bulk, which
+// shrinks vectors without moving them, and replaces the defragmentation
+// after parsing.
+
+void kissat_rebuild_slabs (kissat *solver, size_t size_vectors,
+                           vector *vectors) {
+  if (!GET_OPTION (slabs))
+    return;
+  unsigneds *stack = &solver->vectors.stack;
+  const size_t size_stack = SIZE_STACK (*stack);
+  if (size_stack < 2)
+    return;
+  START (slabs);
+  INC (vectors_rebuilds);
+  clear_slabs (solver);
+  const size_t words = (size_stack + 63) / 64;
+  uint64_t *kept;
+  CALLOC (kept, words);
+  unsigned *const begin_stack = BEGIN_STACK (*stack);
+  for (size_t i = 0; i < size_vectors; i++) {
+    vector *vector = vectors + i;
+    if (kissat_empty_vector (vector)) {
+      reset_empty_vector (vector);
+      continue;
+    }
+    const size_t size = kissat_size_vector (vector);
+    const size_t offset = kissat_begin_vector (solver, vector) - begin_stack;
+    const unsigned ld = kissat_log2_ceiling_of_uint64 (size);
+    size_t end = offset + ((size_t) 1 << ld);
+    if (end > size_stack)
+      end = size_stack;
+    for (size_t pos = offset + size; pos < end; pos++)
+      kept[pos >> 6] |= (uint64_t) 1 << (pos & 63);
+  }
+  size_t gap = 0;
+  for (size_t pos = 1; pos < size_stack; pos++) {
+    const bool usable = begin_stack[pos] == INVALID_VECTOR_ELEMENT &&
+                        !(kept[pos >> 6] & ((uint64_t) 1 << (pos & 63)));
+    if (usable) {
+      if (!gap)
+        gap = pos;
+    } else if (gap) {
+      free_slab (solver, begin_stack + gap, pos - gap);
+      gap = 0;
+    }
+  }
+  DEALLOC (kept, words);
+  if (gap) {
+    const size_t trimmed = size_stack - gap;
+    LOG ("trimming %zu usable entries at the end of the stack", trimmed);
+    assert (trimmed <= solver->vectors.usable);
+    solver->vectors.usable -= trimmed;
+    SET_END_OF_STACK (*stack, begin_stack + gap);
+  }
+  kissat_check_vectors (solver);
+  STOP (slabs);
+}
+
 void kissat_remove_from_vector (kissat *solver, vector *vector,
                                 unsigned remove) {
   unsigned *begin = kissat_begin_vector (solver, vector), *p = begin;
@@ -282,6 +473,7 @@ void kissat_resize_vector (kissat *solver, vector *vector,
 void kissat_release_vectors (kissat *solver) {
   RELEASE_STACK (solver->vectors.stack);
   solver->vectors.usable = 0;
+  release_slabs (solver);
 }
 
 #ifdef CHECK_VECTORS
@@ -18,12 +18,26 @@
 
 #define MAX_SECTOR MAX_SIZE_T
 
+#define SIZE_SLABS LD_MAX_VECTORS
+
 typedef struct vector vector;
 typedef struct vectors vectors;
 
+// Blocks of the vector stack freed when a vector is enlarged and moved are
+// kept in 'slabs' indexed by the binary logarithm of their size (size
+// classes) as offsets relative to the beginning of the stack.  Freed
+// blocks of other sizes are split into blocks of these size classes.
+// Enlarged vectors take a free block of the matching size class (or split
+// a larger one) before allocating new space at the end of the stack.
+// After watches are flushed and reconnected in bulk the free lists are
+// rebuilt from the gaps between vectors (see 'kissat_rebuild_slabs'),
+// such that space of shrunken vectors is reused too and global
+// defragmentation is only needed as a fallback.
+
 struct vectors {
   unsigneds stack;
   size_t usable;
+  sizes slabs[SIZE_SLABS];
 };
 
 struct vector {
@@ -48,6 +62,7 @@ void kissat_check_vectors (struct kissat *);
 
 unsigned *kissat_enlarge_vector (struct kissat *, vector *);
 void kissat_defrag_vectors (struct kissat *, size_t, vector *);
+void kissat_rebuild_slabs (struct kissat *, size_t, vector *);
 void kissat_remove_from_vector (struct kissat *, vector *, unsigned);
 void kissat_resize_vector (struct kissat *, vector *, size_t);
 void kissat_release_vectors (struct kissat *);
@@ -479,7 +479,7 @@ static void vivify_deduce (vivifier *vivifier, clause *candidate,
     unsigned not_implied = NOT (implied);
     LOG ("vivify analyzing %s", LOGLIT (not_implied));
     assigned *const a = ASSIGNED (not_implied);
-    assert (a->level);
+    assert (LEVEL (not_implied));
     assert (!a->analyzed);
     a->analyzed = true;
     PUSH_STACK (solver->analyzed, not_implied);
@@ -498,7 +498,7 @@ static void vivify_deduce (vivifier *vivifier, clause *candidate,
       LOG ("vivify analyzing %s", LOGLIT (other));
       assert (!value);
       assigned *const a = ASSIGNED (other);
-      assert (a->level);
+      assert (LEVEL (other));
       assert (!a->analyzed);
       a->analyzed = true;
       PUSH_STACK (solver->analyzed, other);
@@ -523,13 +523,14 @@ static void vivify_deduce (vivifier *vivifier, clause *candidate,
     assert (VALUE (lit) > 0);
     analyzed++;
     assigned *a = ASSIGNED (lit);
-    assert (a->level);
+    assert (LEVEL (lit));
     assert (a->analyzed);
-    if (a->reason == DECISION_REASON) {
+    const unsigned lit_reason = REASON (lit);
+    if (lit_reason == DECISION_REASON) {
       LOG ("vivify analyzing decision %s", LOGLIT (not_lit));
       PUSH_STACK (solver->clause, not_lit);
     } else if (a->binary) {
-      const unsigned other = a->reason;
+      const unsigned other = lit_reason;
       if (marks[lit] > 0 && marks[other] > 0) {
         LOGCLS (candidate, "vivify subsumed");
         LOGBINARY (lit, other, "vivify subsuming"); // Might be jumped!
@@ -538,14 +539,14 @@ static void vivify_deduce (vivifier *vivifier, clause *candidate,
       }
       assert (VALUE (other) < 0);
       assigned *b = ASSIGNED (other);
-      assert (b->level);
+      assert (LEVEL (other));
       if (b->analyzed)
         continue;
       LOGBINARY (lit, other, "vivify analyzing %s reason", LOGLIT (lit));
       b->analyzed = true;
       PUSH_STACK (solver->analyzed, other);
     } else {
-      const reference ref = a->reason;
+      const reference ref = lit_reason;
       LOGREF (ref, "vivify analyzing %s reason", LOGLIT (lit));
       clause *reason = kissat_dereference_clause (solver, ref);
       assert (reason != candidate);
@@ -560,7 +561,7 @@ static void vivify_deduce (vivifier *vivifier, clause *candidate,
         assert (other != not_lit);
         assert (VALUE (other) < 0);
         assigned *b = ASSIGNED (other);
-        if (!b->level)
+        if (!LEVEL (other))
           continue;
         if (b->analyzed)
           continue;
@@ -626,12 +627,12 @@ static bool vivify_shrinkable (kissat *solver, unsigneds *sorted,
       assert (value < 0);
       const unsigned idx = IDX (lit);
       const struct assigned *const a = assigned + idx;
-      assert (a->level);
+      assert (ASSIGNED_LEVEL (assigned, idx));
       if (!a->analyzed) {
         LOG ("vivification non-analyzed %s thus shrinking", LOGLIT (lit));
         return true;
       }
-      if (a->reason != DECISION_REASON) {
+      if (ASSIGNED_REASON (assigned, idx) != DECISION_REASON) {
         LOG ("vivification implied falsified %s thus shrinking",
              LOGLIT (lit));
         return true;
@@ -990,11 +991,11 @@ static bool vivify_clause (vivifier *vivifier, clause *candidate) {
   reference cand_ref = kissat_reference_clause (solver, candidate);
   if (unit != INVALID_LIT) {
     assigned *a = ASSIGNED (unit);
-    assert (a->level);
+    assert (LEVEL (unit));
     if (a->binary)
       unit = INVALID_LIT;
     else {
-      if (a->reason != cand_ref)
+      if (REASON (unit) != cand_ref)
         unit = INVALID_LIT;
     }
   }
@@ -1419,7 +1420,8 @@ void kissat_vivify (kissat *solver) {
   solver->vivifying = true;
 #endif
 
-  SET_EFFORT_LIMIT (limit, vivify, probing_ticks);
+  START_PAYOFF (vivify, probing_ticks);
+  SET_PAYOFF_EFFORT_LIMIT (limit, vivify, probing_ticks);
   const uint64_t total = limit - solver->statistics.probing_ticks;
   limit = solver->statistics.probing_ticks;
   unsigned tier1_limit = vivify_tier1_limit (solver);
@@ -1476,5 +1478,6 @@ void kissat_vivify (kissat *solver) {
   assert (solver->vivifying);
   solver->vivifying = false;
 #endif
+  STOP_PAYOFF (vivify, probing_ticks);
   STOP (vivify);
 }
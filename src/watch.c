@@ -164,6 +164,8 @@ void kissat_watch_large_clauses (kissat *solver) {
     kissat_push_blocking_watch (solver, watches + l0, l1, ref);
     kissat_push_blocking_watch (solver, watches + l1, l0, ref);
   }
+
+  kissat_rebuild_slabs (solver, LITS, watches);
 }
 
 void kissat_connect_irredundant_large_clauses (kissat *solver) {
@@ -1,5 +1,6 @@
 #include "weaken.h"
 #include "inline.h"
+#include "sort.h"
 
 static void push_witness_literal (kissat *solver, unsigned ilit) {
   assert (!VALUE (ilit));
@@ -26,6 +27,45 @@ static void push_clause_literal (kissat *solver, unsigned ilit) {
   }
 }
 
+#define LESS_UNSIGNED(A, B) ((A) < (B))
+
+// Instead of pushing the non-witness literals of long clauses literal by
+// literal on the extension stack we only push a zero literal, which marks
+// the clause as compressed.  The actual literals are encoded in sorted
+// order as variable length integer deltas on the 'compressed' byte stack
+// (see 'kissat_compress_extension' in 'extend.c'), such that the encoded
+// clauses can be traversed backward from the end as 'kissat_extend' does.
+
+static void push_compressed_clause_literals (kissat *solver, unsigned lit,
+                                             clause *c) {
+  unsigneds *ulits = &solver->decompressed;
+  assert (EMPTY_STACK (*ulits));
+  const value *const values = solver->values;
+  for (all_literals_in_clause (other, c)) {
+    if (other == lit)
+      continue;
+    const value value = values[other];
+    assert (value <= 0);
+    if (value < 0)
+      continue;
+    const int elit = kissat_export_literal (solver, other);
+    assert (elit);
+    const unsigned ulit = 2u * ABS (elit) + (elit < 0);
+    PUSH_STACK (*ulits, ulit);
+  }
+  SORT_STACK (unsigned, *ulits, LESS_UNSIGNED);
+  const size_t size = SIZE_STACK (*ulits);
+  const size_t bytes = kissat_compress_extension (solver, ulits);
+  CLEAR_STACK (*ulits);
+  const extension ext = kissat_extension (false, 0);
+  PUSH_STACK (solver->extend, ext);
+  LOG2 ("pushed %zu compressed external clause literals in %zu bytes",
+        size, bytes);
+  ADD (weakened_compressed_literals, size);
+  ADD (weakened_compressed_bytes, bytes);
+  INC (weakened_compressed);
+}
+
 #define LOGPUSHED(SIZE) \
   do { \
     LOGEXT ((SIZE), END_STACK (solver->extend) - (SIZE), \
@@ -37,10 +77,16 @@ void kissat_weaken_clause (kissat *solver, unsigned lit, clause *c) {
   INC (weakened);
   LOGCLS (c, "blocking on %s and weakening", LOGLIT (lit));
   push_witness_literal (solver, lit);
-  for (all_literals_in_clause (other, c))
-    if (lit != other)
-      push_clause_literal (solver, other);
-  LOGPUSHED (c->size);
+  if (GET_OPTION (compress) &&
+      c->size >= (unsigned) GET_OPTION (compresslim)) {
+    push_compressed_clause_literals (solver, lit, c);
+    LOGPUSHED (2);
+  } else {
+    for (all_literals_in_clause (other, c))
+      if (lit != other)
+        push_clause_literal (solver, other);
+    LOGPUSHED (c->size);
+  }
 }
 
 void kissat_weaken_binary (kissat *solver, unsigned lit, unsigned other) {
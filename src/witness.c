@@ -5,37 +5,129 @@
 #include <stdio.h>
 #include <string.h>
 
-static void flush_buffer (chars *buffer) {
-  fputs ("v", stdout);
-  for (all_stack (char, ch, *buffer))
-    fputc (ch, stdout);
-  fputc ('\n', stdout);
-  CLEAR_STACK (*buffer);
+// To print large models fast, the model is extended once and values are
+// then read directly in a single pass over 'import' (instead of calling
+// 'kissat_value' for each variable).  Integers are formatted by hand into
+// a large buffer which is written in big chunks.
+
+#define MAX_LINE_LENGTH 77
+#define WRITER_BUFFER_SIZE (1u << 16)
+
+typedef struct writer writer;
+
+struct writer {
+  FILE *file;
+  char prefix;
+  size_t line;
+  char *end;
+  char buffer[WRITER_BUFFER_SIZE];
+};
+
+static void flush_writer (writer *writer) {
+  const size_t size = writer->end - writer->buffer;
+  fwrite (writer->buffer, 1, size, writer->file);
+  writer->end = writer->buffer;
 }
 
-static void print_int (kissat *solver, chars *buffer, int i) {
+static void init_writer (writer *writer, FILE *file, char prefix) {
+  writer->file = file;
+  writer->prefix = prefix;
+  writer->end = writer->buffer;
+  *writer->end++ = prefix;
+  writer->line = 0;
+}
+
+static void write_int (writer *writer, int i) {
   char tmp[16];
-  sprintf (tmp, " %d", i);
-  size_t tmp_len = strlen (tmp);
-  size_t buf_len = SIZE_STACK (*buffer);
-  if (buf_len + tmp_len > 77)
-    flush_buffer (buffer);
-  for (const char *p = tmp; *p; p++)
-    PUSH_STACK (*buffer, *p);
+  char *const end = tmp + sizeof tmp, *p = end;
+  unsigned u = i < 0 ? -(unsigned) i : (unsigned) i;
+  do
+    *--p = '0' + u % 10;
+  while (u /= 10);
+  if (i < 0)
+    *--p = '-';
+  *--p = ' ';
+  const size_t len = end - p;
+  if (writer->end + len + 3 > writer->buffer + WRITER_BUFFER_SIZE)
+    flush_writer (writer);
+  if (writer->line + len > MAX_LINE_LENGTH) {
+    *writer->end++ = '\n';
+    *writer->end++ = writer->prefix;
+    writer->line = 0;
+  }
+  memcpy (writer->end, p, len);
+  writer->end += len;
+  writer->line += len;
+}
+
+static void release_writer (writer *writer) {
+  write_int (writer, 0);
+  *writer->end++ = '\n';
+  flush_writer (writer);
+}
+
+static int external_value (kissat *solver, int eidx) {
+  assert (eidx > 0);
+  const int tmp = kissat_extended_value (solver, eidx);
+  return tmp < 0 ? -eidx : tmp > 0 ? eidx : 0;
 }
 
 void kissat_print_witness (kissat *solver, int max_var, bool partial) {
-  chars buffer;
-  INIT_STACK (buffer);
+  kissat_extend_model (solver);
+  writer *writer = kissat_malloc (solver, sizeof *writer);
+  init_writer (writer, stdout, 'v');
   for (int eidx = 1; eidx <= max_var; eidx++) {
-    int tmp = kissat_value (solver, eidx);
+    int tmp = external_value (solver, eidx);
     if (!tmp && !partial)
       tmp = eidx;
     if (tmp)
-      print_int (solver, &buffer, tmp);
+      write_int (writer, tmp);
+  }
+  release_writer (writer);
+  kissat_free (solver, writer, sizeof *writer);
+}
+
+void kissat_print_values (kissat *solver, int max_var, const int *values,
+                          bool partial) {
+  writer *writer = kissat_malloc (solver, sizeof *writer);
+  init_writer (writer, stdout, 'v');
+  for (int eidx = 1; eidx <= max_var; eidx++) {
+    int tmp = values[eidx];
+    if (!tmp && !partial)
+      tmp = eidx;
+    if (tmp)
+      write_int (writer, tmp);
+  }
+  release_writer (writer);
+  kissat_free (solver, writer, sizeof *writer);
+}
+
+void kissat_print_backbone (kissat *solver, int max_var) {
+  writer *writer = kissat_malloc (solver, sizeof *writer);
+  init_writer (writer, stdout, 'b');
+  for (int eidx = 1; eidx <= max_var; eidx++) {
+    const int tmp = kissat_backbone (solver, eidx);
+    if (tmp)
+      write_int (writer, tmp);
+  }
+  release_writer (writer);
+  kissat_free (solver, writer, sizeof *writer);
+}
+
+bool kissat_write_binary_model (kissat *solver, int max_var, FILE *file) {
+  kissat_extend_model (solver);
+  if (fprintf (file, "kissat-model %d\n", max_var) < 0)
+    return false;
+  unsigned char byte = 0;
+  for (int eidx = 1; eidx <= max_var; eidx++) {
+    const unsigned bit = (eidx - 1) & 7;
+    if (external_value (solver, eidx) >= 0)
+      byte |= 1u << bit;
+    if (bit == 7 || eidx == max_var) {
+      if (putc (byte, file) == EOF)
+        return false;
+      byte = 0;
+    }
   }
-  print_int (solver, &buffer, 0);
-  assert (!EMPTY_STACK (buffer));
-  flush_buffer (&buffer);
-  RELEASE_STACK (buffer);
+  return !fflush (file);
 }
@@ -2,9 +2,24 @@
 #define _witness_h_INCLUDED
 
 #include <stdbool.h>
+#include <stdio.h>
 
 struct kissat;
 
 void kissat_print_witness (struct kissat *, int max_var, bool partial);
+void kissat_print_backbone (struct kissat *, int max_var);
+
+// Prints 'values[1..max_var]' given in the format of 'kissat_model' as
+// witness (used for models reconstructed outside of the solver).
+
+void kissat_print_values (struct kissat *, int max_var, const int *values,
+                          bool partial);
+
+// The binary model format consists of a header line 'kissat-model <n>'
+// followed by '(n + 7) / 8' bytes, where bit 'i % 8' of byte 'i / 8' is
+// set iff variable 'i + 1' is true.  As in the default 'v' lines
+// unassigned variables are considered to be true.
+
+bool kissat_write_binary_model (struct kissat *, int max_var, FILE *);
 
 #endif
@@ -98,6 +98,35 @@ void tissat_init_solver (kissat *solver) {
   solver->watching = true;
 }
 
+size_t tissat_random_clauses (generator *random, int max_var, int clauses,
+                              int min_size, int max_size, bool *planted,
+                              int *lits) {
+  assert (0 < min_size && min_size <= max_size);
+  if (planted)
+    for (int idx = 1; idx <= max_var; idx++)
+      planted[idx] = kissat_pick_bool (random);
+  int *p = lits;
+  for (int i = 0; i < clauses; i++) {
+    int size = min_size;
+    if (min_size < max_size)
+      size += kissat_pick_random (random, 0, max_size - min_size + 1);
+    bool satisfied = false;
+    for (int j = 0; j < size; j++) {
+      const int idx = 1 + kissat_pick_random (random, 0, max_var);
+      bool sign = kissat_pick_bool (random);
+      if (planted) {
+        if (j == size - 1 && !satisfied)
+          sign = !planted[idx];
+        if (sign != planted[idx])
+          satisfied = true;
+      }
+      *p++ = sign ? -idx : idx;
+    }
+    *p++ = 0;
+  }
+  return p - lits;
+}
+
 static bool find_test_directory (void) {
   struct stat buf;
   return !stat ("../test", &buf);
@@ -448,6 +477,7 @@ int main (int argc, char **argv) {
   SCHEDULE (arena);
   SCHEDULE (heap);
   SCHEDULE (vector);
+  SCHEDULE (compress);
   SCHEDULE (rank);
   SCHEDULE (sort);
   SCHEDULE (bump);
@@ -462,6 +492,15 @@ int main (int argc, char **argv) {
   SCHEDULE (collect);
   SCHEDULE (kitten);
   SCHEDULE (solve);
+  SCHEDULE (backbone);
+  SCHEDULE (model);
+  SCHEDULE (bandit);
+  SCHEDULE (share);
+  SCHEDULE (propagator);
+  SCHEDULE (hints);
+  SCHEDULE (cache);
+  SCHEDULE (snapshot);
+  SCHEDULE (reconstruct);
   SCHEDULE (coverage);
   SCHEDULE (terminate);
 
@@ -3,6 +3,7 @@
 
 #include "../src/inline.h"
 #include "../src/print.h"
+#include "../src/random.h"
 
 #include "testapplication.h"
 #include "testdivert.h"
@@ -70,6 +71,15 @@ extern const char *tissat_root;
 
 void tissat_init_solver (struct kissat *);
 
+// Generates random clauses with 'min_size' up to 'max_size' literals into
+// 'lits' and returns the number of generated literals (including the zero
+// terminating each clause).  If 'planted' is non-zero it is filled with a
+// random assignment satisfied by all the generated clauses.
+
+size_t tissat_random_clauses (generator *, int max_var, int clauses,
+                              int min_size, int max_size, bool *planted,
+                              int *lits);
+
 extern kissat kissat_test_dummy_solver;
 
 #define DECLARE_AND_INIT_SOLVER(SOLVER) \
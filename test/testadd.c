@@ -1,3 +1,5 @@
+#include "../src/random.h"
+
 #include "test.h"
 
 static word full_clauses;
@@ -33,4 +35,89 @@ static void test_add (void) {
   }
 }
 
-void tissat_schedule_add (void) { SCHEDULE_FUNCTION (test_add); }
+static void test_add_duplicated (void) {
+  kissat *solver = kissat_init ();
+  tissat_init_solver (solver);
+  const int clauses[] = {1, 2, 3, 0, 3, 1, 2, 0, 2, -3, 1, 0, 2, 3, 1, 2, 0,
+                         1, 2, 3, 4, 0, -1, -2, -3, 0};
+  const size_t size = sizeof clauses / sizeof *clauses;
+  for (size_t i = 0; i < size; i++)
+    kissat_add (solver, clauses[i]);
+  const unsigned deduplicated = GET_OPTION (deduplicate) ? 2 : 0;
+#ifdef STATISTICS
+  assert (solver->statistics.deduplicated == deduplicated);
+#endif
+  assert (solver->statistics.clauses_original == 6 - deduplicated);
+  const int res = kissat_solve (solver);
+  assert (res == 10);
+  assert (!solver->duplicates.table);
+  kissat_release (solver);
+}
+
+static void compare_solvers (kissat *expected, kissat *actual) {
+  assert (expected->statistics.clauses_original ==
+          actual->statistics.clauses_original);
+  assert (expected->statistics.clauses_binary ==
+          actual->statistics.clauses_binary);
+  assert (SIZE_STACK (expected->arena) == SIZE_STACK (actual->arena));
+  assert (expected->vars == actual->vars);
+  const int res = kissat_solve (expected);
+  if (kissat_solve (actual) != res)
+    FATAL ("batch added clauses give different result than single adds");
+  kissat_release (expected);
+  kissat_release (actual);
+}
+
+static void test_add_clauses (void) {
+  const int max_var = 60, clauses = 250;
+  int lits[6 * clauses];
+  generator random = 42;
+  for (int round = 0; round < (tissat_big ? 40 : 10); round++) {
+    const size_t size =
+        tissat_random_clauses (&random, max_var, clauses, 1, 5, 0, lits);
+    kissat *expected = kissat_init ();
+    kissat *actual = kissat_init ();
+    tissat_init_solver (expected);
+    tissat_init_solver (actual);
+    for (size_t i = 0; i < size; i++)
+      kissat_add (expected, lits[i]);
+    size_t split = size / 2;
+    while (lits[split - 1])
+      split++;
+    kissat_add_clauses (actual, split, lits);
+    kissat_add_clauses (actual, size - split, lits + split);
+    kissat_add_clauses (actual, 0, 0);
+    compare_solvers (expected, actual);
+  }
+}
+
+static void test_add_clause (void) {
+  const int max_var = 60, clauses = 250;
+  int lits[6 * clauses];
+  generator random = 24;
+  for (int round = 0; round < (tissat_big ? 40 : 10); round++) {
+    const size_t size =
+        tissat_random_clauses (&random, max_var, clauses, 1, 5, 0, lits);
+    kissat *expected = kissat_init ();
+    kissat *actual = kissat_init ();
+    tissat_init_solver (expected);
+    tissat_init_solver (actual);
+    const int *begin = lits;
+    for (size_t i = 0; i < size; i++) {
+      kissat_add (expected, lits[i]);
+      if (lits[i])
+        continue;
+      const int *end = lits + i;
+      kissat_add_clause (actual, end - begin, begin);
+      begin = end + 1;
+    }
+    compare_solvers (expected, actual);
+  }
+}
+
+void tissat_schedule_add (void) {
+  SCHEDULE_FUNCTION (test_add);
+  SCHEDULE_FUNCTION (test_add_duplicated);
+  SCHEDULE_FUNCTION (test_add_clauses);
+  SCHEDULE_FUNCTION (test_add_clause);
+}
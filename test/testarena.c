@@ -122,7 +122,8 @@ static void test_arena_fatal (void) {
                       FORMAT_BYTES (capacity * sizeof (ward)));
       assert (capacity == MAX_ARENA);
       assert (size + 1 == MAX_ARENA);
-      kissat_allocate_clause (solver, 3);
+      assert (kissat_bytes_of_clause (8) > sizeof (ward));
+      kissat_allocate_clause (solver, 8);
     }
     kissat_call_function_instead_of_abort (0);
     FATAL ("long jump not taken");
@@ -0,0 +1,83 @@
+#ifndef NOPTIONS
+
+#include "../src/random.h"
+
+#include "test.h"
+
+static void add_clauses (kissat *solver, size_t size, const int *lits) {
+  for (size_t i = 0; i < size; i++)
+    kissat_add (solver, lits[i]);
+}
+
+static bool implied (size_t size, const int *lits, int lit) {
+  kissat *solver = kissat_init ();
+  tissat_init_solver (solver);
+  add_clauses (solver, size, lits);
+  kissat_add (solver, -lit);
+  kissat_add (solver, 0);
+  const int res = kissat_solve (solver);
+  kissat_release (solver);
+  return res == 20;
+}
+
+static void check_backbone (int max_var, size_t size, const int *lits) {
+  kissat *solver = kissat_init ();
+  tissat_init_solver (solver);
+  solver->options.incremental = 1;
+  add_clauses (solver, size, lits);
+  const int res = kissat_solve (solver);
+  if (res != 10) {
+    kissat_release (solver);
+    return;
+  }
+  for (int idx = 1; idx <= max_var; idx++) {
+    const int lit = kissat_value (solver, idx);
+    const int backbone = kissat_backbone (solver, idx);
+    if (implied (size, lits, lit)) {
+      if (backbone != lit)
+        FATAL ("expected backbone literal %d but got %d", lit, backbone);
+    } else if (backbone)
+      FATAL ("unexpected backbone literal %d", backbone);
+    if (kissat_backbone (solver, -idx) != -backbone)
+      FATAL ("backbone of %d and %d inconsistent", idx, -idx);
+  }
+  kissat_release (solver);
+}
+
+static void test_backbone_small (void) {
+  const int lits[] = {1, 2, 0, -1, 2, 0, 3, 4, 0, -3, -5, 0};
+  check_backbone (5, sizeof lits / sizeof *lits, lits);
+}
+
+static void test_backbone_equivalences (void) {
+  const int lits[] = {1,  -2, 0, -1, 2,  0, 2,  -3, 0, -2, 3,
+                      0,  3,  4, 0,  3,  -4, 0, 5,  6, 7,  0};
+  check_backbone (7, sizeof lits / sizeof *lits, lits);
+}
+
+static void test_backbone_random (void) {
+  const int max_var = 40, clauses = 150;
+  int lits[4 * clauses];
+  generator random = 42;
+  for (int round = 0; round < (tissat_big ? 40 : 10); round++) {
+    int *p = lits;
+    for (int i = 0; i < clauses; i++) {
+      for (int j = 0; j < 3; j++) {
+        const int idx = 1 + kissat_pick_random (&random, 0, max_var);
+        *p++ = kissat_pick_bool (&random) ? -idx : idx;
+      }
+      *p++ = 0;
+    }
+    check_backbone (max_var, p - lits, lits);
+  }
+}
+
+#endif
+
+void tissat_schedule_backbone (void) {
+#ifndef NOPTIONS
+  SCHEDULE_FUNCTION (test_backbone_small);
+  SCHEDULE_FUNCTION (test_backbone_equivalences);
+  SCHEDULE_FUNCTION (test_backbone_random);
+#endif
+}
@@ -0,0 +1,47 @@
+#include "test.h"
+
+#ifndef NOPTIONS
+
+// With frequent mode switches every arm is pulled in both modes (since
+// arms which have not been pulled yet are selected first) and thus the
+// selected arms have to be switched.
+
+static void test_bandit_pulls (void) {
+  const int max_var = 200, clauses = 852;
+  int lits[4 * clauses];
+  generator random = 23;
+  const size_t size =
+      tissat_random_clauses (&random, max_var, clauses, 3, 3, 0, lits);
+  kissat *solver = kissat_init ();
+  tissat_init_solver (solver);
+  kissat_set_option (solver, "bandit", 1);
+  kissat_set_option (solver, "modeinit", 100);
+  kissat_set_option (solver, "modeint", 10);
+  kissat_add_clauses (solver, size, lits);
+  const int res = kissat_solve (solver);
+  if (res != 10 && res != 20)
+    FATAL ("unexpected result '%d'", res);
+  const bandit *const bandit = &solver->bandit;
+  for (unsigned mode = 0; mode != 2; mode++)
+    for (unsigned arm = 0; arm != BANDIT_ARMS; arm++) {
+      const uint64_t pulls = bandit->arms[mode][arm].pulls;
+      printf ("arm %u in %s mode pulled %" PRIu64 " times\n", arm,
+              mode ? "stable" : "focused", pulls);
+      if (!pulls)
+        FATAL ("arm %u in %s mode not pulled", arm,
+               mode ? "stable" : "focused");
+    }
+  const uint64_t switched = solver->statistics.bandit_switched;
+  printf ("switched %" PRIu64 " times\n", switched);
+  if (switched < 2 * (BANDIT_ARMS - 1))
+    FATAL ("bandit switched only %" PRIu64 " times", switched);
+  kissat_release (solver);
+}
+
+#endif
+
+void tissat_schedule_bandit (void) {
+#ifndef NOPTIONS
+  SCHEDULE_FUNCTION (test_bandit_pulls);
+#endif
+}
@@ -0,0 +1,260 @@
+#include "../src/cache.h"
+
+#include "test.h"
+
+#include <inttypes.h>
+
+static void check_cache_header (const char *path) {
+  FILE *file = fopen (path, "r");
+  if (!file)
+    FATAL ("could not read cache file '%s'", path);
+  char header[16];
+  const size_t size = sizeof "kissat-cache" - 1;
+  if (fread (header, 1, size, file) != size ||
+      memcmp (header, "kissat-cache", size))
+    FATAL ("invalid header in cache file '%s'", path);
+  fclose (file);
+}
+
+// The first run writes the cache and the second run reads it (and imports
+// at least the empty clause for unsatisfiable formulas).
+
+static void test_cache_reuse (void) {
+  if (!tissat_found_test_directory)
+    return;
+  const char *path = "reuse.cache";
+  remove (path);
+  tissat_call_application (20, "../test/cnf/ph5.cnf --cache=reuse.cache");
+  check_cache_header (path);
+  tissat_call_application (20, "../test/cnf/ph5.cnf --cache=reuse.cache");
+  check_cache_header (path);
+  tissat_call_application (10, "../test/cnf/ite10.cnf --cache=reuse.cache");
+  tissat_call_application (10, "../test/cnf/ite10.cnf --cache=reuse.cache");
+  remove (path);
+}
+
+static kissat *new_solver (size_t size, const int *lits) {
+  kissat *solver = kissat_init ();
+  tissat_init_solver (solver);
+#ifndef NOPTIONS
+  kissat_set_option (solver, "lucky", 0);
+  kissat_set_option (solver, "preprocess", 0);
+#endif
+  kissat_add_clauses (solver, size, lits);
+  return solver;
+}
+
+// Solves the formula, writes the cache and returns a new solver for the
+// same formula which has read the cache and already solved the formula.
+
+static kissat *reuse_cache (size_t size, const int *lits, int expected) {
+  kissat *solver = new_solver (size, lits);
+  int res = kissat_solve (solver);
+  if (res != expected)
+    FATAL ("expected '%d' but got '%d' while writing cache", expected,
+           res);
+  FILE *file = tmpfile ();
+  if (!file)
+    FATAL ("could not open temporary file");
+  const uint64_t conflicts = solver->statistics.conflicts;
+  const int max_var = solver->vars;
+  if (!kissat_write_cache (solver, max_var, res, file))
+    FATAL ("failed to write cache");
+  kissat_release (solver);
+  rewind (file);
+  solver = new_solver (size, lits);
+  cache cache;
+  memset (&cache, 0, sizeof cache);
+  const char *error = kissat_read_cache (solver, &cache, file);
+  fclose (file);
+  if (error)
+    FATAL ("reading cache failed: %s", error);
+  res = kissat_solve (solver);
+  if (res != expected)
+    FATAL ("expected '%d' but got '%d' while reading cache", expected,
+           res);
+  kissat_release_cache (solver, &cache);
+  printf ("%" PRIu64 " conflicts without and %" PRIu64 " conflicts and "
+          "%" PRIu64 " imported clauses with cache\n",
+          conflicts, solver->statistics.conflicts,
+          solver->statistics.clauses_imported);
+  return solver;
+}
+
+// For unsatisfiable formulas at least the cached empty clause is imported
+// while for satisfiable formulas the cached phases of the model of the
+// first run yield a model without any conflict in the second run.
+
+static size_t pigeon_hole_clauses (int holes, int *lits) {
+  const int pigeons = holes + 1;
+  int *p = lits;
+#define PH(P, H) ((P) * holes + (H) + 1)
+  for (int i = 0; i < pigeons; i++) {
+    for (int h = 0; h < holes; h++)
+      *p++ = PH (i, h);
+    *p++ = 0;
+  }
+  for (int h = 0; h < holes; h++)
+    for (int i = 0; i < pigeons; i++)
+      for (int j = i + 1; j < pigeons; j++)
+        *p++ = -PH (i, h), *p++ = -PH (j, h), *p++ = 0;
+#undef PH
+  return p - lits;
+}
+
+#define PIGEON_HOLE_LITERALS(HOLES) \
+  ((HOLES) + 1) * ((HOLES) + 1) + (HOLES) * ((HOLES) + 1) * (HOLES) * 3 / 2
+
+static void test_cache_import (void) {
+  int lits[PIGEON_HOLE_LITERALS (5)];
+  const size_t size = pigeon_hole_clauses (5, lits);
+  kissat *solver = reuse_cache (size, lits, 20);
+  if (!solver->statistics.clauses_imported)
+    FATAL ("no cached clauses imported");
+  kissat_release (solver);
+}
+
+static void test_cache_phases (void) {
+  const int max_var = 200, clauses = 840;
+  int lits[4 * clauses];
+  generator random = 17;
+  for (int round = 0; round < (tissat_big ? 10 : 3); round++) {
+    bool planted[max_var + 1];
+    const size_t size = tissat_random_clauses (&random, max_var, clauses,
+                                               3, 3, planted, lits);
+    kissat *solver = reuse_cache (size, lits, 10);
+#ifndef NOPTIONS
+    if (solver->statistics.conflicts)
+      FATAL ("unexpected %" PRIu64 " conflicts with cached phases",
+             solver->statistics.conflicts);
+#endif
+    kissat_release (solver);
+  }
+}
+
+static void test_cache_invalid (void) {
+  if (!tissat_found_test_directory)
+    return;
+  const char *path = "invalid.cache";
+  FILE *file = fopen (path, "w");
+  if (!file)
+    FATAL ("could not write '%s'", path);
+  fputs ("kissat-cache 1 0123456789abcdef\n1 -2 x 0\n", file);
+  fclose (file);
+  tissat_call_application (1, "../test/cnf/add8.cnf --cache=invalid.cache");
+  file = fopen (path, "w");
+  if (!file)
+    FATAL ("could not write '%s'", path);
+  fputs ("kissat-cache 0123456789abcdef\n1 -2 0\n", file);
+  fclose (file);
+  tissat_call_application (1, "../test/cnf/add8.cnf --cache=invalid.cache");
+  remove (path);
+  tissat_call_application (1, "../test/cnf/add8.cnf "
+                              "--cache=/non/existing/cache");
+}
+
+#ifndef NOPTIONS
+
+typedef struct flushed flushed;
+
+struct flushed {
+  kissat *solver;
+  FILE *file;
+  unsigned flushes;
+};
+
+static void flush_cache (void *state) {
+  flushed *flushed = state;
+  if (flushed->file)
+    fclose (flushed->file);
+  flushed->file = tmpfile ();
+  if (!flushed->file)
+    FATAL ("could not open temporary file");
+  kissat *solver = flushed->solver;
+  if (!kissat_write_cache (solver, solver->vars, 0, flushed->file))
+    FATAL ("failed to flush cache");
+  flushed->flushes++;
+}
+
+static uint64_t solve_pigeon_hole (size_t size, const int *lits,
+                                   FILE *file) {
+  kissat *solver = new_solver (size, lits);
+  cache cache;
+  memset (&cache, 0, sizeof cache);
+  if (file) {
+    rewind (file);
+    const char *error = kissat_read_cache (solver, &cache, file);
+    if (error)
+      FATAL ("reading flushed cache failed: %s", error);
+  }
+  const int res = kissat_solve (solver);
+  if (res != 20)
+    FATAL ("expected '20' but got '%d'", res);
+  kissat_release_cache (solver, &cache);
+  const uint64_t conflicts = solver->statistics.conflicts;
+  kissat_release (solver);
+  return conflicts;
+}
+
+// The cache is flushed periodically during a run which is interrupted by
+// a conflict limit.  A run which resumes from the last flushed cache needs
+// fewer conflicts than a run from scratch.
+
+static void test_cache_flush (void) {
+  int lits[PIGEON_HOLE_LITERALS (7)];
+  const size_t size = pigeon_hole_clauses (7, lits);
+  kissat *solver = new_solver (size, lits);
+  kissat_set_option (solver, "cacheint", 500);
+  flushed flushed;
+  memset (&flushed, 0, sizeof flushed);
+  flushed.solver = solver;
+  kissat_set_cache_flush (solver, &flushed, flush_cache);
+  kissat_set_conflict_limit (solver, 2000);
+  const int res = kissat_solve (solver);
+  if (res)
+    FATAL ("expected '0' but got '%d'", res);
+  if (solver->statistics.cache_flushes != flushed.flushes)
+    FATAL ("cache flushes statistics do not match");
+  kissat_release (solver);
+  if (flushed.flushes < 3)
+    FATAL ("expected at least 3 cache flushes but got %u",
+           flushed.flushes);
+  const uint64_t scratch = solve_pigeon_hole (size, lits, 0);
+  const uint64_t resumed = solve_pigeon_hole (size, lits, flushed.file);
+  fclose (flushed.file);
+  printf ("%u flushes, %" PRIu64 " conflicts from scratch and %" PRIu64
+          " resumed\n",
+          flushed.flushes, scratch, resumed);
+  if (resumed >= scratch)
+    FATAL ("resumed run did not keep progress");
+}
+
+#endif
+
+// The cache is also flushed during search by the application.
+
+static void test_cache_application_flush (void) {
+  if (!tissat_found_test_directory)
+    return;
+  const char *path = "flush.cache";
+  remove (path);
+#ifdef NOPTIONS
+  tissat_call_application (20, "../test/cnf/ph6.cnf --cache=flush.cache");
+#else
+  tissat_call_application (20, "../test/cnf/ph6.cnf --cache=flush.cache "
+                               "--cacheint=10");
+#endif
+  check_cache_header (path);
+  remove (path);
+}
+
+void tissat_schedule_cache (void) {
+  SCHEDULE_FUNCTION (test_cache_reuse);
+  SCHEDULE_FUNCTION (test_cache_import);
+  SCHEDULE_FUNCTION (test_cache_phases);
+#ifndef NOPTIONS
+  SCHEDULE_FUNCTION (test_cache_flush);
+#endif
+  SCHEDULE_FUNCTION (test_cache_application_flush);
+  SCHEDULE_FUNCTION (test_cache_invalid);
+}
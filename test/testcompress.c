@@ -0,0 +1,91 @@
+#include "../src/allocate.h"
+#include "../src/extend.h"
+#include "../src/internal.h"
+
+#include "test.h"
+
+// Checks that clauses compressed on the 'compressed' byte stack by
+// 'kissat_compress_extension' are decompressed in reverse order by
+// 'kissat_decompress_extension' traversing the stack backward, which is
+// how 'kissat_extend' uses them.
+
+#define MAX_CLAUSES 16
+
+static void push_long_clause (kissat *solver, unsigneds *clause,
+                              unsigned ulit, unsigned size) {
+  for (unsigned i = 0; i < size; i++, ulit += 128)
+    PUSH_STACK (*clause, ulit);
+}
+
+static void test_compress_boundaries (void) {
+  DECLARE_AND_INIT_SOLVER (solver);
+  unsigneds clauses[MAX_CLAUSES];
+  size_t bytes[MAX_CLAUSES];
+  memset (clauses, 0, sizeof clauses);
+  unsigned size_clauses = 0;
+#define CLAUSE(...) \
+  do { \
+    const unsigned lits[] = {__VA_ARGS__}; \
+    assert (size_clauses < MAX_CLAUSES); \
+    unsigneds *clause = clauses + size_clauses++; \
+    for (size_t i = 0; i < sizeof lits / sizeof *lits; i++) \
+      PUSH_STACK (*clause, lits[i]); \
+  } while (0)
+  // Single literals at the one to two and two to three byte boundaries
+  // of variable length integers and of both polarities.
+  CLAUSE (127);
+  CLAUSE (128);
+  CLAUSE (16383);
+  CLAUSE (16384);
+  // Deltas at the same boundaries.
+  CLAUSE (2, 129, 257, 16640, 33024);
+  CLAUSE (3, 130, 131, 16514, 16515);
+  // Long clauses whose size needs two bytes and whose encoding of 16383,
+  // 16384 and 16385 bytes needs two and three bytes for its length.
+  push_long_clause (solver, clauses + size_clauses++, 3, 8191);
+  push_long_clause (solver, clauses + size_clauses++, 128, 8191);
+  push_long_clause (solver, clauses + size_clauses++, 3, 8192);
+  // Empty clause.
+  size_clauses++;
+#undef CLAUSE
+  for (unsigned i = 0; i < size_clauses; i++) {
+    bytes[i] = kissat_compress_extension (solver, clauses + i);
+    printf ("compressed clause %u of size %zu in %zu bytes\n", i,
+            SIZE_STACK (clauses[i]), bytes[i]);
+  }
+  assert (bytes[0] == 3);
+  assert (bytes[1] == 4);
+  assert (bytes[2] == 4);
+  assert (bytes[3] == 5);
+  assert (bytes[4] == 1 + 1 + 1 + 2 + 2 + 3 + 1);
+  assert (bytes[5] == 1 + 1 + 1 + 1 + 2 + 1 + 1);
+  assert (bytes[6] == 16383 + 2);
+  assert (bytes[7] == 16384 + 3);
+  assert (bytes[8] == 16385 + 3);
+  assert (bytes[9] == 2);
+  const uint8_t *p = END_STACK (solver->compressed);
+  unsigneds decompressed;
+  INIT_STACK (decompressed);
+  for (unsigned i = size_clauses; i--;) {
+    const uint8_t *end = p;
+    p = kissat_decompress_extension (solver, p, &decompressed);
+    assert ((size_t) (end - p) == bytes[i]);
+    const unsigneds *clause = clauses + i;
+    assert (SIZE_STACK (decompressed) == SIZE_STACK (*clause));
+    for (size_t j = 0; j < SIZE_STACK (*clause); j++)
+      assert (PEEK_STACK (decompressed, j) == PEEK_STACK (*clause, j));
+    CLEAR_STACK (decompressed);
+  }
+  assert (p == BEGIN_STACK (solver->compressed));
+  RELEASE_STACK (decompressed);
+  for (unsigned i = 0; i < size_clauses; i++)
+    RELEASE_STACK (clauses[i]);
+  RELEASE_STACK (solver->compressed);
+#ifdef METRICS
+  assert (!solver->statistics.allocated_current);
+#endif
+}
+
+void tissat_schedule_compress (void) {
+  SCHEDULE_FUNCTION (test_compress_boundaries);
+}
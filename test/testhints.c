@@ -0,0 +1,98 @@
+#include "../src/random.h"
+
+#include "test.h"
+
+// Without lucky assignments and preprocessing the first decision is made
+// on the prioritized variable and all decisions follow the hinted phases.
+
+static kissat *new_solver (int stable) {
+  kissat *solver = kissat_init ();
+  tissat_init_solver (solver);
+#ifndef NOPTIONS
+  kissat_set_option (solver, "lucky", 0);
+  kissat_set_option (solver, "preprocess", 0);
+  kissat_set_option (solver, "stable", stable);
+#else
+  (void) stable;
+#endif
+  return solver;
+}
+
+// Exactly one of the variables '1..vars' is true, which is the last
+// prioritized one if all phases are hinted to be positive.
+
+static void check_priority (int stable) {
+  const int vars = 20;
+  kissat *solver = new_solver (stable);
+  for (int idx = 1; idx <= vars; idx++)
+    kissat_add (solver, idx);
+  kissat_add (solver, 0);
+  for (int i = 1; i <= vars; i++)
+    for (int j = i + 1; j <= vars; j++)
+      kissat_add (solver, -i), kissat_add (solver, -j),
+          kissat_add (solver, 0);
+  for (int idx = 1; idx <= vars; idx++)
+    kissat_set_phase (solver, idx);
+  kissat_set_priority (solver, 13);
+  kissat_set_priority (solver, 7);
+  const int res = kissat_solve (solver);
+  if (res != 10)
+    FATAL ("expected '10' but got '%d'", res);
+#ifndef NOPTIONS
+  for (int idx = 1; idx <= vars; idx++) {
+    const int expected = idx == 7 ? idx : -idx;
+    const int value = kissat_value (solver, idx);
+    if (value != expected)
+      FATAL ("expected value '%d' but got '%d'", expected, value);
+  }
+#endif
+  kissat_release (solver);
+}
+
+// Hinting the phases of a planted solution of a random formula yields this
+// solution without any conflict.
+
+static void check_phases (int stable) {
+  const int max_var = 200, clauses = 840;
+  int lits[4 * clauses];
+  generator random = 42;
+  for (int round = 0; round < (tissat_big ? 10 : 3); round++) {
+    bool planted[max_var + 1];
+    const size_t size = tissat_random_clauses (&random, max_var, clauses,
+                                               3, 3, planted, lits);
+    kissat *solver = new_solver (stable);
+    kissat_add_clauses (solver, size, lits);
+    for (int idx = 1; idx <= max_var; idx++)
+      kissat_set_phase (solver, planted[idx] ? idx : -idx);
+    const int res = kissat_solve (solver);
+    if (res != 10)
+      FATAL ("expected '10' but got '%d'", res);
+#ifndef NOPTIONS
+    if (solver->statistics.conflicts)
+      FATAL ("unexpected %" PRIu64 " conflicts",
+             solver->statistics.conflicts);
+    for (int idx = 1; idx <= max_var; idx++) {
+      const int value = kissat_value (solver, idx);
+      const int expected = planted[idx] ? idx : -idx;
+      if (value && value != expected)
+        FATAL ("expected value '%d' but got '%d'", expected, value);
+    }
+#endif
+    kissat_release (solver);
+  }
+}
+
+static void test_hints_priority_focused (void) { check_priority (0); }
+
+static void test_hints_priority_stable (void) { check_priority (2); }
+
+static void test_hints_phases_focused (void) { check_phases (0); }
+
+static void test_hints_phases_stable (void) { check_phases (2); }
+
+void tissat_schedule_hints (void) {
+  SCHEDULE_FUNCTION (test_hints_priority_focused);
+  SCHEDULE_FUNCTION (test_hints_priority_stable);
+  SCHEDULE_FUNCTION (test_hints_phases_focused);
+  SCHEDULE_FUNCTION (test_hints_phases_stable);
+}
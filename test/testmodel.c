@@ -0,0 +1,68 @@
+#include "../src/random.h"
+
+#include "test.h"
+
+static void check_model (int max_var, size_t size, const int *lits) {
+  kissat *solver = kissat_init ();
+  tissat_init_solver (solver);
+  for (size_t i = 0; i < size; i++)
+    kissat_add (solver, lits[i]);
+  const int res = kissat_solve (solver);
+  if (res == 10) {
+    int *model = malloc ((max_var + 2) * sizeof *model);
+    kissat_model (solver, max_var + 1, model);
+    if (model[0])
+      FATAL ("expected 'model[0] = 0' but got '%d'", model[0]);
+    int *queried = malloc (2 * (max_var + 1) * sizeof *queried);
+    int *values = malloc (2 * (max_var + 1) * sizeof *values);
+    int *q = queried;
+    for (int idx = 1; idx <= max_var + 1; idx++)
+      *q++ = idx, *q++ = -idx;
+    const int queries = q - queried;
+    kissat_values (solver, queries, queried, values);
+    for (int i = 0; i < queries; i++) {
+      const int lit = queried[i];
+      const int expected = kissat_value (solver, lit);
+      if (values[i] != expected)
+        FATAL ("expected 'values[%d] = %d' but got '%d'", i, expected,
+               values[i]);
+      if (lit > 0 && model[lit] != expected)
+        FATAL ("expected 'model[%d] = %d' but got '%d'", lit, expected,
+               model[lit]);
+    }
+    free (values);
+    free (queried);
+    free (model);
+  }
+  kissat_release (solver);
+}
+
+static void test_model_empty (void) {
+  kissat *solver = kissat_init ();
+  tissat_init_solver (solver);
+  const int res = kissat_solve (solver);
+  assert (res == 10);
+  int model[3] = {1, 2, 3};
+  kissat_model (solver, 2, model);
+  assert (!model[0]);
+  assert (!model[1]);
+  assert (!model[2]);
+  kissat_values (solver, 0, 0, 0);
+  kissat_release (solver);
+}
+
+static void test_model_random (void) {
+  const int max_var = 40, clauses = 120;
+  int lits[4 * clauses];
+  generator random = 7;
+  for (int round = 0; round < (tissat_big ? 40 : 10); round++) {
+    const size_t size =
+        tissat_random_clauses (&random, max_var, clauses, 3, 3, 0, lits);
+    check_model (max_var, size, lits);
+  }
+}
+
+void tissat_schedule_model (void) {
+  SCHEDULE_FUNCTION (test_model_empty);
+  SCHEDULE_FUNCTION (test_model_random);
+}
@@ -117,6 +117,13 @@ static void test_parse_errors (void) {
     PARSE (2, tabs);
     PARSE (2, headerspaces);
     PARSE (2, eofincommmentafterliteral);
+    PARSE (0, aagshortheader);
+    PARSE (0, aaglatch);
+    PARSE (0, aagtwice);
+    PARSE (0, aagundefined);
+    PARSE (0, aagcyclic);
+    PARSE (0, aigeof);
+    PARSE (0, aigdelta);
   }
 #undef PARSE
 }
@@ -146,9 +153,72 @@ static void test_parse_coverage (void) {
 #undef PARSE
 }
 
+static const char *parse_binary (const char *path, int *res_ptr) {
+  kissat *solver = kissat_init ();
+  tissat_init_solver (solver);
+  file file;
+  if (!kissat_open_to_read_file (&file, path))
+    FATAL ("could not open '%s' for reading", path);
+  uint64_t lineno;
+  int max_var;
+  const char *error = kissat_parse_dimacs (solver, NORMAL_PARSING, &file,
+                                           &lineno, &max_var);
+  kissat_close_file (&file);
+  if (!error)
+    *res_ptr = kissat_solve (solver);
+  kissat_release (solver);
+  return error;
+}
+
+// Converts a DIMACS file to binary CNF, which is parsed and solved, and
+// then checks that a corrupted block is detected through its checksum.
+
+static void test_parse_binary (void) {
+  const char *dimacs = "../test/cnf/prime169.cnf";
+  const char *path = "prime169.kcnf";
+  kissat *solver = kissat_init ();
+  tissat_init_solver (solver);
+  file input, output;
+  if (!kissat_open_to_read_file (&input, dimacs))
+    FATAL ("could not open '%s' for reading", dimacs);
+  if (!kissat_open_to_write_file (&output, path))
+    FATAL ("could not open '%s' for writing", path);
+  uint64_t lineno;
+  int max_var;
+  const char *error = kissat_convert_dimacs (
+      solver, NORMAL_PARSING, &input, &output, &lineno, &max_var);
+  kissat_close_file (&output);
+  kissat_close_file (&input);
+  kissat_release (solver);
+  if (error)
+    FATAL ("converting '%s' failed: %s", dimacs, error);
+  int res = 0;
+  error = parse_binary (path, &res);
+  if (error)
+    FATAL ("parsing '%s' failed: %s", path, error);
+  if (res != 10)
+    FATAL ("expected '10' but got '%d'", res);
+  FILE *file = fopen (path, "r+b");
+  if (!file)
+    FATAL ("could not open '%s' for updating", path);
+  if (fseek (file, -6, SEEK_END))
+    FATAL ("could not seek in '%s'", path);
+  const int ch = getc (file);
+  fseek (file, -1, SEEK_CUR);
+  putc (ch ^ 1, file);
+  fclose (file);
+  error = parse_binary (path, &res);
+  if (!error)
+    FATAL ("parsing corrupted '%s' succeeded unexpectedly", path);
+  tissat_verbose ("%s: %s", path, error);
+  remove (path);
+}
+
 void tissat_schedule_parse (void) {
   if (tissat_found_test_directory)
     SCHEDULE_FUNCTION (test_parse_errors);
   if (tissat_found_test_directory)
     SCHEDULE_FUNCTION (test_parse_coverage);
+  if (tissat_found_test_directory)
+    SCHEDULE_FUNCTION (test_parse_binary);
 }
@@ -0,0 +1,194 @@
+#include "test.h"
+
+// External propagator for the 'at-most-one pigeon per hole' constraints
+// of pigeon hole formulas, which are not added as clauses.  If 'eager' is
+// set, it propagates literals with explanations and reports conflicts
+// through clauses, otherwise it adds clauses only after rejecting models.
+
+typedef struct amo amo;
+
+struct amo {
+  int holes, pigeons;
+  bool eager, rejected;
+  signed char *values;
+  int *levels;
+  int clause[3];
+  size_t propagated, clauses, rejections;
+};
+
+static int pigeon_hole (amo *amo, int p, int h) {
+  return p * amo->holes + h + 1;
+}
+
+static void notify_assignment (void *state, int lit, int level) {
+  amo *amo = state;
+  const int idx = abs (lit);
+  assert (idx <= amo->holes * amo->pigeons);
+  if (amo->values[idx])
+    FATAL ("variable %d assigned twice", idx);
+  amo->values[idx] = lit < 0 ? -1 : 1;
+  amo->levels[idx] = level;
+}
+
+static void notify_backtrack (void *state, int new_level) {
+  amo *amo = state;
+  const int vars = amo->holes * amo->pigeons;
+  for (int idx = 1; idx <= vars; idx++)
+    if (amo->values[idx] && amo->levels[idx] > new_level)
+      amo->values[idx] = 0;
+}
+
+static int true_pigeon (amo *amo, int h, int except) {
+  for (int p = 0; p < amo->pigeons; p++)
+    if (p != except && amo->values[pigeon_hole (amo, p, h)] > 0)
+      return p;
+  return -1;
+}
+
+static const int *add_clause (void *state) {
+  amo *amo = state;
+  if (!amo->eager && !amo->rejected)
+    return 0;
+  for (int h = 0; h < amo->holes; h++) {
+    const int p = true_pigeon (amo, h, -1);
+    if (p < 0)
+      continue;
+    const int q = true_pigeon (amo, h, p);
+    if (q < 0)
+      continue;
+    amo->clause[0] = -pigeon_hole (amo, p, h);
+    amo->clause[1] = -pigeon_hole (amo, q, h);
+    amo->clause[2] = 0;
+    amo->clauses++;
+    return amo->clause;
+  }
+  amo->rejected = false;
+  return 0;
+}
+
+static int propagate (void *state) {
+  amo *amo = state;
+  if (!amo->eager)
+    return 0;
+  for (int h = 0; h < amo->holes; h++) {
+    const int p = true_pigeon (amo, h, -1);
+    if (p < 0)
+      continue;
+    for (int q = 0; q < amo->pigeons; q++) {
+      const int idx = pigeon_hole (amo, q, h);
+      if (q != p && !amo->values[idx]) {
+        amo->propagated++;
+        return -idx;
+      }
+    }
+  }
+  return 0;
+}
+
+static const int *explain (void *state, int lit) {
+  amo *amo = state;
+  assert (lit < 0);
+  const int idx = -lit - 1;
+  const int q = idx / amo->holes, h = idx % amo->holes;
+  const int p = true_pigeon (amo, h, q);
+  assert (p >= 0);
+  amo->clause[0] = lit;
+  amo->clause[1] = -pigeon_hole (amo, p, h);
+  amo->clause[2] = 0;
+  return amo->clause;
+}
+
+static int check_model (void *state, int size, const int *model) {
+  amo *amo = state;
+  if (size != amo->holes * amo->pigeons)
+    FATAL ("expected model of size %d but got %d",
+           amo->holes * amo->pigeons, size);
+  for (int i = 0; i < size; i++) {
+    const int lit = model[i];
+    const int idx = abs (lit);
+    if (amo->values[idx] != (lit < 0 ? -1 : 1))
+      FATAL ("model value of %d does not match notified value", idx);
+  }
+  for (int h = 0; h < amo->holes; h++) {
+    const int p = true_pigeon (amo, h, -1);
+    if (p >= 0 && true_pigeon (amo, h, p) >= 0) {
+      amo->rejected = true;
+      amo->rejections++;
+      return 0;
+    }
+  }
+  return 1;
+}
+
+static void check_pigeon_hole (int holes, int pigeons, bool eager) {
+  amo amo;
+  memset (&amo, 0, sizeof amo);
+  amo.holes = holes;
+  amo.pigeons = pigeons;
+  amo.eager = eager;
+  const int vars = holes * pigeons;
+  amo.values = calloc (vars + 1, sizeof *amo.values);
+  amo.levels = calloc (vars + 1, sizeof *amo.levels);
+  kissat *solver = kissat_init ();
+  tissat_init_solver (solver);
+#if !defined(NOPTIONS) && !defined(NDEBUG)
+  kissat_set_option (solver, "check", 2);
+#endif
+  for (int p = 0; p < pigeons; p++) {
+    for (int h = 0; h < holes; h++)
+      kissat_add (solver, pigeon_hole (&amo, p, h));
+    kissat_add (solver, 0);
+  }
+  for (int idx = 1; idx <= vars; idx++)
+    kissat_observe (solver, idx);
+  const kissat_propagator propagator = {
+      &amo,        notify_assignment, notify_backtrack, add_clause,
+      propagate,   explain,           check_model};
+  kissat_connect_propagator (solver, &propagator);
+  const int res = kissat_solve (solver);
+  const int expected = pigeons > holes ? 20 : 10;
+  if (res != expected)
+    FATAL ("expected '%d' but got '%d'", expected, res);
+  if (res == 10) {
+    for (int h = 0; h < holes; h++) {
+      int count = 0;
+      for (int p = 0; p < pigeons; p++)
+        if (kissat_value (solver, pigeon_hole (&amo, p, h)) > 0)
+          count++;
+      if (count > 1)
+        FATAL ("%d pigeons in hole %d", count, h);
+    }
+  }
+  if (eager && !amo.propagated)
+    FATAL ("nothing propagated");
+  if (!eager && !amo.rejections)
+    FATAL ("no model rejected");
+  printf ("propagated %zu, added %zu clauses, rejected %zu models\n",
+          amo.propagated, amo.clauses, amo.rejections);
+  kissat_release (solver);
+  free (amo.levels);
+  free (amo.values);
+}
+
+static void test_propagator_eager_unsat (void) {
+  check_pigeon_hole (5, 6, true);
+}
+
+static void test_propagator_lazy_unsat (void) {
+  check_pigeon_hole (5, 6, false);
+}
+
+static void test_propagator_eager_sat (void) {
+  check_pigeon_hole (6, 6, true);
+}
+
+static void test_propagator_lazy_sat (void) {
+  check_pigeon_hole (6, 6, false);
+}
+
+void tissat_schedule_propagator (void) {
+  SCHEDULE_FUNCTION (test_propagator_eager_unsat);
+  SCHEDULE_FUNCTION (test_propagator_lazy_unsat);
+  SCHEDULE_FUNCTION (test_propagator_eager_sat);
+  SCHEDULE_FUNCTION (test_propagator_lazy_sat);
+}
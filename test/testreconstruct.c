@@ -0,0 +1,106 @@
+#include "../src/random.h"
+#include "../src/reconstruct.h"
+
+#include "test.h"
+
+// Preprocess a random formula with planted solution, write the simplified
+// formula and reconstruction stack, solve the simplified formula with
+// another solver and check the reconstructed model on the original one.
+
+static void check_reconstruct (generator *random, bool fastel) {
+  const int max_var = 100, clauses = 300;
+  int lits[4 * clauses];
+  bool planted[max_var + 1];
+  const size_t size = tissat_random_clauses (random, max_var, clauses, 2,
+                                             3, planted, lits);
+  const int *const end = lits + size;
+  kissat *solver = kissat_init ();
+  tissat_init_solver (solver);
+#ifndef NOPTIONS
+  kissat_set_option (solver, "fastel", fastel);
+  kissat_set_option (solver, "lucky", 0);
+#else
+  (void) fastel;
+#endif
+  kissat_add_clauses (solver, end - lits, lits);
+  kissat_set_conflict_limit (solver, 0);
+  int res = kissat_solve (solver);
+  if (res && res != 10)
+    FATAL ("unexpected result '%d' of preprocessing", res);
+  FILE *simplified = tmpfile ();
+  FILE *reconstruction = tmpfile ();
+  if (!simplified || !reconstruction)
+    FATAL ("could not open temporary files");
+  if (!kissat_write_simplified (solver, simplified))
+    FATAL ("failed to write simplified formula");
+  if (!kissat_write_reconstruction (solver, max_var, reconstruction))
+    FATAL ("failed to write reconstruction");
+  kissat_release (solver);
+  rewind (simplified);
+  solver = kissat_init ();
+  tissat_init_solver (solver);
+  int vars, lit;
+  size_t header_clauses;
+  if (fscanf (simplified, "p cnf %d %zu", &vars, &header_clauses) != 2)
+    FATAL ("invalid simplified header");
+  while (fscanf (simplified, "%d", &lit) == 1)
+    kissat_add (solver, lit);
+  fclose (simplified);
+  res = kissat_solve (solver);
+  if (res != 10)
+    FATAL ("expected '10' but got '%d'", res);
+  rewind (reconstruction);
+  ints values;
+  INIT_STACK (values);
+  int reconstructed;
+  const char *error =
+      kissat_reconstruct (solver, reconstruction, &reconstructed, &values);
+  fclose (reconstruction);
+  if (error)
+    FATAL ("reconstruction failed: %s", error);
+  if (reconstructed != max_var)
+    FATAL ("expected '%d' variables but got '%d'", max_var, reconstructed);
+  const int *const model = BEGIN_STACK (values);
+  for (const int *c = lits; c != end; c++) {
+    bool satisfied = false;
+    for (; *c; c++) {
+      const int idx = ABS (*c);
+      const int value = model[idx] ? model[idx] : idx;
+      if (value == *c)
+        satisfied = true;
+    }
+    if (!satisfied)
+      FATAL ("reconstructed model falsifies original clause");
+  }
+  RELEASE_STACK (values);
+  kissat_release (solver);
+}
+
+static void test_reconstruct_model (void) {
+  generator random = 42;
+  for (int round = 0; round < (tissat_big ? 100 : 10); round++) {
+    check_reconstruct (&random, false);
+    check_reconstruct (&random, true);
+  }
+}
+
+static void test_reconstruct_application (void) {
+  if (!tissat_found_test_directory)
+    return;
+  tissat_call_application (1, "../test/cnf/ite10.cnf "
+                              "--simplified=ite10.simplified");
+  tissat_call_application (0, "../test/cnf/prime169.cnf "
+                              "--simplified=prime169.simplified "
+                              "--reconstruction=prime169.reconstruction");
+  tissat_call_application (10, "prime169.simplified "
+                               "--reconstruction=prime169.reconstruction");
+  remove ("prime169.simplified");
+  remove ("prime169.reconstruction");
+  tissat_call_application (1, "../test/cnf/ite10.cnf "
+                              "--reconstruction=/non/existing/file");
+}
+
+void tissat_schedule_reconstruct (void) {
+  SCHEDULE_FUNCTION (test_reconstruct_model);
+  SCHEDULE_FUNCTION (test_reconstruct_application);
+}
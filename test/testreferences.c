@@ -215,7 +215,7 @@ static void test_references_enlarge (void) {
   assert (refs[1]);
 
   RELEASE_WATCHES (*watches);
-  RELEASE_STACK (solver->vectors.stack);
+  kissat_release_vectors (solver);
 
   solver->watches = 0;
   solver->size = 0;
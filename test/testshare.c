@@ -0,0 +1,158 @@
+#include "../src/random.h"
+
+#include "test.h"
+
+typedef struct shared shared;
+
+struct shared {
+  int *clauses;
+  size_t size, capacity;
+  size_t exported, polled;
+  int max_var, max_size;
+  size_t next;
+};
+
+static void push_shared (shared *shared, int lit) {
+  if (shared->size == shared->capacity) {
+    shared->capacity = shared->capacity ? 2 * shared->capacity : 64;
+    shared->clauses = realloc (shared->clauses,
+                               shared->capacity * sizeof *shared->clauses);
+    assert (shared->clauses);
+  }
+  shared->clauses[shared->size++] = lit;
+}
+
+static void export_clause (void *state, const int *clause) {
+  shared *shared = state;
+  shared->exported++;
+  int size = 0;
+  for (const int *p = clause; *p; p++) {
+    const int lit = *p;
+    const int idx = abs (lit);
+    if (!idx || idx > shared->max_var)
+      FATAL ("exported invalid literal %d", lit);
+    size++;
+  }
+  if (size > 1 && size > shared->max_size)
+    FATAL ("exported clause of size %d exceeds maximum %d", size,
+           shared->max_size);
+  for (const int *p = clause; *p; p++)
+    push_shared (shared, *p);
+  push_shared (shared, 0);
+}
+
+static const int *import_clause (void *state) {
+  shared *shared = state;
+  if (shared->next == shared->size)
+    return 0;
+  const int *res = shared->clauses + shared->next;
+  while (shared->clauses[shared->next])
+    shared->next++;
+  shared->next++;
+  shared->polled++;
+  return res;
+}
+
+static kissat *new_solver (size_t size, const int *lits) {
+  kissat *solver = kissat_init ();
+  tissat_init_solver (solver);
+#ifndef NOPTIONS
+  kissat_set_option (solver, "restartint", 1);
+#ifndef NDEBUG
+  kissat_set_option (solver, "check", 2);
+#endif
+#endif
+  kissat_add_clauses (solver, size, lits);
+  return solver;
+}
+
+static void check_model (kissat *solver, size_t size, const int *lits) {
+  bool satisfied = false;
+  for (size_t i = 0; i < size; i++) {
+    const int lit = lits[i];
+    if (!lit) {
+      if (!satisfied)
+        FATAL ("model does not satisfy clause");
+      satisfied = false;
+    } else if (kissat_value (solver, lit) == lit)
+      satisfied = true;
+  }
+}
+
+// First solve the formula while exporting learned clauses and then solve
+// it again while importing the exported clauses (preceded by some clauses
+// which have to be skipped, i.e., a tautological clause and a clause with
+// a variable not occurring in the formula).
+
+static void share_clauses (int max_var, size_t size, const int *lits,
+                           int expected, int max_size, int max_glue) {
+  shared shared;
+  memset (&shared, 0, sizeof shared);
+  shared.max_var = max_var;
+  shared.max_size = max_size;
+  push_shared (&shared, 1), push_shared (&shared, -1);
+  push_shared (&shared, 0);
+  push_shared (&shared, max_var + 1), push_shared (&shared, 0);
+  {
+    kissat *solver = new_solver (size, lits);
+    kissat_set_export (solver, &shared, max_size, max_glue, export_clause);
+    const int res = kissat_solve (solver);
+    if (res != expected)
+      FATAL ("expected '%d' but got '%d' while exporting", expected, res);
+    if (res == 10)
+      check_model (solver, size, lits);
+    kissat_release (solver);
+  }
+  {
+    kissat *solver = new_solver (size, lits);
+    kissat_set_import (solver, &shared, import_clause);
+    const int res = kissat_solve (solver);
+    if (res != expected)
+      FATAL ("expected '%d' but got '%d' while importing", expected, res);
+    if (res == 10)
+      check_model (solver, size, lits);
+    printf ("exported %zu and imported %zu clauses\n", shared.exported,
+            shared.polled);
+    kissat_release (solver);
+  }
+  free (shared.clauses);
+}
+
+static void test_share_pigeon_hole (void) {
+  const int holes = 5, pigeons = holes + 1;
+  const int max_var = pigeons * holes;
+  int lits[pigeons * (holes + 1) + holes * pigeons * pigeons * 3 / 2];
+  int *p = lits;
+#define PH(P, H) ((P) * holes + (H) + 1)
+  for (int i = 0; i < pigeons; i++) {
+    for (int h = 0; h < holes; h++)
+      *p++ = PH (i, h);
+    *p++ = 0;
+  }
+  for (int h = 0; h < holes; h++)
+    for (int i = 0; i < pigeons; i++)
+      for (int j = i + 1; j < pigeons; j++)
+        *p++ = -PH (i, h), *p++ = -PH (j, h), *p++ = 0;
+#undef PH
+  assert ((size_t) (p - lits) <= sizeof lits / sizeof *lits);
+  share_clauses (max_var, p - lits, lits, 20, 0, 0);
+  share_clauses (max_var, p - lits, lits, 20, 8, 4);
+  share_clauses (max_var, p - lits, lits, 20, INT_MAX, INT_MAX);
+}
+
+static void test_share_random (void) {
+  const int max_var = 150, clauses = 600;
+  int lits[4 * clauses];
+  generator random = 13;
+  for (int round = 0; round < (tissat_big ? 10 : 3); round++) {
+    bool planted[max_var + 1];
+    const size_t size = tissat_random_clauses (&random, max_var, clauses,
+                                               3, 3, planted, lits);
+    share_clauses (max_var, size, lits, 10, 10, 6);
+  }
+}
+
+void tissat_schedule_share (void) {
+  SCHEDULE_FUNCTION (test_share_pigeon_hole);
+  SCHEDULE_FUNCTION (test_share_random);
+}
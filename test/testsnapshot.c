@@ -0,0 +1,177 @@
+#include "../src/internal.h"
+
+#include "test.h"
+
+#include <inttypes.h>
+
+typedef struct snapshots snapshots;
+
+struct snapshots {
+  kissat *solver;
+  FILE *file;
+  uint64_t conflicts;
+  unsigned written;
+};
+
+static void write_snapshot (void *state) {
+  snapshots *snapshots = state;
+  if (snapshots->file)
+    fclose (snapshots->file);
+  snapshots->file = tmpfile ();
+  if (!snapshots->file)
+    FATAL ("could not open temporary file");
+  kissat *solver = snapshots->solver;
+  if (!kissat_write_snapshot (solver, snapshots->file))
+    FATAL ("failed to write snapshot");
+  snapshots->conflicts = solver->statistics.conflicts;
+  snapshots->written++;
+}
+
+static kissat *new_solver (size_t size, const int *lits) {
+  kissat *solver = kissat_init ();
+  tissat_init_solver (solver);
+  kissat_add_clauses (solver, size, lits);
+  return solver;
+}
+
+static int solve_from_scratch (size_t size, const int *lits,
+                               uint64_t *conflicts) {
+  kissat *solver = new_solver (size, lits);
+  const int res = kissat_solve (solver);
+  *conflicts = solver->statistics.conflicts;
+  kissat_release (solver);
+  return res;
+}
+
+// Interrupts search by a conflict limit after requesting a checkpoint and
+// returns the file of the last snapshot written (at the interrupt).
+
+static FILE *interrupt (size_t size, const int *lits, int limit,
+                        uint64_t *conflicts) {
+  kissat *solver = new_solver (size, lits);
+  snapshots snapshots;
+  memset (&snapshots, 0, sizeof snapshots);
+  snapshots.solver = solver;
+  kissat_set_checkpoint (solver, &snapshots, write_snapshot);
+  kissat_request_checkpoint (solver);
+  kissat_set_conflict_limit (solver, limit);
+  const int res = kissat_solve (solver);
+  if (res)
+    FATAL ("expected '0' but got '%d'", res);
+  if (snapshots.written < 2)
+    FATAL ("expected at least 2 snapshots but got %u", snapshots.written);
+  if (solver->statistics.checkpoints != snapshots.written)
+    FATAL ("checkpoints statistics do not match");
+  if (snapshots.conflicts != solver->statistics.conflicts)
+    FATAL ("last snapshot not written at interrupt");
+  kissat_release (solver);
+  *conflicts = snapshots.conflicts;
+  rewind (snapshots.file);
+  return snapshots.file;
+}
+
+// The resumed solver starts with the conflicts of the interrupted one and
+// yields the same result as solving the formula from scratch.
+
+static void test_snapshot_resume (void) {
+  const int max_var = 150, clauses = 750;
+  int lits[4 * clauses];
+  generator random = 42;
+  for (int round = 0; round < (tissat_big ? 10 : 3); round++) {
+    const size_t size = tissat_random_clauses (&random, max_var, clauses,
+                                               3, 3, 0, lits);
+    uint64_t scratch;
+    const int expected = solve_from_scratch (size, lits, &scratch);
+    if (scratch < 200)
+      continue;
+    uint64_t interrupted;
+    FILE *file = interrupt (size, lits, 100, &interrupted);
+    kissat *solver = new_solver (size, lits);
+    const char *error = kissat_read_snapshot (solver, file);
+    fclose (file);
+    if (error)
+      FATAL ("reading snapshot failed: %s", error);
+    if (solver->statistics.conflicts != interrupted)
+      FATAL ("resumed with %" PRIu64 " instead of %" PRIu64
+             " conflicts",
+             solver->statistics.conflicts, interrupted);
+    const int res = kissat_solve (solver);
+    if (res != expected)
+      FATAL ("expected '%d' but got '%d' after resuming", expected, res);
+    printf ("%" PRIu64 " conflicts from scratch and %" PRIu64
+            " resumed after %" PRIu64 "\n",
+            scratch, solver->statistics.conflicts, interrupted);
+    kissat_release (solver);
+  }
+}
+
+static void expect_snapshot_error (const int *lits, size_t size,
+                                   FILE *file, const char *expected) {
+  kissat *solver = new_solver (size, lits);
+  rewind (file);
+  const char *error = kissat_read_snapshot (solver, file);
+  kissat_release (solver);
+  if (!error)
+    FATAL ("expected error '%s'", expected);
+  if (strcmp (error, expected))
+    FATAL ("expected error '%s' but got '%s'", expected, error);
+  printf ("rejected snapshot: %s\n", error);
+}
+
+static void test_snapshot_invalid (void) {
+  const int max_var = 150, clauses = 750;
+  int lits[4 * clauses], other[4 * clauses];
+  generator random = 4242;
+  size_t size;
+  uint64_t conflicts;
+  do
+    size = tissat_random_clauses (&random, max_var, clauses, 3, 3, 0,
+                                  lits);
+  while (solve_from_scratch (size, lits, &conflicts), conflicts < 200);
+  const size_t other_size =
+      tissat_random_clauses (&random, max_var, clauses, 3, 3, 0, other);
+  FILE *file = interrupt (size, lits, 100, &conflicts);
+  expect_snapshot_error (other, other_size, file,
+                         "snapshot of different formula");
+  fseek (file, 0, SEEK_END);
+  const long bytes = ftell (file);
+  rewind (file);
+  FILE *truncated = tmpfile ();
+  if (!truncated)
+    FATAL ("could not open temporary file");
+  for (long i = 0; i < bytes / 2; i++)
+    fputc (getc (file), truncated);
+  fclose (file);
+  expect_snapshot_error (lits, size, truncated, "truncated snapshot");
+  fclose (truncated);
+  FILE *garbage = tmpfile ();
+  if (!garbage)
+    FATAL ("could not open temporary file");
+  fputs ("kissat-cache 1 0123456789abcdef\n", garbage);
+  expect_snapshot_error (lits, size, garbage, "invalid snapshot header");
+  fclose (garbage);
+}
+
+// The application writes a snapshot when interrupted and resumes from it.
+
+static void test_snapshot_application (void) {
+  if (!tissat_found_test_directory)
+    return;
+  const char *path = "ph6.snapshot";
+  remove (path);
+  tissat_call_application (0, "../test/cnf/ph6.cnf --conflicts=100 "
+                              "--checkpoint=ph6.snapshot");
+  tissat_call_application (20, "../test/cnf/ph6.cnf "
+                               "--resume=ph6.snapshot");
+  tissat_call_application (1, "../test/cnf/add8.cnf "
+                              "--resume=ph6.snapshot");
+  remove (path);
+  tissat_call_application (1, "../test/cnf/ph6.cnf "
+                              "--resume=/non/existing/snapshot");
+}
+
+void tissat_schedule_snapshot (void) {
+  SCHEDULE_FUNCTION (test_snapshot_resume);
+  SCHEDULE_FUNCTION (test_snapshot_invalid);
+  SCHEDULE_FUNCTION (test_snapshot_application);
+}
@@ -55,4 +55,9 @@ void tissat_schedule_solve (void) {
     schedule_solve_job (EXPECTED, "../test/cnf/" #NAME ".cnf");
   CNFS
 #undef CNF
+  schedule_solve_job (10, "../test/cnf/sat.aag");
+  schedule_solve_job (10, "../test/cnf/sat.aig");
+  schedule_solve_job (20, "../test/cnf/miter.aag");
+  schedule_solve_job (20, "../test/cnf/unsat.aig");
+  schedule_solve_job (20, "../test/cnf/bad.aag");
 }
@@ -64,6 +64,8 @@ void tissat_schedule_usage (void) {
             "--reluctantint=200 --reluctantlim=100 --stable=2");
     APP (0, "--decisions=1000 ../test/cnf/hard.cnf "
             "--no-reluctant --stable=2");
+    APP (0, "--conflicts=1e4 ../test/cnf/hard.cnf "
+            "--bandit --modeinit=100 --modeint=100");
   }
 
 #else
@@ -92,8 +94,17 @@ void tissat_schedule_usage (void) {
     APP (0, "--decisions=8e3 ../test/cnf/hard.cnf" LIMITED_OPTIONS);
     APP (0, "--conflicts=7e3 --decisions=7e3 "
             "../test/cnf/hard.cnf" LIMITED_OPTIONS);
+    APP (10, "../test/cnf/ite10.cnf --model=/dev/null");
+    APP (10, "../test/cnf/ite10.cnf -n --model=/dev/null");
+    APP (1, "../test/cnf/ite10.cnf --model=/non/existing/model");
+    APP (0, "../test/cnf/ite10.cnf --convert=/dev/null");
+    APP (1, "../test/cnf/ite10.cnf --convert=/non/existing/file");
+    APP (1, "../test/cnf/bad.aag --convert=/dev/null");
   }
 
+  APP (1, "--model=");
+  APP (1, "--convert=");
+
   APP (1, "--help -n");
   APP (1, "--version -n");
   APP (1, "-n --version");
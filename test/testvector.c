@@ -84,12 +84,154 @@ static void test_vector_basics (void) {
 #ifndef QUIET
   RELEASE_STACK (solver->profiles.stack);
 #endif
-  RELEASE_STACK (*stack);
+  kissat_release_vectors (solver);
 #ifdef METRICS
   assert (!solver->statistics.allocated_current);
 #endif
 }
 
+static void test_vector_slabs (void) {
+  DECLARE_AND_INIT_SOLVER (solver);
+#ifndef NOPTIONS
+  solver->options.slabs = 1;
+#endif
+  vector watches[3];
+  solver->size = solver->vars = 1;
+  solver->watches = watches;
+  memset (watches, 0, sizeof watches);
+  vector *a = watches, *b = watches + 1, *c = watches + 2;
+  kissat_push_vectors (solver, a, 0);
+  kissat_push_vectors (solver, a, 0);
+  kissat_push_vectors (solver, b, 1);
+  const size_t old_offset_a = kissat_offset_vector (solver, a);
+  printf ("vector a at %zu\n", old_offset_a);
+  kissat_push_vectors (solver, a, 0);
+  assert (kissat_offset_vector (solver, a) != old_offset_a);
+  kissat_push_vectors (solver, c, 2);
+  kissat_push_vectors (solver, b, 1);
+  const size_t new_offset_b = kissat_offset_vector (solver, b);
+  printf ("vector b at %zu\n", new_offset_b);
+  assert (new_offset_b == old_offset_a);
+  assert (kissat_size_vector (a) == 3);
+  assert (kissat_size_vector (b) == 2);
+  assert (kissat_size_vector (c) == 1);
+  for (unsigned i = 0; i < 3; i++)
+    for (all_vector (e, watches[i]))
+      assert (e == i);
+  kissat_defrag_vectors (solver, 3, watches);
+  for (unsigned i = 0; i < SIZE_SLABS; i++)
+    assert (EMPTY_STACK (solver->vectors.slabs[i]));
+#ifndef QUIET
+  RELEASE_STACK (solver->profiles.stack);
+#endif
+  kissat_release_vectors (solver);
+#ifdef METRICS
+  assert (!solver->statistics.allocated_current);
+#endif
+}
+
+// After shrinking a vector and rebuilding the free lists its tail beyond
+// the size class of the new size is reused by the next enlarged vector of
+// that size class, while free space at the end of the stack is trimmed.
+
+static void test_vector_shrink (void) {
+  DECLARE_AND_INIT_SOLVER (solver);
+#ifndef NOPTIONS
+  solver->options.slabs = 1;
+#endif
+  vector watches[4];
+  solver->size = solver->vars = 2;
+  solver->watches = watches;
+  memset (watches, 0, sizeof watches);
+  vector *a = watches, *b = watches + 1, *c = watches + 2, *d = watches + 3;
+  for (unsigned i = 0; i < 8; i++)
+    kissat_push_vectors (solver, a, 0);
+  kissat_push_vectors (solver, d, 3);
+  const size_t offset_a = kissat_offset_vector (solver, a);
+  printf ("vector a at %zu\n", offset_a);
+  kissat_resize_vector (solver, a, 3);
+  kissat_rebuild_slabs (solver, 4, watches);
+  kissat_push_vectors (solver, b, 1);
+  kissat_push_vectors (solver, b, 1);
+  kissat_push_vectors (solver, c, 2);
+  kissat_push_vectors (solver, b, 1);
+  const size_t offset_b = kissat_offset_vector (solver, b);
+  printf ("vector b at %zu\n", offset_b);
+  assert (offset_b == offset_a + 4);
+  kissat_push_vectors (solver, a, 0);
+  assert (kissat_offset_vector (solver, a) == offset_a);
+  assert (kissat_size_vector (a) == 4);
+  assert (kissat_size_vector (b) == 3);
+  assert (kissat_size_vector (c) == 1);
+  for (unsigned i = 0; i < 4; i++)
+    for (all_vector (e, watches[i]))
+      assert (e == i);
+  kissat_release_vector (solver, c);
+  kissat_release_vector (solver, d);
+  kissat_rebuild_slabs (solver, 4, watches);
+  printf ("trimmed stack to %zu\n", SIZE_STACK (solver->vectors.stack));
+  assert (SIZE_STACK (solver->vectors.stack) == offset_b + 4);
+#ifndef QUIET
+  RELEASE_STACK (solver->profiles.stack);
+#endif
+  kissat_release_vectors (solver);
+#ifdef METRICS
+  assert (!solver->statistics.allocated_current);
+#endif
+  (void) offset_b;
+}
+
+// If there is no free block of the requested size class a larger free
+// block is split and its remainder is put back into the smaller classes.
+
+static void test_vector_split (void) {
+  DECLARE_AND_INIT_SOLVER (solver);
+#ifndef NOPTIONS
+  solver->options.slabs = 1;
+#endif
+  vector watches[3];
+  solver->size = solver->vars = 1;
+  solver->watches = watches;
+  memset (watches, 0, sizeof watches);
+  vector *a = watches, *b = watches + 1, *c = watches + 2;
+  for (unsigned i = 0; i < 8; i++)
+    kissat_push_vectors (solver, a, 0);
+  kissat_push_vectors (solver, b, 1);
+  kissat_push_vectors (solver, c, 2);
+  sizes *slabs = solver->vectors.slabs;
+  for (unsigned i = 0; i < SIZE_SLABS; i++)
+    CLEAR_STACK (slabs[i]);
+  const size_t offset_a = kissat_offset_vector (solver, a);
+  printf ("vector a at %zu\n", offset_a);
+  kissat_push_vectors (solver, a, 0);
+  printf ("vector a moved to %zu\n", kissat_offset_vector (solver, a));
+  assert (kissat_offset_vector (solver, a) != offset_a);
+  kissat_push_vectors (solver, b, 1);
+  const size_t offset_b = kissat_offset_vector (solver, b);
+  printf ("vector b at %zu\n", offset_b);
+  assert (offset_b == offset_a);
+  assert (SIZE_STACK (slabs[1]) == 1);
+  assert (TOP_STACK (slabs[1]) == offset_a + 6);
+  assert (SIZE_STACK (slabs[2]) == 1);
+  assert (TOP_STACK (slabs[2]) == offset_a + 2);
+  assert (EMPTY_STACK (slabs[3]));
+#ifdef METRICS
+  assert (solver->statistics.vectors_split == 1);
+#endif
+  assert (kissat_size_vector (b) == 2);
+  for (all_vector (e, watches[1]))
+    assert (e == 1);
+#ifndef QUIET
+  RELEASE_STACK (solver->profiles.stack);
+#endif
+  kissat_release_vectors (solver);
+#ifdef METRICS
+  assert (!solver->statistics.allocated_current);
+#endif
+  (void) offset_a;
+  (void) offset_b;
+}
+
 #include <setjmp.h>
 
 static jmp_buf jump_buffer;
@@ -123,5 +265,8 @@ static void test_vector_fatal (void) {
 
 void tissat_schedule_vector (void) {
   SCHEDULE_FUNCTION (test_vector_basics);
+  SCHEDULE_FUNCTION (test_vector_slabs);
+  SCHEDULE_FUNCTION (test_vector_shrink);
+  SCHEDULE_FUNCTION (test_vector_split);
   SCHEDULE_FUNCTION (test_vector_fatal);
 }